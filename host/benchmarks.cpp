@@ -0,0 +1,809 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       benchmarks.cpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Host Benchmarks of the Path Planning and Pursuit Code     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Times the hot paths of path planning and pursuit, and writes the results as
+ * JSON so that they can be compared between versions:
+ *
+ *   {
+ *     "schema": 1,
+ *     "compiler": "...",
+ *     "benchmarks": [
+ *       {"name": "dubins_shortest_path", "iterations": 1048576,
+ *        "ns_per_op": 61.2, "min_ns_per_op": 60.8, "counters": {}},
+ *       ...
+ *     ]
+ *   }
+ *
+ * Each benchmark is run in batches of at least BATCH_TIME seconds. ns_per_op
+ * is the median over the batches and min_ns_per_op the fastest batch.
+ *
+ * Usage: benchmarks [output.json] [name filter]
+ * Without an output file, the JSON is printed.
+ */
+
+#include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include "whooplib/include/calculators/HeadingOptimizer.hpp"
+#include "whooplib/include/calculators/HybridAStar.hpp"
+#include "whooplib/include/calculators/ModelPredictive.hpp"
+#include "whooplib/include/calculators/OccupancyGrid.hpp"
+#include "whooplib/include/calculators/PID.hpp"
+#include "whooplib/include/calculators/PathFile.hpp"
+#include "whooplib/include/calculators/PoseEKF.hpp"
+#include "whooplib/include/calculators/PurePursuit.hpp"
+#include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/calculators/ReedsShepp.hpp"
+#include "whooplib/include/calculators/Transform2D.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include "whooplib/include/calculators/VoltageTable.hpp"
+#include "whooplib/include/calculators/WheelOdom.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+static const double BATCH_TIME = 0.02; // Seconds per batch
+static const int NUM_BATCHES = 7;
+
+// Results are written here so the compiler cannot skip the work
+static volatile double sink = 0;
+
+struct BenchmarkResult {
+  std::string name;
+  long iterations = 0;
+  double ns_per_op = 0;
+  double min_ns_per_op = 0;
+  std::map<std::string, double> counters;
+};
+
+static std::vector<BenchmarkResult> results;
+static std::string name_filter;
+
+static double wall_seconds() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Times a benchmark
+ * @param name The name of the benchmark, with its parameters after slashes
+ * @param body Runs the benchmark once, returning the number of operations
+ * it did
+ * @returns The result, to add counters to, or nullptr if it was filtered out
+ */
+static BenchmarkResult *run_benchmark(const std::string &name,
+                                      const std::function<long()> &body) {
+  if (!name_filter.empty() && name.find(name_filter) == std::string::npos) {
+    return nullptr;
+  }
+
+  // Find how many calls fill a batch
+  long calls = 1;
+  while (true) {
+    double start = wall_seconds();
+    for (long i = 0; i < calls; i++) {
+      body();
+    }
+    if (wall_seconds() - start >= BATCH_TIME || calls >= (1L << 30)) {
+      break;
+    }
+    calls *= 2;
+  }
+
+  std::vector<double> batch_ns;
+  long total_ops = 0;
+  for (int b = 0; b < NUM_BATCHES; b++) {
+    long ops = 0;
+    double start = wall_seconds();
+    for (long i = 0; i < calls; i++) {
+      ops += body();
+    }
+    double elapsed = wall_seconds() - start;
+    batch_ns.push_back(elapsed * 1e9 / std::max(1L, ops));
+    total_ops += ops;
+  }
+  std::sort(batch_ns.begin(), batch_ns.end());
+
+  BenchmarkResult result;
+  result.name = name;
+  result.iterations = total_ops;
+  result.ns_per_op = batch_ns[batch_ns.size() / 2];
+  result.min_ns_per_op = batch_ns[0];
+  results.push_back(result);
+  fprintf(stderr, "%-64s %12.1f ns/op\n", name.c_str(), result.ns_per_op);
+  return &results.back();
+}
+
+static std::vector<TwoDPose> random_poses(size_t count, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> position(-1.5, 1.5);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::vector<TwoDPose> poses;
+  for (size_t i = 0; i < count; i++) {
+    poses.push_back(TwoDPose(position(generator), position(generator),
+                             angle(generator)));
+  }
+  return poses;
+}
+
+static std::vector<TwoDPose> route(int num_waypoints) {
+  std::vector<TwoDPose> waypoints = {
+      TwoDPose(-1.2, -1.2, 0), TwoDPose(0, -0.6, M_PI_4),
+      TwoDPose(0.6, 0.6, M_PI_2), TwoDPose(-0.3, 1.2, M_PI),
+      TwoDPose(-1.2, 0.3, -M_PI_2)};
+  waypoints.resize(num_waypoints);
+  return waypoints;
+}
+
+static const char *representation_name(pathrepresentation representation) {
+  return representation == pathrepresentation::path_analytic ? "analytic"
+                                                             : "sampled";
+}
+
+static const double TURNING_RADIUS = 0.127;
+static const double LOOKAHEAD = 0.127;
+
+static void benchmark_curves() {
+  std::vector<TwoDPose> poses = random_poses(256, 1);
+
+  size_t index = 0;
+  run_benchmark("dubins_shortest_path", [&]() {
+    TwoDPose &a = poses[index % poses.size()];
+    TwoDPose &b = poses[(index + 1) % poses.size()];
+    index++;
+    double q0[3] = {a.x, a.y, a.yaw};
+    double q1[3] = {b.x, b.y, b.yaw};
+    DubinsPath path;
+    dubins_shortest_path(&path, q0, q1, TURNING_RADIUS);
+    sink = dubins_path_length(&path);
+    return 1L;
+  });
+
+  index = 0;
+  BenchmarkResult *result = run_benchmark("reeds_shepp_shortest_path", [&]() {
+    TwoDPose &a = poses[index % poses.size()];
+    TwoDPose &b = poses[(index + 1) % poses.size()];
+    index++;
+    double q0[3] = {a.x, a.y, a.yaw};
+    double q1[3] = {b.x, b.y, b.yaw};
+    ReedsSheppPath path;
+    reeds_shepp_shortest_path(&path, q0, q1, TURNING_RADIUS);
+    sink = reeds_shepp_path_length(&path);
+    return 1L;
+  });
+  if (result == nullptr) {
+    return;
+  }
+
+  // How much shorter Reeds-Shepp is than Dubins over the same pairs
+  double dubins_total = 0, reeds_shepp_total = 0;
+  for (size_t i = 0; i < poses.size(); i++) {
+    TwoDPose &a = poses[i];
+    TwoDPose &b = poses[(i + 1) % poses.size()];
+    double q0[3] = {a.x, a.y, a.yaw};
+    double q1[3] = {b.x, b.y, b.yaw};
+    DubinsPath dubins;
+    ReedsSheppPath reeds_shepp;
+    dubins_shortest_path(&dubins, q0, q1, TURNING_RADIUS);
+    reeds_shepp_shortest_path(&reeds_shepp, q0, q1, TURNING_RADIUS);
+    dubins_total += dubins_path_length(&dubins);
+    reeds_shepp_total += reeds_shepp_path_length(&reeds_shepp);
+  }
+  result->counters["length_vs_dubins"] = reeds_shepp_total / dubins_total;
+}
+
+static void benchmark_path_generation() {
+  for (pathrepresentation representation :
+       {pathrepresentation::path_sampled, pathrepresentation::path_analytic}) {
+    for (int num_waypoints : {2, 3, 5}) {
+      for (int num_segments : {50, 100, 200, 400}) {
+        std::vector<TwoDPose> waypoints = route(num_waypoints);
+        std::string name = std::string("PurePursuitPath/") +
+                           representation_name(representation) +
+                           "/waypoints=" + std::to_string(num_waypoints) +
+                           "/segments=" + std::to_string(num_segments);
+        run_benchmark(name, [&]() {
+          PurePursuitPath path(waypoints, TURNING_RADIUS, LOOKAHEAD,
+                               num_segments, -1, representation);
+          sink = path.pursuit_checkpoints.size();
+          return 1L;
+        });
+      }
+    }
+  }
+
+  std::vector<TwoDPose> waypoints = route(3);
+  run_benchmark("PurePursuitPath/reeds_shepp/waypoints=3/segments=100", [&]() {
+    PurePursuitPath path(waypoints, TURNING_RADIUS, LOOKAHEAD, 100, -1,
+                         pathrepresentation::path_sampled,
+                         pathplanner::planner_reeds_shepp);
+    sink = path.pursuit_checkpoints.size();
+    return 1L;
+  });
+  run_benchmark("PurePursuitPath/smoothed/waypoints=3/segments=100", [&]() {
+    PurePursuitPath path(waypoints, TURNING_RADIUS, LOOKAHEAD, 100, -1,
+                         pathrepresentation::path_sampled,
+                         pathplanner::planner_dubins, 0.05);
+    sink = path.pursuit_checkpoints.size();
+    return 1L;
+  });
+}
+
+static void benchmark_pursuit_estimate() {
+  std::vector<TwoDPose> waypoints = route(3);
+
+  // Poses along the path, in the order the robot passes them
+  PurePursuitPath sampled(waypoints, TURNING_RADIUS, LOOKAHEAD, 200);
+  std::vector<TwoDPose> on_course, off_course;
+  for (const barebonesPose &point : sampled.pursuit_points) {
+    on_course.push_back(TwoDPose(point.x, point.y, point.yaw));
+    off_course.push_back(TwoDPose(point.x - 0.3 * sin(point.yaw),
+                                  point.y + 0.3 * cos(point.yaw),
+                                  point.yaw));
+  }
+
+  for (pathrepresentation representation :
+       {pathrepresentation::path_sampled, pathrepresentation::path_analytic}) {
+    PurePursuitPath original(waypoints, TURNING_RADIUS, LOOKAHEAD, 100, -1,
+                             representation);
+    for (int course = 0; course < 2; course++) {
+      std::vector<TwoDPose> &poses = course == 0 ? on_course : off_course;
+      std::string name = std::string("calculate_pursuit_estimate/") +
+                         representation_name(representation) +
+                         (course == 0 ? "/on_course" : "/off_course");
+
+      // Each call drives the whole path, since the estimate remembers the
+      // checkpoints it has passed
+      run_benchmark(name, [&]() {
+        PurePursuitPath path = original;
+        for (const TwoDPose &pose : poses) {
+          sink = path.calculate_pursuit_estimate(pose).steering_angle;
+        }
+        return static_cast<long>(poses.size());
+      });
+    }
+  }
+
+  // A long route has many checkpoints, which should not slow each estimate
+  std::vector<TwoDPose> long_route = route(20);
+  PurePursuitPath long_path(long_route, TURNING_RADIUS, LOOKAHEAD, 2000);
+  std::vector<TwoDPose> long_poses;
+  for (const barebonesPose &point : long_path.pursuit_points) {
+    long_poses.push_back(TwoDPose(point.x, point.y, point.yaw));
+  }
+  run_benchmark("calculate_pursuit_estimate/sampled/20_waypoints", [&]() {
+    PurePursuitPath path = long_path;
+    for (const TwoDPose &pose : long_poses) {
+      sink = path.calculate_pursuit_estimate(pose).steering_angle;
+    }
+    return static_cast<long>(long_poses.size());
+  });
+}
+
+/**
+ * Drives a path with a simulated drivetrain until the conductor completes
+ * @returns The number of steps
+ */
+static long drive_path(PurePursuitConductor &conductor, TwoDPose pose) {
+  const double max_speed = 1.5;    // Meters per second at 12 volts
+  const double track_width = 0.3;  // Meters
+  const double dt = 0.01;          // Seconds per step
+  long steps = 0;
+  for (; steps < 4000; steps++) {
+    PursuitResult result = conductor.step(pose);
+    if (!result.is_valid || result.is_completed) {
+      break;
+    }
+    // The same mixing as WhoopDrivetrain
+    double forward = result.forward_power * result.direction;
+    double left, right;
+    if (result.has_side_powers) {
+      left = result.left_power;
+      right = result.right_power;
+    } else if (conductor.forward_pid.is_settled() ||
+               result.suggest_point_turn) {
+      left = forward - result.steering_power / 1.5;
+      right = forward + result.steering_power / 1.5;
+    } else if (result.direction < 0) {
+      left = forward + std::max(-result.steering_power, 0.0);
+      right = forward + std::max(result.steering_power, 0.0);
+    } else {
+      left = forward + std::min(-result.steering_power, 0.0);
+      right = forward + std::min(result.steering_power, 0.0);
+    }
+    double left_speed = clamp(left, -12.0, 12.0) / 12.0 * max_speed;
+    double right_speed = clamp(right, -12.0, 12.0) / 12.0 * max_speed;
+    double speed = (left_speed + right_speed) / 2;
+    double turn_rate = (right_speed - left_speed) / track_width;
+    pose.x += speed * cos(pose.yaw) * dt;
+    pose.y += speed * sin(pose.yaw) * dt;
+    pose.yaw = normalize_angle(pose.yaw + turn_rate * dt);
+  }
+  return steps + 1;
+}
+
+static void benchmark_conductor() {
+  std::vector<TwoDPose> waypoints = route(3);
+  for (pathrepresentation representation :
+       {pathrepresentation::path_sampled, pathrepresentation::path_analytic}) {
+    // Pure pursuit without and with a velocity profile, then RAMSETE and
+    // MPC. MPC is given all the time it needs, so that the steps do not
+    // depend on the speed of the computer
+    const char *configs[] = {"/unprofiled", "/profiled", "/ramsete", "/mpc"};
+    for (int config = 0; config < 4; config++) {
+      PursuitParams params;
+      params.path_representation = representation;
+      params.max_velocity = config == 0 ? 0.0 : 1.5;
+      if (config == 2) {
+        params.path_follower = pathfollower::follower_ramsete;
+      } else if (config == 3) {
+        params.path_follower = pathfollower::follower_mpc;
+        params.mpc.time_budget = 1;
+      }
+      PurePursuitConductor conductor(&params);
+      conductor.generate_path(waypoints, -1);
+      PurePursuitConductor original = conductor;
+
+      std::string name = std::string("PurePursuitConductor::step/") +
+                         representation_name(representation) +
+                         configs[config];
+      long steps = 0;
+      BenchmarkResult *result = run_benchmark(name, [&]() {
+        conductor = original;
+        steps = drive_path(conductor, waypoints[0]);
+        return steps;
+      });
+      if (result != nullptr) {
+        result->counters["steps"] = steps;
+      }
+    }
+  }
+
+  // One plan of the MPC, from a little off of each point of a trajectory
+  PursuitParams params;
+  params.max_velocity = 1.5;
+  PurePursuitConductor conductor(&params);
+  conductor.generate_path(waypoints, -1);
+  Trajectory trajectory;
+  conductor.pursuit_path.generate_trajectory(trajectory, 1.5, 2, 2, 2,
+                                             params.track_width);
+  MpcSide side(0, 8, 0, 12, 2);
+  ModelPredictiveController mpc(10, 1);
+  size_t index = 0;
+  BenchmarkResult *result =
+      run_benchmark("ModelPredictiveController::calculate", [&]() {
+        const TrajectoryState &state =
+            trajectory.states[index++ % trajectory.states.size()];
+        TwoDPose pose(state.x + 0.02, state.y - 0.01, state.yaw + 0.05);
+        double left, right;
+        mpc.calculate(pose, trajectory, state.time, params.track_width, side,
+                      side, state.velocity, state.velocity, &left, &right);
+        sink = left + right;
+        return 1L;
+      });
+  if (result != nullptr) {
+    result->counters["horizon"] = mpc.horizon;
+    result->counters["iterations"] = mpc.iterations;
+  }
+}
+
+static void benchmark_poses() {
+  std::vector<TwoDPose> poses = random_poses(256, 2);
+
+  size_t index = 0;
+  run_benchmark("TwoDPose::operator*", [&]() {
+    TwoDPose pose = poses[index % poses.size()] *
+                    poses[(index + 1) % poses.size()];
+    index++;
+    sink = pose.x;
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("TwoDPose::toObjectSpace", [&]() {
+    TwoDPose pose = poses[index % poses.size()].toObjectSpace(
+        poses[(index + 1) % poses.size()]);
+    index++;
+    sink = pose.x;
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("TwoDPose::toWorldSpace", [&]() {
+    TwoDPose pose = poses[index % poses.size()].toWorldSpace(
+        poses[(index + 1) % poses.size()]);
+    index++;
+    sink = pose.x;
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("TwoDPose::lookAt", [&]() {
+    TwoDPose &target = poses[(index + 1) % poses.size()];
+    TwoDPose pose = poses[index % poses.size()].lookAt(target.x, target.y);
+    index++;
+    sink = pose.yaw;
+    return 1L;
+  });
+}
+
+static void benchmark_transforms() {
+  std::vector<TwoDPose> poses = random_poses(256, 5);
+  Transform2D offset(TwoDPose(0.05, -0.12, 0));
+
+  // A fixed offset applied to a moving pose, as the odometry offset does
+  size_t index = 0;
+  run_benchmark("Transform2D::operator*", [&]() {
+    Transform2D pose(poses[index++ % poses.size()]);
+    sink = (pose * offset).x;
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("Transform2D::to_world_space", [&]() {
+    sink = offset.to_world_space(poses[index++ % poses.size()]).x;
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("Transform2D::to_object_space", [&]() {
+    sink = offset.to_object_space(poses[index++ % poses.size()]).x;
+    return 1L;
+  });
+
+  std::vector<double> points;
+  for (const TwoDPose &pose : poses) {
+    points.push_back(pose.x);
+    points.push_back(pose.y);
+  }
+  std::vector<double> out(points.size());
+
+  // Timed per point
+  run_benchmark("Transform2D::to_world_space/points=256", [&]() {
+    offset.to_world_space(points.data(), poses.size(), out.data());
+    sink = out[0];
+    return long(poses.size());
+  });
+}
+
+static void benchmark_odometry() {
+  WheelOdom odom;
+  odom.set_physical_distances(0.05, 0.08);
+  odom.set_position(0, 0, 0);
+  double forward = 0, sideways = 0, heading = 0;
+  run_benchmark("WheelOdom::update_pose", [&]() {
+    forward += 0.004;
+    sideways += 0.0005;
+    heading += 0.002;
+    odom.update_pose(forward, sideways, heading);
+    sink = odom.X_position;
+    return 1L;
+  });
+}
+
+// The same work in single and double precision, named <benchmark>/<scalar>
+template <typename Scalar>
+static void benchmark_scalar_type(const std::string &scalar_name) {
+  std::vector<TwoDPoseT<Scalar>> poses;
+  for (const TwoDPose &pose : random_poses(256, 3)) {
+    poses.push_back(TwoDPoseT<Scalar>(pose));
+  }
+
+  size_t index = 0;
+  run_benchmark("dubins_shortest_path/" + scalar_name, [&]() {
+    TwoDPoseT<Scalar> &a = poses[index % poses.size()];
+    TwoDPoseT<Scalar> &b = poses[(index + 1) % poses.size()];
+    index++;
+    Scalar q0[3] = {a.x, a.y, a.yaw};
+    Scalar q1[3] = {b.x, b.y, b.yaw};
+    DubinsPathT<Scalar> path;
+    dubins_shortest_path(&path, q0, q1, TURNING_RADIUS);
+    sink = dubins_path_length(&path);
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("TwoDPose::operator*/" + scalar_name, [&]() {
+    TwoDPoseT<Scalar> pose = poses[index % poses.size()] *
+                             poses[(index + 1) % poses.size()];
+    index++;
+    sink = pose.x;
+    return 1L;
+  });
+
+  WheelOdomT<Scalar> odom;
+  odom.set_physical_distances(0.05, 0.08);
+  odom.set_position(0, 0, 0);
+  Scalar forward = 0, sideways = 0, heading = 0;
+  run_benchmark("WheelOdom::update_pose/" + scalar_name, [&]() {
+    forward += 0.004;
+    sideways += 0.0005;
+    heading += 0.002;
+    odom.update_pose(forward, sideways, heading);
+    sink = odom.X_position;
+    return 1L;
+  });
+
+  PIDT<Scalar> pid(0, 2.0, 0.1, 0.5, 0.9, 0.2, 12.0);
+  index = 0;
+  run_benchmark("PID::step/" + scalar_name, [&]() {
+    sink = pid.step(poses[index % poses.size()].x);
+    index++;
+    return 1L;
+  });
+}
+
+// The fast math kernels against the standard library, named
+// <function>/fast and <function>/std
+static void benchmark_fast_math() {
+  std::vector<TwoDPose> poses = random_poses(256, 4);
+
+  size_t index = 0;
+  run_benchmark("sincos/std", [&]() {
+    double yaw = poses[index++ % poses.size()].yaw;
+    sink = std::sin(yaw) + std::cos(yaw);
+    return 1L;
+  });
+  index = 0;
+  run_benchmark("sincos/fast", [&]() {
+    double s, c;
+    fast_sincos(poses[index++ % poses.size()].yaw, &s, &c);
+    sink = s + c;
+    return 1L;
+  });
+
+  index = 0;
+  run_benchmark("atan2/std", [&]() {
+    TwoDPose &pose = poses[index++ % poses.size()];
+    sink = std::atan2(pose.y, pose.x);
+    return 1L;
+  });
+  index = 0;
+  run_benchmark("atan2/fast", [&]() {
+    TwoDPose &pose = poses[index++ % poses.size()];
+    sink = fast_atan2(pose.y, pose.x);
+    return 1L;
+  });
+
+  // Sums of two angles, as TwoDPose wraps them
+  index = 0;
+  run_benchmark("normalize_angle/std", [&]() {
+    sink = normalize_angle(poses[index % poses.size()].yaw +
+                           poses[(index + 1) % poses.size()].yaw);
+    index++;
+    return 1L;
+  });
+  index = 0;
+  run_benchmark("normalize_angle/fast", [&]() {
+    sink = fast_normalize_angle(poses[index % poses.size()].yaw +
+                                poses[(index + 1) % poses.size()].yaw);
+    index++;
+    return 1L;
+  });
+}
+
+// Shaping a motor voltage, per call and through a characterized table, named
+// voltage/linearize and voltage/table
+static void benchmark_voltage_shaping() {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> volts(-12, 12);
+  std::vector<double> voltages(256);
+  for (double &v : voltages) {
+    v = volts(rng);
+  }
+
+  // A motor that does not move under 1 volt and bends toward its top speed
+  std::vector<double> sweep, velocities;
+  for (int v = -12; v <= 12; v++) {
+    sweep.push_back(v);
+    double moving = std::max(std::abs(v) - 1.0, 0.0) / 11.0;
+    velocities.push_back((v < 0 ? -1 : 1) * std::sqrt(moving));
+  }
+  VoltageTable table;
+  table.build(sweep, velocities);
+
+  size_t index = 0;
+  run_benchmark("voltage/linearize", [&]() {
+    sink = linearize_voltage(voltages[index++ % voltages.size()]);
+    return 1L;
+  });
+  index = 0;
+  run_benchmark("voltage/table", [&]() {
+    sink = table.lookup(voltages[index++ % voltages.size()]);
+    return 1L;
+  });
+}
+
+// A step of wheel odometry and a vision frame through the pose filter, named
+// ekf/predict and ekf/update
+static void benchmark_pose_ekf() {
+  std::vector<TwoDPose> poses = random_poses(256, 6);
+
+  PoseEKF ekf;
+  size_t index = 0;
+  run_benchmark("ekf/predict", [&]() {
+    TwoDPose &pose = poses[index++ % poses.size()];
+    ekf.predict(pose.x * 0.01, pose.y * 0.01, pose.yaw * 0.01, pose.yaw, 0.01);
+    sink = ekf.get_pose().x;
+    return 1L;
+  });
+
+  // The frames are close to the estimate, so that they are taken
+  ekf.gate_threshold = 1e9;
+  index = 0;
+  run_benchmark("ekf/update", [&]() {
+    TwoDPose estimate = ekf.get_pose();
+    TwoDPose &pose = poses[index++ % poses.size()];
+    sink = ekf.update(estimate.x + pose.x * 0.01, estimate.y + pose.y * 0.01,
+                      estimate.yaw + pose.yaw * 0.01, 0.8);
+    return 1L;
+  });
+}
+
+static OccupancyGrid layout(const std::string &name) {
+  OccupancyGrid grid;
+  if (name == "center_box") {
+    grid.add_rectangle(-0.4, -0.4, 0.4, 0.4);
+  } else if (name == "wall_with_gap") {
+    grid.add_rectangle(-0.05, -1.83, 0.05, 0.9);
+  } else if (name == "posts") {
+    for (double x = -0.9; x <= 0.9; x += 0.6) {
+      for (double y = -0.9; y <= 0.9; y += 0.6) {
+        grid.add_circle(x, y, 0.08);
+      }
+    }
+  }
+  return grid;
+}
+
+static void benchmark_hybrid_a_star() {
+  TwoDPose start(-1.2, -1.2, 0);
+  TwoDPose goal(1.2, 1.2, M_PI_2);
+  for (const char *name : {"empty", "center_box", "wall_with_gap", "posts"}) {
+    HybridAStar planner(layout(name), 0.3, 0.2, 1.0);
+    HybridAStarResult plan;
+    BenchmarkResult *result =
+        run_benchmark(std::string("HybridAStar::plan/") + name, [&]() {
+          plan = planner.plan(start, goal, LOOKAHEAD);
+          sink = plan.length;
+          return 1L;
+        });
+    if (result != nullptr) {
+      result->counters["success"] = plan.success;
+      result->counters["length"] = plan.length;
+      result->counters["expansions"] = plan.expansions;
+    }
+  }
+}
+
+static void benchmark_heading_optimizer() {
+  std::vector<std::vector<double>> waypoints = {
+      {-1.2, -1.2, 0}, {0, -0.6}, {0.6, 0.6}, {-0.3, 1.2}, {-1.2, 0.3}};
+  for (int bins : {8, 16, 32}) {
+    HeadingOptimizationResult optimization;
+    BenchmarkResult *result = run_benchmark(
+        "optimize_headings/bins=" + std::to_string(bins), [&]() {
+          optimization =
+              optimize_headings(waypoints, TURNING_RADIUS, LOOKAHEAD, bins, 0);
+          sink = optimization.optimized_length;
+          return 1L;
+        });
+    if (result != nullptr) {
+      result->counters["length_reduction"] = optimization.length_reduction();
+    }
+  }
+}
+
+static void benchmark_path_file() {
+  std::vector<TwoDPose> waypoints = route(3);
+  for (pathrepresentation representation :
+       {pathrepresentation::path_sampled, pathrepresentation::path_analytic}) {
+    PurePursuitPath original(waypoints, TURNING_RADIUS, LOOKAHEAD, 100, -1,
+                             representation);
+    std::vector<uint8_t> bytes = serialize_path(original);
+    std::string suffix = representation_name(representation);
+
+    run_benchmark("PathFile/regenerate/" + suffix, [&]() {
+      PurePursuitPath path(waypoints, TURNING_RADIUS, LOOKAHEAD, 100, -1,
+                           representation);
+      sink = path.pursuit_checkpoints.size();
+      return 1L;
+    });
+    run_benchmark("PathFile/serialize/" + suffix, [&]() {
+      sink = serialize_path(original).size();
+      return 1L;
+    });
+    PurePursuitPath loaded = original;
+    BenchmarkResult *result =
+        run_benchmark("PathFile/deserialize/" + suffix, [&]() {
+          sink = deserialize_path(bytes.data(), bytes.size(), loaded);
+          return 1L;
+        });
+    if (result != nullptr) {
+      result->counters["bytes"] = bytes.size();
+    }
+  }
+}
+
+static std::string json_escape(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+static void write_json(FILE *file) {
+  fprintf(file, "{\n  \"schema\": 1,\n  \"compiler\": \"%s\",\n",
+          json_escape(__VERSION__).c_str());
+  fprintf(file, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult &result = results[i];
+    fprintf(file,
+            "    {\"name\": \"%s\", \"iterations\": %ld, \"ns_per_op\": %.2f, "
+            "\"min_ns_per_op\": %.2f, \"counters\": {",
+            json_escape(result.name).c_str(), result.iterations,
+            result.ns_per_op, result.min_ns_per_op);
+    size_t c = 0;
+    for (const auto &counter : result.counters) {
+      fprintf(file, "%s\"%s\": %.6g", c++ > 0 ? ", " : "",
+              json_escape(counter.first).c_str(), counter.second);
+    }
+    fprintf(file, "}}%s\n", i + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+  if (argc > 2) {
+    name_filter = argv[2];
+  }
+
+  benchmark_curves();
+  benchmark_path_generation();
+  benchmark_pursuit_estimate();
+  benchmark_conductor();
+  benchmark_poses();
+  benchmark_transforms();
+  benchmark_odometry();
+  benchmark_scalar_type<double>("double");
+  benchmark_scalar_type<float>("float");
+  benchmark_fast_math();
+  benchmark_voltage_shaping();
+  benchmark_pose_ekf();
+  benchmark_hybrid_a_star();
+  benchmark_heading_optimizer();
+  benchmark_path_file();
+
+  if (argc > 1) {
+    FILE *file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+    write_json(file);
+    fclose(file);
+  } else {
+    write_json(stdout);
+  }
+  return 0;
+}
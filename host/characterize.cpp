@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       characterize.cpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Characterizes the Drive Motors of a Simulated Robot       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Runs WhoopDrivetrain::characterize_motors on a simulated robot (see
+ * Simulator.hpp), and shows how proportional the velocity of the drive is to
+ * its voltage through linearize_voltage and through the characterized
+ * tables. As JSON:
+ *
+ *   {
+ *     "schema": 1,
+ *     "characterized": true,
+ *     "linearity": [
+ *       {"method": "linearize_voltage", "max_error": 0.047,
+ *        "velocities": [0.036, 0.144, ...]}, ...
+ *     ]
+ *   }
+ *
+ * velocities are how fast the robot turned in place at 1, 2, ... 12 volts, as
+ * a fraction of how fast it turned at 12 volts. max_error is the largest
+ * difference between those and the voltages over 12 (a proportional drive).
+ *
+ * Usage: characterize [output.json]
+ * Without an output file, the JSON is printed.
+ */
+
+#include "whooplib/include/devices/WhoopDrivetrain.hpp"
+#include "whooplib/include/host/Simulator.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+// The robot, as it would be configured in main.cpp
+static const double TRACK_WIDTH = 0.3;
+
+WhoopController controller1(joystickmode::joystickmode_split_arcade,
+                            controllertype::controller_primary);
+
+WhoopMotor l1(PORT1, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l2(PORT2, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l3(PORT3, cartridge::blue, reversed::yes_reverse);
+WhoopMotor r1(PORT4, cartridge::blue, reversed::no_reverse);
+WhoopMotor r2(PORT5, cartridge::blue, reversed::no_reverse);
+WhoopMotor r3(PORT6, cartridge::blue, reversed::no_reverse);
+
+WhoopInertial inertial_sensor(PORT7);
+WhoopRotation forward_tracker(PORT8, reversed::no_reverse);
+WhoopRotation sideways_tracker(PORT9, reversed::no_reverse);
+
+WhoopDriveOdomUnit odom_unit(0.03, to_meters(2.75), -0.1, to_meters(2.75),
+                             &inertial_sensor, &forward_tracker,
+                             &sideways_tracker);
+WhoopDriveOdomOffset odom_offset(&odom_unit, 0, 0);
+WhoopOdomFusion odom_fusion(&odom_offset);
+
+PursuitParams pursuit_parameters;
+
+WhoopDrivetrain robot_drivetrain(&pursuit_parameters, &odom_fusion,
+                                 PoseUnits::m_rad_ccw, &controller1,
+                                 {&l1, &l2, &l3}, {&r1, &r2, &r3});
+
+struct Linearity {
+  std::string method;
+  double max_error = 0;
+  std::vector<double> velocities;
+};
+
+/**
+ * Turns the robot in place at 1 to 12 volts, through whatever the motors
+ * spin through
+ */
+static Linearity measure_linearity(Simulator &simulator,
+                                   const std::string &method) {
+  std::vector<double> turn_rates;
+  for (int volts = 1; volts <= 12; volts++) {
+    for (WhoopMotor *motor : {&l1, &l2, &l3}) {
+      motor->spin(-volts);
+    }
+    for (WhoopMotor *motor : {&r1, &r2, &r3}) {
+      motor->spin(volts);
+    }
+    wait(600, msec);
+    turn_rates.push_back(simulator.get_angular_velocity());
+  }
+  for (WhoopMotor *motor : {&l1, &l2, &l3, &r1, &r2, &r3}) {
+    motor->spin(0);
+  }
+  wait(1000, msec);
+
+  Linearity linearity;
+  linearity.method = method;
+  for (size_t i = 0; i < turn_rates.size(); i++) {
+    double velocity = turn_rates[i] / turn_rates.back();
+    linearity.velocities.push_back(velocity);
+    linearity.max_error = std::max(linearity.max_error,
+                                   std::abs(velocity - (i + 1) / 12.0));
+  }
+  return linearity;
+}
+
+int main(int argc, char **argv) {
+  FILE *file = stdout;
+  if (argc > 1) {
+    file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  // The same robot, in the simulation
+  Simulator simulator;
+  simulator.chassis.track_width = TRACK_WIDTH;
+  for (int port : {PORT1, PORT2, PORT3}) {
+    simulator.add_drive_motor(port, driveside::side_left,
+                              reversed::yes_reverse, SimMotor(cartridge::blue));
+  }
+  for (int port : {PORT4, PORT5, PORT6}) {
+    simulator.add_drive_motor(port, driveside::side_right,
+                              reversed::no_reverse, SimMotor(cartridge::blue));
+  }
+  simulator.attach();
+
+  std::vector<Linearity> results;
+  results.push_back(measure_linearity(simulator, "linearize_voltage"));
+
+  bool characterized = robot_drivetrain.characterize_motors();
+
+  // The motors now spin through the tables the drivetrain built
+  results.push_back(measure_linearity(simulator, "characterized"));
+
+  fprintf(file, "{\n  \"schema\": 1,\n  \"characterized\": %s,\n",
+          characterized ? "true" : "false");
+  fprintf(file, "  \"linearity\": [");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Linearity &linearity = results[i];
+    fprintf(file, "%s\n    {\"method\": \"%s\", \"max_error\": %.4f, "
+                  "\"velocities\": [",
+            i == 0 ? "" : ",", linearity.method.c_str(), linearity.max_error);
+    for (size_t j = 0; j < linearity.velocities.size(); j++) {
+      fprintf(file, "%s%.4f", j == 0 ? "" : ", ", linearity.velocities[j]);
+    }
+    fprintf(file, "]}");
+    fprintf(stderr, "%-18s max error %4.1f%% of top speed\n",
+            linearity.method.c_str(), linearity.max_error * 100);
+  }
+  fprintf(file, "\n  ]\n}\n");
+  if (file != stdout) {
+    fclose(file);
+  }
+  return characterized ? 0 : 1;
+}
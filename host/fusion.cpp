@@ -0,0 +1,328 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       fusion.cpp                                                */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Replays a Drive Through Each Odometry Fusion Mode         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Drives the same run of a simulated robot (see Simulator.hpp) once for each
+ * mode of WhoopOdomFusion, and shows how far each fused pose was from where
+ * the robot truly was. The inertial sensor drifts and misreads its turns, and
+ * vision frames arrive at VISION_RATE with noise that grows as their
+ * confidence falls, some outliers, and a gap. Each frame arrives 60 ms after
+ * it was captured. The simulation and the frames are seeded, so every mode
+ * sees exactly the same run. As JSON:
+ *
+ *   {
+ *     "schema": 1,
+ *     "duration": 30.0,
+ *     "modes": [
+ *       {"mode": "fusion_ekf", "compensated": true, "rms_error": 0.011,
+ *        "max_error": 0.039, "rms_yaw_error": 0.011, "final_error": 0.003,
+ *        "rejected_frames": 18}, ...
+ *     ]
+ *   }
+ *
+ * Each mode that fuses vision runs twice: fusing frames as if they were
+ * captured as they arrived, and compensated, with the frames carrying their
+ * age and the latency of the link set on the vision system. The errors are
+ * in meters (and radians for the yaw), over every step of the run.
+ * rejected_frames counts the frames that the mode did not take.
+ *
+ * Usage: fusion [output.json]
+ * Without an output file, the JSON is printed.
+ */
+
+#include "whooplib/include/devices/WhoopDriveOdomOffset.hpp"
+#include "whooplib/include/devices/WhoopOdomFusion.hpp"
+#include "whooplib/include/devices/WhoopVision.hpp"
+#include "whooplib/include/host/Simulator.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+static const double DURATION = 30.0;     // Seconds of driving
+static const double STEP_TIME = 0.01;    // Seconds per step of the odometry
+static const double VISION_RATE = 30.0;  // Frames per second
+static const double OUTLIER_RATE = 0.03; // Fraction of frames that are wrong
+static const double GAP_START = 18.0;    // Seconds when the camera is blocked
+static const double GAP_END = 21.0;
+
+// Frames arrive this late: the Jetson Nano processes a frame for
+// PROCESSING_TIME (which it sends with the frame), and the link takes
+// LINK_LATENCY (which is measured)
+static const double PROCESSING_TIME = 0.04;
+static const double LINK_LATENCY = 0.02;
+
+// The robot, as it would be configured in main.cpp
+static const double FORWARD_TRACKER_DISTANCE = 0.03;
+static const double SIDEWAYS_TRACKER_DISTANCE = -0.1;
+
+WhoopMotor l1(PORT1, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l2(PORT2, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l3(PORT3, cartridge::blue, reversed::yes_reverse);
+WhoopMotor r1(PORT4, cartridge::blue, reversed::no_reverse);
+WhoopMotor r2(PORT5, cartridge::blue, reversed::no_reverse);
+WhoopMotor r3(PORT6, cartridge::blue, reversed::no_reverse);
+
+WhoopInertial inertial_sensor(PORT7);
+WhoopRotation forward_tracker(PORT8, reversed::no_reverse);
+WhoopRotation sideways_tracker(PORT9, reversed::no_reverse);
+
+
+/**
+ * The vision system, fed with frames of the simulated robot instead of
+ * messages from the Jetson Nano
+ */
+class ReplayVision : public WhoopVision {
+public:
+  using WhoopVision::WhoopVision;
+
+  /**
+   * Sends a frame, as the Jetson Nano would
+   * @param pose Where the frame sees the robot
+   * @param confidence How confident it is (0.0 - 1.0)
+   * @param age Seconds from when it was captured to when it was sent, or
+   * less than 0 to not send it
+   */
+  void frame(const TwoDPose &pose, double confidence, double age = -1) {
+    char message[128];
+    int length = snprintf(message, sizeof(message),
+                          "%.6f 0 %.6f 0 %.6f 0 %.6f", -pose.y, -pose.x,
+                          pose.yaw, confidence * 3.0);
+    if (age >= 0) {
+      snprintf(message + length, sizeof(message) - length, " %.1f",
+               age * 1000.0);
+    }
+    _update_pose(message);
+  }
+};
+
+struct Mode {
+  std::string name;
+  fusionmode mode;
+};
+
+struct Frame {
+  double arrival_time; // Seconds into the run
+  TwoDPose pose;
+  double confidence;
+};
+
+struct Result {
+  std::string mode;
+  bool compensated = false;
+  double rms_error = 0;
+  double max_error = 0;
+  double rms_yaw_error = 0;
+  double final_error = 0;
+  int rejected_frames = 0;
+};
+
+/**
+ * The voltages of the left and right sides at a time of the run: straights,
+ * arcs both ways, a spin, a reverse and an S-curve
+ */
+static void drive_script(double t, double *left, double *right) {
+  if (t < 3) {
+    *left = *right = 6;
+  } else if (t < 8) {
+    *left = 4;
+    *right = 8;
+  } else if (t < 10) {
+    *left = -5;
+    *right = 5;
+  } else if (t < 15) {
+    *left = 9;
+    *right = 5;
+  } else if (t < 17) {
+    *left = *right = -6;
+  } else if (t < 24) {
+    double turn = 3 * std::sin((t - 17) * 1.5);
+    *left = 7 - turn;
+    *right = 7 + turn;
+  } else if (t < 27) {
+    *left = *right = 11;
+  } else {
+    *left = *right = 0;
+  }
+}
+
+/**
+ * Drives the run with a mode
+ * @param mode The mode of WhoopOdomFusion
+ * @param compensated Whether the frames carry their age and the latency of
+ * the link is set, or they are fused as if they were captured as they arrive
+ */
+static Result replay(const Mode &mode, bool compensated) {
+  // Made for each run, as the fusion keeps a callback on the vision system,
+  // and the odometry its last readings
+  WhoopDriveOdomUnit odom_unit(FORWARD_TRACKER_DISTANCE, to_meters(2.75),
+                               SIDEWAYS_TRACKER_DISTANCE, to_meters(2.75),
+                               &inertial_sensor, &forward_tracker,
+                               &sideways_tracker);
+  WhoopDriveOdomOffset odom_offset(&odom_unit, 0, 0);
+  BufferNode buffer_system;
+  RobotVisionOffset vision_offset(0, 0);
+  ReplayVision vision(&vision_offset, &buffer_system, "P");
+  WhoopOdomFusion fusion(&vision, &odom_offset, 0.3, mode.mode, 0.5, 0.5);
+
+  // The same robot, in the simulation
+  Simulator simulator;
+  for (int port : {PORT1, PORT2, PORT3}) {
+    simulator.add_drive_motor(port, driveside::side_left,
+                              reversed::yes_reverse, SimMotor(cartridge::blue));
+  }
+  for (int port : {PORT4, PORT5, PORT6}) {
+    simulator.add_drive_motor(port, driveside::side_right,
+                              reversed::no_reverse, SimMotor(cartridge::blue));
+  }
+  simulator.add_inertial(PORT7, SimInertial(0.05, 0.05, 0.99));
+  SimTrackingWheel forward_wheel(0, FORWARD_TRACKER_DISTANCE, false);
+  SimTrackingWheel sideways_wheel(SIDEWAYS_TRACKER_DISTANCE, 0, true);
+  forward_wheel.noise = sideways_wheel.noise = 0.5;
+  simulator.add_tracking_wheel(PORT8, forward_wheel);
+  simulator.add_tracking_wheel(PORT9, sideways_wheel);
+  simulator.attach();
+
+  std::mt19937 random(7);
+  std::normal_distribution<double> gaussian(0.0, 1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  // The vision system is tared where the robot starts
+  vision.frame(TwoDPose(0, 0, 0), 1);
+  fusion.calibrate();
+  wait(2800, msec);
+  fusion.__step(); // Catches the odometry up to the tracking wheels at rest
+  fusion.tare(0, 0, 0);
+  fusion.accept_fuses();
+  vision.set_latency(compensated ? LINK_LATENCY : 0);
+
+  Result result;
+  result.mode = mode.name;
+  result.compensated = compensated;
+  std::deque<Frame> in_flight;
+  double start = simulator.get_time();
+  double next_frame = 0;
+  double sum_squared = 0, sum_squared_yaw = 0;
+  int steps = 0;
+  for (double t = 0; t < DURATION; t += STEP_TIME) {
+    double left, right;
+    drive_script(t, &left, &right);
+    for (WhoopMotor *motor : {&l1, &l2, &l3}) {
+      motor->spin(left);
+    }
+    for (WhoopMotor *motor : {&r1, &r2, &r3}) {
+      motor->spin(right);
+    }
+    wait(STEP_TIME * 1000, msec);
+    fusion.set_step_dt(STEP_TIME);
+    fusion.__step();
+
+    TwoDPose truth = simulator.get_pose();
+    double elapsed = simulator.get_time() - start;
+    if (elapsed >= next_frame) {
+      next_frame += 1.0 / VISION_RATE;
+
+      // Drawn for every frame, so every mode sees the same frames
+      double confidence = 0.4 + 0.6 * uniform(random);
+      double noise = 0.02 / confidence;
+      TwoDPose seen(truth.x + gaussian(random) * noise,
+                    truth.y + gaussian(random) * noise,
+                    normalize_angle(truth.yaw + gaussian(random) * noise));
+      if (uniform(random) < OUTLIER_RATE) {
+        seen.x += 0.4;
+        seen.yaw = normalize_angle(seen.yaw + 0.3);
+        confidence = 0.9;
+      }
+      if (elapsed < GAP_START || elapsed >= GAP_END) {
+        in_flight.push_back(
+            {elapsed + PROCESSING_TIME + LINK_LATENCY, seen, confidence});
+      }
+    }
+    while (!in_flight.empty() && in_flight.front().arrival_time <= elapsed) {
+      const Frame &frame = in_flight.front();
+      vision.frame(frame.pose, frame.confidence,
+                   compensated ? PROCESSING_TIME : -1);
+      if (!fusion.approving_frames() &&
+          mode.mode != fusionmode::wheel_odom_only) {
+        result.rejected_frames++;
+      }
+      in_flight.pop_front();
+    }
+
+    TwoDPose fused = fusion.get_pose_2d();
+    double error = std::hypot(fused.x - truth.x, fused.y - truth.y);
+    double yaw_error = normalize_angle(fused.yaw - truth.yaw);
+    sum_squared += error * error;
+    sum_squared_yaw += yaw_error * yaw_error;
+    result.max_error = std::max(result.max_error, error);
+    result.final_error = error;
+    steps++;
+  }
+  for (WhoopMotor *motor : {&l1, &l2, &l3, &r1, &r2, &r3}) {
+    motor->spin(0);
+  }
+  fusion.reject_fuses();
+
+  result.rms_error = std::sqrt(sum_squared / steps);
+  result.rms_yaw_error = std::sqrt(sum_squared_yaw / steps);
+  return result;
+}
+
+int main(int argc, char **argv) {
+  FILE *file = stdout;
+  if (argc > 1) {
+    file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  std::vector<Mode> modes = {
+      {"wheel_odom_only", fusionmode::wheel_odom_only},
+      {"fusion_instant", fusionmode::fusion_instant},
+      {"fusion_gradual", fusionmode::fusion_gradual},
+      {"fusion_ekf", fusionmode::fusion_ekf},
+  };
+
+  std::vector<Result> results;
+  for (const Mode &mode : modes) {
+    results.push_back(replay(mode, false));
+    if (mode.mode != fusionmode::wheel_odom_only) {
+      results.push_back(replay(mode, true));
+    }
+  }
+
+  fprintf(file, "{\n  \"schema\": 1,\n  \"duration\": %.1f,\n", DURATION);
+  fprintf(file, "  \"modes\": [");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &r = results[i];
+    fprintf(file,
+            "%s\n    {\"mode\": \"%s\", \"compensated\": %s, "
+            "\"rms_error\": %.4f, \"max_error\": %.4f, "
+            "\"rms_yaw_error\": %.4f, \"final_error\": %.4f, "
+            "\"rejected_frames\": %d}",
+            i == 0 ? "" : ",", r.mode.c_str(),
+            r.compensated ? "true" : "false", r.rms_error, r.max_error,
+            r.rms_yaw_error, r.final_error, r.rejected_frames);
+    fprintf(stderr, "%-16s %-11s rms %.3f m  max %.3f m  yaw %.3f rad\n",
+            r.mode.c_str(), r.compensated ? "compensated" : "",
+            r.rms_error, r.max_error, r.rms_yaw_error);
+  }
+  fprintf(file, "\n  ]\n}\n");
+  if (file != stdout) {
+    fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       generate_path.cpp                                         */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Generates Path Files on a Computer                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Generates a path the same way PurePursuitConductor::generate_path does on
+ * the brain, and saves it in the binary path file format (see PathFile.hpp).
+ * Copy the file to the SD card and drive it with
+ * WhoopDrivetrain::drive_through_path_file.
+ *
+ * Usage: generate_path [options] output_file waypoint waypoint [...]
+ *
+ * Each waypoint is "x,y,yaw" or "x,y". Positions are in meters and angles in
+ * radians, counter-clockwise-positive, unless changed with the options below.
+ * The first waypoint should be where the robot starts.
+ *
+ * Options (defaults are those of PursuitParams):
+ *   --inches              Positions and lengths are in inches
+ *   --degrees             Angles are in degrees
+ *   --clockwise           Angles are clockwise-positive
+ *   --turning-radius R    Radius of the turns
+ *   --lookahead L         Pure pursuit look ahead distance
+ *   --segments N          Number of points of the path
+ *   --landing-strip L     Length of the landing strip
+ *   --analytic            Store line and arc primitives instead of points
+ *   --reeds-shepp         Allow the path to reverse part of the way
+ *   --smoothing L         Length of the clothoid transitions
+ *   --max-velocity V      Generate a velocity profile (meters per second)
+ *   --heading-bins N      Optimize the headings of "x,y" waypoints
+ */
+
+#include "whooplib/include/calculators/PathFile.hpp"
+#include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/calculators/Units.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+static void print_usage() {
+  fprintf(stderr,
+          "Usage: generate_path [options] output_file waypoint waypoint ...\n"
+          "Each waypoint is \"x,y,yaw\" or \"x,y\". See generate_path.cpp for "
+          "the options\n");
+}
+
+static bool parse_waypoint(const std::string &text,
+                           std::vector<double> &waypoint) {
+  std::stringstream stream(text);
+  std::string value;
+  while (std::getline(stream, value, ',')) {
+    char *end;
+    waypoint.push_back(strtod(value.c_str(), &end));
+    if (end == value.c_str() || *end != '\0') {
+      return false;
+    }
+  }
+  return waypoint.size() == 2 || waypoint.size() == 3;
+}
+
+int main(int argc, char **argv) {
+  PursuitParams params;
+  bool inches = false, degrees = false, clockwise = false;
+  double turning_radius = -1, lookahead = -1, landing_strip = -1;
+  double smoothing = -1;
+  std::vector<std::string> positional;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--inches") {
+      inches = true;
+    } else if (arg == "--degrees") {
+      degrees = true;
+    } else if (arg == "--clockwise") {
+      clockwise = true;
+    } else if (arg == "--analytic") {
+      params.path_representation = pathrepresentation::path_analytic;
+    } else if (arg == "--reeds-shepp") {
+      params.path_planner = pathplanner::planner_reeds_shepp;
+    } else if (arg == "--turning-radius" && has_value) {
+      turning_radius = atof(argv[++i]);
+    } else if (arg == "--lookahead" && has_value) {
+      lookahead = atof(argv[++i]);
+    } else if (arg == "--segments" && has_value) {
+      params.num_path_segments = atoi(argv[++i]);
+    } else if (arg == "--landing-strip" && has_value) {
+      landing_strip = atof(argv[++i]);
+    } else if (arg == "--smoothing" && has_value) {
+      smoothing = atof(argv[++i]);
+    } else if (arg == "--max-velocity" && has_value) {
+      params.max_velocity = atof(argv[++i]);
+    } else if (arg == "--heading-bins" && has_value) {
+      params.heading_bins = atoi(argv[++i]);
+    } else if (arg.rfind("--", 0) == 0) {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      print_usage();
+      return 1;
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  if (positional.size() < 3) {
+    print_usage();
+    return 1;
+  }
+
+  // Converting to meters and radians, counter-clockwise-positive
+  double length_scale = inches ? to_meters(1.0) : 1.0;
+  if (turning_radius >= 0) {
+    params.turning_radius = turning_radius * length_scale;
+  }
+  if (lookahead >= 0) {
+    params.lookahead_distance = lookahead * length_scale;
+  }
+  if (landing_strip >= 0) {
+    landing_strip *= length_scale;
+  }
+  if (smoothing >= 0) {
+    params.smoothing_length = smoothing * length_scale;
+  }
+
+  std::vector<std::vector<double>> waypoints;
+  for (size_t i = 1; i < positional.size(); i++) {
+    std::vector<double> waypoint;
+    if (!parse_waypoint(positional[i], waypoint)) {
+      fprintf(stderr, "Invalid waypoint \"%s\"\n", positional[i].c_str());
+      return 1;
+    }
+    waypoint[0] *= length_scale;
+    waypoint[1] *= length_scale;
+    if (waypoint.size() == 3) {
+      if (degrees) {
+        waypoint[2] = to_rad(waypoint[2]);
+      }
+      if (clockwise) {
+        waypoint[2] *= -1;
+      }
+    }
+    waypoints.push_back(waypoint);
+  }
+  if (waypoints[0].size() != 3) {
+    fprintf(stderr, "The first waypoint needs a yaw\n");
+    return 1;
+  }
+
+  PurePursuitConductor conductor(&params);
+  conductor.generate_path(waypoints, -1, -1, landing_strip);
+  std::vector<uint8_t> bytes = serialize_path(conductor.pursuit_path);
+
+  FILE *file = fopen(positional[0].c_str(), "wb");
+  if (file == nullptr ||
+      fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+    fprintf(stderr, "Could not write %s\n", positional[0].c_str());
+    if (file != nullptr) {
+      fclose(file);
+    }
+    return 1;
+  }
+  fclose(file);
+
+  printf("Wrote %zu bytes to %s\n", bytes.size(), positional[0].c_str());
+  return 0;
+}
@@ -0,0 +1,253 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       odometry.cpp                                              */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Integrates Odometry on Fast Arcs at Different Rates       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Drives a simulated robot (see Simulator.hpp) through fast arcs, S-curves
+ * and spins, and shows how far the wheel odometry drifts from where the robot
+ * truly is, depending on how often it is stepped:
+ *
+ *   - coupled: stepped by the control loop, as WhoopDrivetrain does by
+ *     default, every 10 ms, with one step in every 20 overrunning to 40 ms
+ *   - own node: WhoopOdomFusion runs as its own node, at its own step time,
+ *     while the control loop overruns the same way
+ *
+ * The sensors read without noise (only as coarsely as the rotation sensor),
+ * so the error is from integrating the steps, and from how old the pose is
+ * when it is read. As JSON:
+ *
+ *   {
+ *     "schema": 1,
+ *     "duration": 20.0,
+ *     "runs": [
+ *       {"odometry": "own_node_5ms", "step_time": 0.005,
+ *        "rms_error": 0.041, "final_error": 0.078,
+ *        "rms_yaw_error": 0.017}, ...
+ *     ]
+ *   }
+ *
+ * The errors are in meters (and radians for the yaw), sampled every 10 ms.
+ *
+ * Usage: odometry [output.json]
+ * Without an output file, the JSON is printed.
+ */
+
+#include "whooplib/include/devices/WhoopDriveOdomOffset.hpp"
+#include "whooplib/include/devices/WhoopOdomFusion.hpp"
+#include "whooplib/include/host/Simulator.hpp"
+#include "whooplib/include/nodes/NodeManager.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+static const double DURATION = 20.0;  // Seconds of driving
+static const int CONTROL_STEP_MS = 10; // The step time of the control loop
+static const int OVERRUN_EVERY = 20;   // Control steps per overrunning step
+static const int OVERRUN_MS = 30;      // How much longer an overrun takes
+
+// The robot, as it would be configured in main.cpp
+static const double FORWARD_TRACKER_DISTANCE = 0.03;
+static const double SIDEWAYS_TRACKER_DISTANCE = -0.1;
+
+WhoopMotor l1(PORT1, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l2(PORT2, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l3(PORT3, cartridge::blue, reversed::yes_reverse);
+WhoopMotor r1(PORT4, cartridge::blue, reversed::no_reverse);
+WhoopMotor r2(PORT5, cartridge::blue, reversed::no_reverse);
+WhoopMotor r3(PORT6, cartridge::blue, reversed::no_reverse);
+
+WhoopInertial inertial_sensor(PORT7);
+WhoopRotation forward_tracker(PORT8, reversed::no_reverse);
+WhoopRotation sideways_tracker(PORT9, reversed::no_reverse);
+
+WhoopDriveOdomUnit odom_unit(FORWARD_TRACKER_DISTANCE, to_meters(2.75),
+                             SIDEWAYS_TRACKER_DISTANCE, to_meters(2.75),
+                             &inertial_sensor, &forward_tracker,
+                             &sideways_tracker);
+WhoopDriveOdomOffset odom_offset(&odom_unit, 0, 0);
+WhoopOdomFusion odom_fusion(&odom_offset);
+
+/**
+ * The voltages of the left and right sides at a time of the run: arcs at
+ * full speed both ways, S-curves and spins
+ */
+static void drive_script(double t, double *left, double *right) {
+  double phase = std::fmod(t, 10.0);
+  if (phase < 3) {
+    *left = 12;
+    *right = 6;
+  } else if (phase < 6) {
+    double turn = 5 * std::sin((phase - 3) * 2 * M_PI / 1.5);
+    *left = 11 - turn;
+    *right = 11 + turn;
+  } else if (phase < 7) {
+    *left = -12;
+    *right = 12;
+  } else {
+    *left = 5;
+    *right = 12;
+  }
+}
+
+/**
+ * The control loop, which drives the script and steps the odometry unless
+ * it runs on its own, as WhoopDrivetrain does
+ */
+class ArcDriver : public ComputeNode {
+public:
+  const Simulator *simulator = nullptr;
+  double start_time = 0; // Seconds on the clock of the simulator
+  int steps = 0;
+
+protected:
+  void __step() override {
+    if (!odom_fusion.node_running) {
+      odom_fusion.set_step_dt(step_dt);
+      odom_fusion.__step();
+    }
+
+    double left, right;
+    drive_script(simulator->get_time() - start_time, &left, &right);
+    for (WhoopMotor *motor : {&l1, &l2, &l3}) {
+      motor->spin(left);
+    }
+    for (WhoopMotor *motor : {&r1, &r2, &r3}) {
+      motor->spin(right);
+    }
+
+    // Some steps take longer, as with a path being planned
+    if (++steps % OVERRUN_EVERY == 0) {
+      wait(OVERRUN_MS, msec);
+    }
+  }
+};
+
+ArcDriver driver;
+
+struct Run {
+  std::string name;
+  int odometry_step_ms; // 0 for stepped by the control loop
+};
+
+struct Result {
+  std::string name;
+  double step_time = 0;
+  double rms_error = 0;
+  double final_error = 0;
+  double rms_yaw_error = 0;
+};
+
+static Result drive(const Run &run) {
+  Simulator simulator;
+  for (int port : {PORT1, PORT2, PORT3}) {
+    simulator.add_drive_motor(port, driveside::side_left,
+                              reversed::yes_reverse, SimMotor(cartridge::blue));
+  }
+  for (int port : {PORT4, PORT5, PORT6}) {
+    simulator.add_drive_motor(port, driveside::side_right,
+                              reversed::no_reverse, SimMotor(cartridge::blue));
+  }
+  simulator.add_inertial(PORT7, SimInertial(0, 0, 1));
+  simulator.add_tracking_wheel(
+      PORT8, SimTrackingWheel(0, FORWARD_TRACKER_DISTANCE, false));
+  simulator.add_tracking_wheel(
+      PORT9, SimTrackingWheel(SIDEWAYS_TRACKER_DISTANCE, 0, true));
+  simulator.attach();
+
+  odom_fusion.calibrate();
+  wait(2800, msec);
+  odom_fusion.__step(); // Catches the odometry up to the tracking wheels
+  odom_fusion.tare(0, 0, 0);
+
+  driver.set_step_time(CONTROL_STEP_MS);
+  driver.simulator = &simulator;
+  driver.start_time = simulator.get_time();
+  driver.steps = 0;
+  driver.start_pipeline();
+  if (run.odometry_step_ms > 0) {
+    odom_fusion.set_step_time(run.odometry_step_ms);
+    odom_fusion.start_pipeline();
+  }
+
+  Result result;
+  result.name = run.name;
+  result.step_time =
+      (run.odometry_step_ms > 0 ? run.odometry_step_ms : CONTROL_STEP_MS) /
+      1000.0;
+  double sum_squared = 0, sum_squared_yaw = 0;
+  int samples = 0;
+  for (double t = 0; t < DURATION; t += 0.01) {
+    wait(10, msec);
+    TwoDPose truth = simulator.get_pose();
+    TwoDPose odometry = odom_fusion.get_pose_2d();
+    double error = std::hypot(odometry.x - truth.x, odometry.y - truth.y);
+    double yaw_error = normalize_angle(odometry.yaw - truth.yaw);
+    sum_squared += error * error;
+    sum_squared_yaw += yaw_error * yaw_error;
+    result.final_error = error;
+    samples++;
+  }
+
+  // Stop the nodes, and let their tasks finish before unplugging
+  driver.stop_pipeline();
+  odom_fusion.stop_pipeline();
+  wait(100, msec);
+  for (WhoopMotor *motor : {&l1, &l2, &l3, &r1, &r2, &r3}) {
+    motor->spin(0);
+  }
+
+  result.rms_error = std::sqrt(sum_squared / samples);
+  result.rms_yaw_error = std::sqrt(sum_squared_yaw / samples);
+  return result;
+}
+
+int main(int argc, char **argv) {
+  FILE *file = stdout;
+  if (argc > 1) {
+    file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  std::vector<Run> runs = {
+      {"coupled", 0},
+      {"own_node_10ms", 10},
+      {"own_node_5ms", 5},
+      {"own_node_2ms", 2},
+  };
+
+  std::vector<Result> results;
+  for (const Run &run : runs) {
+    results.push_back(drive(run));
+  }
+
+  fprintf(file, "{\n  \"schema\": 1,\n  \"duration\": %.1f,\n", DURATION);
+  fprintf(file, "  \"runs\": [");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &r = results[i];
+    fprintf(file,
+            "%s\n    {\"odometry\": \"%s\", \"step_time\": %.3f, "
+            "\"rms_error\": %.4f, \"final_error\": %.4f, "
+            "\"rms_yaw_error\": %.5f}",
+            i == 0 ? "" : ",", r.name.c_str(), r.step_time, r.rms_error,
+            r.final_error, r.rms_yaw_error);
+    fprintf(stderr, "%-14s rms %.4f m  final %.4f m  yaw %.5f rad\n",
+            r.name.c_str(), r.rms_error, r.final_error, r.rms_yaw_error);
+  }
+  fprintf(file, "\n  ]\n}\n");
+  if (file != stdout) {
+    fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,292 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       precision.cpp                                             */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Float and Fast Math Error of the Calculators              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Runs the same long paths and odometry through the float and double versions
+ * of the calculators, and reports how far the float results drift from the
+ * double ones, in meters (or radians for yaw). It also checks the fast math
+ * kernels (FastMath.hpp) against the standard library. As JSON:
+ *
+ *   {
+ *     "schema": 1,
+ *     "dubins": {"length": 41.2, "max_error": ..., "mean_error": ...,
+ *                "error_vs_distance": [{"distance": 5, "max_error": ...}]},
+ *     "pose_chain": {...},
+ *     "wheel_odom": {...},
+ *     "fast_math": {"fast_sin": {"max_error": ..., "bound": 1e-10}, ...}
+ *   }
+ *
+ * Usage: precision [output.json]
+ * Without an output file, the JSON is printed. Exits with 1 if a fast math
+ * kernel is outside of its documented error bound.
+ */
+
+#include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include "whooplib/include/calculators/WheelOdom.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace whoop;
+
+static const double TURNING_RADIUS = 0.127;
+static const double FIELD_HALF_WIDTH = 1.6;
+
+// Largest error seen up to each checkpoint along a run
+struct ErrorTrack {
+  double checkpoint_spacing;
+  double next_checkpoint;
+  double max_error = 0;
+  double total_error = 0;
+  long num_samples = 0;
+  std::vector<std::pair<double, double>> checkpoints;
+
+  explicit ErrorTrack(double spacing)
+      : checkpoint_spacing(spacing), next_checkpoint(spacing) {}
+
+  void add(double progress, double error) {
+    max_error = std::max(max_error, error);
+    total_error += error;
+    num_samples++;
+    while (progress >= next_checkpoint) {
+      checkpoints.push_back({next_checkpoint, max_error});
+      next_checkpoint += checkpoint_spacing;
+    }
+  }
+
+  double mean_error() const {
+    return num_samples == 0 ? 0 : total_error / num_samples;
+  }
+};
+
+static void write_track(FILE *file, const char *name, const char *progress,
+                        double length, const ErrorTrack &track,
+                        const ErrorTrack &yaw_track, bool last) {
+  fprintf(file, "  \"%s\": {\n", name);
+  fprintf(file, "    \"%s\": %.6g,\n", progress, length);
+  fprintf(file, "    \"max_error\": %.6g,\n", track.max_error);
+  fprintf(file, "    \"mean_error\": %.6g,\n", track.mean_error());
+  fprintf(file, "    \"max_yaw_error\": %.6g,\n", yaw_track.max_error);
+  fprintf(file, "    \"error_vs_%s\": [", progress);
+  for (size_t i = 0; i < track.checkpoints.size(); i++) {
+    fprintf(file, "%s\n      {\"%s\": %.6g, \"max_error\": %.6g}",
+            i == 0 ? "" : ",", progress, track.checkpoints[i].first,
+            track.checkpoints[i].second);
+  }
+  fprintf(file, "\n    ]\n  }%s\n", last ? "" : ",");
+  fprintf(stderr, "%-12s max error %.3g m, mean error %.3g m, max yaw error "
+                  "%.3g rad over %.1f %s\n",
+          name, track.max_error, track.mean_error(), yaw_track.max_error,
+          length, progress);
+}
+
+static double angle_error(double a, double b) {
+  return std::fabs(std::remainder(a - b, 2 * M_PI));
+}
+
+/**
+ * A long route of random waypoints around the field, each leg planned and
+ * sampled every centimeter in both precisions
+ */
+static double dubins_route(ErrorTrack &track, ErrorTrack &yaw_track) {
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> position(-FIELD_HALF_WIDTH,
+                                                  FIELD_HALF_WIDTH);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+  double distance = 0;
+  TwoDPose from(0, 0, 0);
+  for (int leg = 0; leg < 20; leg++) {
+    TwoDPose to(position(generator), position(generator), angle(generator));
+    TwoDPosef from_f(from), to_f(to);
+
+    double q0[3] = {from.x, from.y, from.yaw};
+    double q1[3] = {to.x, to.y, to.yaw};
+    float q0_f[3] = {from_f.x, from_f.y, from_f.yaw};
+    float q1_f[3] = {to_f.x, to_f.y, to_f.yaw};
+    DubinsPath path;
+    DubinsPathf path_f;
+    dubins_shortest_path(&path, q0, q1, TURNING_RADIUS);
+    dubins_shortest_path(&path_f, q0_f, q1_f, TURNING_RADIUS);
+
+    double length = dubins_path_length(&path);
+    for (double t = 0; t < length; t += 0.01) {
+      double q[3];
+      float q_f[3];
+      dubins_path_sample(&path, t, q);
+      dubins_path_sample(&path_f, static_cast<float>(t), q_f);
+      track.add(distance + t, std::hypot(q[0] - q_f[0], q[1] - q_f[1]));
+      yaw_track.add(distance + t, angle_error(q[2], q_f[2]));
+    }
+    distance += length;
+    from = to;
+  }
+  return distance;
+}
+
+/**
+ * Composes a pose with small steps, the way a pose is built up when driving
+ * a path in small increments, one step at a time in both precisions
+ */
+static long pose_chain(ErrorTrack &track, ErrorTrack &yaw_track) {
+  const long num_steps = 100000;
+  TwoDPose step(0.0005, 0.01, 0.003);
+  TwoDPosef step_f(step);
+  TwoDPose pose;
+  TwoDPosef pose_f;
+  for (long i = 1; i <= num_steps; i++) {
+    pose *= step;
+    pose_f *= step_f;
+    track.add(i, std::hypot(pose.x - pose_f.x, pose.y - pose_f.y));
+    yaw_track.add(i, angle_error(pose.yaw, pose_f.yaw));
+  }
+  return num_steps;
+}
+
+/**
+ * A minute of driving around at 200Hz, with the tracking wheel positions
+ * growing the whole time as they do during a match
+ */
+static double wheel_odom_drift(ErrorTrack &track, ErrorTrack &yaw_track) {
+  const double rate = 200;
+  const double duration = 60;
+  WheelOdom odom;
+  WheelOdomf odom_f;
+  odom.set_physical_distances(0.05, 0.08);
+  odom_f.set_physical_distances(0.05, 0.08);
+  odom.set_position(0, 0, 0);
+  odom_f.set_position(0, 0, 0);
+
+  double forward = 0, sideways = 0, heading = 0;
+  for (long i = 1; i <= duration * rate; i++) {
+    double time = i / rate;
+    double velocity = 1.2 + 0.3 * std::sin(time * 0.7);
+    double turn_rate = 2.5 * std::sin(time * 0.45);
+    heading += turn_rate / rate;
+    forward += (velocity - turn_rate * 0.05) / rate;
+    sideways += (0.02 * std::sin(time * 3.0) + turn_rate * 0.08) / rate;
+    odom.update_pose(forward, sideways, heading);
+    odom_f.update_pose(forward, sideways, heading);
+    track.add(time, std::hypot(odom.X_position - odom_f.X_position,
+                               odom.Y_position - odom_f.Y_position));
+    yaw_track.add(time, angle_error(odom.orientation_rad,
+                                    odom_f.orientation_rad));
+  }
+  return duration;
+}
+
+struct KernelError {
+  const char *name;
+  double max_error;
+  double bound;
+};
+
+/**
+ * The largest differences of the fast math kernels from the standard library,
+ * over random angles and points as well as the edge cases
+ */
+static std::vector<KernelError> fast_math_errors() {
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> near_angle(-4 * M_PI, 4 * M_PI);
+  std::uniform_real_distribution<double> far_angle(-1e4, 1e4);
+  std::uniform_real_distribution<double> exponent(-6, 6);
+  std::uniform_real_distribution<double> unit(-1, 1);
+  const int num_samples = 2000000;
+
+  double sin_error = 0, cos_error = 0, atan2_error = 0;
+  double normalize_error = 0;
+  for (int i = 0; i < num_samples; i++) {
+    double x = i % 2 == 0 ? near_angle(generator) : far_angle(generator);
+    double s, c;
+    fast_sincos(x, &s, &c);
+    sin_error = std::max(sin_error, std::fabs(s - std::sin(x)));
+    cos_error = std::max(cos_error, std::fabs(c - std::cos(x)));
+    sin_error = std::max(sin_error, std::fabs(fast_sin(x) - std::sin(x)));
+    cos_error = std::max(cos_error, std::fabs(fast_cos(x) - std::cos(x)));
+
+    // Relative to the size of the angle, as in the documented bound
+    double wrapped = fast_normalize_angle(x);
+    double error = angle_error(wrapped, normalize_angle(x));
+    if (wrapped < -M_PI || wrapped > M_PI) {
+      error = INFINITY;
+    }
+    normalize_error = std::max(normalize_error, error / (1 + std::fabs(x)));
+
+    double scale = std::pow(10.0, exponent(generator));
+    double px = unit(generator) * scale, py = unit(generator) * scale;
+    atan2_error = std::max(
+        atan2_error, std::fabs(fast_atan2(py, px) - std::atan2(py, px)));
+  }
+
+  // The axes and diagonals, with both signs of zero
+  const double edges[] = {0.0, -0.0, 1.0, -1.0, 1e-300, -1e-300};
+  for (double y : edges) {
+    for (double x : edges) {
+      atan2_error = std::max(atan2_error,
+                             std::fabs(fast_atan2(y, x) - std::atan2(y, x)));
+      if (std::signbit(fast_atan2(y, x)) != std::signbit(std::atan2(y, x))) {
+        atan2_error = INFINITY;
+      }
+    }
+  }
+
+  return {{"fast_sin", sin_error, 1e-10},
+          {"fast_cos", cos_error, 1e-10},
+          {"fast_atan2", atan2_error, 5e-10},
+          {"fast_normalize_angle", normalize_error, 1e-15}};
+}
+
+int main(int argc, char **argv) {
+  FILE *file = stdout;
+  if (argc > 1) {
+    file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  fprintf(file, "{\n  \"schema\": 1,\n");
+
+  ErrorTrack dubins(5), dubins_yaw(5);
+  double length = dubins_route(dubins, dubins_yaw);
+  write_track(file, "dubins", "distance", length, dubins, dubins_yaw, false);
+
+  ErrorTrack chain(10000), chain_yaw(10000);
+  long steps = pose_chain(chain, chain_yaw);
+  write_track(file, "pose_chain", "steps", steps, chain, chain_yaw, false);
+
+  ErrorTrack odom(10), odom_yaw(10);
+  double seconds = wheel_odom_drift(odom, odom_yaw);
+  write_track(file, "wheel_odom", "seconds", seconds, odom, odom_yaw, false);
+
+  bool within_bounds = true;
+  std::vector<KernelError> kernels = fast_math_errors();
+  fprintf(file, "  \"fast_math\": {\n");
+  for (size_t i = 0; i < kernels.size(); i++) {
+    const KernelError &kernel = kernels[i];
+    bool within_bound = kernel.max_error <= kernel.bound;
+    within_bounds = within_bounds && within_bound;
+    fprintf(file, "    \"%s\": {\"max_error\": %.6g, \"bound\": %.6g}%s\n",
+            kernel.name, kernel.max_error, kernel.bound,
+            i + 1 < kernels.size() ? "," : "");
+    fprintf(stderr, "%-20s max error %.3g (bound %.3g)%s\n", kernel.name,
+            kernel.max_error, kernel.bound, within_bound ? "" : " EXCEEDED");
+  }
+  fprintf(file, "  }\n}\n");
+  if (file != stdout) {
+    fclose(file);
+  }
+  return within_bounds ? 0 : 1;
+}
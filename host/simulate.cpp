@@ -0,0 +1,277 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       simulate.cpp                                              */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Drives an Autonomous Routine on a Simulated Robot         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Drives an autonomous routine with WhoopDrivetrain, WhoopDriveOdomUnit and
+ * the rest of the robot code as it runs on the brain, against a simulated
+ * drivetrain (see Simulator.hpp). The inertial sensor has noise and bias, and
+ * the tracking wheels read as coarsely as the rotation sensor. As JSON:
+ *
+ *   {
+ *     "schema": 1,
+ *     "simulated_time": 21.4,
+ *     "real_time": 0.61,
+ *     "moves": [
+ *       {"move": "drive_forward", "time": 1.23, "target_error": 0.012,
+ *        "odometry_error": 0.002, "odometry_yaw_error": 0.004,
+ *        "saturated": 0.15, "start_jump": 1.2}, ...
+ *     ]
+ *   }
+ *
+ * time is how long the move took on the simulated clock, in seconds.
+ * target_error is how far the robot truly ended from the target (for the
+ * chained moves, where it handed off to the next move at speed), and
+ * odometry_error how far the odometry was from where the robot truly was, in
+ * meters (and radians for the yaw). saturated is the fraction of the steps
+ * that the drive mixer scaled down to fit the motors. start_jump is how much
+ * the voltage of a side changed from before the move to its first step, in
+ * volts. real_time is how long the whole routine took to simulate, in
+ * seconds.
+ *
+ * Usage: simulate [output.json]
+ * Without an output file, the JSON is printed. Exits with 1 if a move that
+ * a chained move handed off to starts with a step in the voltage of a side
+ * larger than the slews allow.
+ */
+
+#include "whooplib/include/devices/WhoopDrivetrain.hpp"
+#include "whooplib/include/host/Simulator.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+// The robot, as it would be configured in main.cpp
+static const double TRACK_WIDTH = 0.3;
+static const double FORWARD_TRACKER_DISTANCE = 0.03; // Right of the center
+static const double SIDEWAYS_TRACKER_DISTANCE = -0.1; // Forward of the center
+
+WhoopController controller1(joystickmode::joystickmode_split_arcade,
+                            controllertype::controller_primary);
+
+WhoopMotor l1(PORT1, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l2(PORT2, cartridge::blue, reversed::yes_reverse);
+WhoopMotor l3(PORT3, cartridge::blue, reversed::yes_reverse);
+WhoopMotor r1(PORT4, cartridge::blue, reversed::no_reverse);
+WhoopMotor r2(PORT5, cartridge::blue, reversed::no_reverse);
+WhoopMotor r3(PORT6, cartridge::blue, reversed::no_reverse);
+
+WhoopInertial inertial_sensor(PORT7);
+WhoopRotation forward_tracker(PORT8, reversed::no_reverse);
+WhoopRotation sideways_tracker(PORT9, reversed::no_reverse);
+
+WhoopDriveOdomUnit odom_unit(FORWARD_TRACKER_DISTANCE, to_meters(2.75),
+                             SIDEWAYS_TRACKER_DISTANCE, to_meters(2.75),
+                             &inertial_sensor, &forward_tracker,
+                             &sideways_tracker);
+WhoopDriveOdomOffset odom_offset(&odom_unit, 0, 0);
+WhoopOdomFusion odom_fusion(&odom_offset);
+
+PursuitParams pursuit_parameters;
+
+WhoopDrivetrain robot_drivetrain(&pursuit_parameters, &odom_fusion,
+                                 PoseUnits::m_rad_ccw, &controller1,
+                                 {&l1, &l2, &l3}, {&r1, &r2, &r3});
+
+ComputeManager manager({&robot_drivetrain, &controller1});
+
+// Records the voltage that the drivetrain gives each side
+class RecordingSimulator : public Simulator {
+public:
+  double left_volts = 0, right_volts = 0;
+  bool record_start = false; // Set to record the next step as the start
+  double start_left_volts = 0, start_right_volts = 0;
+  double start_dt = 0; // Seconds since the step before the start
+  double last_step_time = 0;
+
+  void motor_spin(int port, double volts) override {
+    Simulator::motor_spin(port, volts);
+    if (port == PORT1) {
+      left_volts = -volts; // The left motors are mounted reversed
+    } else if (port == PORT4) { // The right side spins after the left
+      right_volts = volts;
+      if (record_start) {
+        record_start = false;
+        start_left_volts = left_volts;
+        start_right_volts = right_volts;
+        start_dt = get_time() - last_step_time;
+      }
+      last_step_time = get_time();
+    }
+  }
+};
+
+struct Move {
+  std::string name;
+  TwoDPose target;
+  std::function<void()> start;
+  bool chained = false; // If it hands off to the next move at speed
+};
+
+struct Result {
+  std::string name;
+  double time = 0;
+  double target_error = 0;
+  double odometry_error = 0;
+  double odometry_yaw_error = 0;
+  double saturated = 0;
+  double start_jump = 0;
+};
+
+int main(int argc, char **argv) {
+  FILE *file = stdout;
+  if (argc > 1) {
+    file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  // The same robot, in the simulation
+  RecordingSimulator simulator;
+  simulator.chassis.track_width = TRACK_WIDTH;
+  for (int port : {PORT1, PORT2, PORT3}) {
+    simulator.add_drive_motor(port, driveside::side_left,
+                              reversed::yes_reverse, SimMotor(cartridge::blue));
+  }
+  for (int port : {PORT4, PORT5, PORT6}) {
+    simulator.add_drive_motor(port, driveside::side_right,
+                              reversed::no_reverse, SimMotor(cartridge::blue));
+  }
+  simulator.add_inertial(PORT7, SimInertial(0.02, 0.001, 0.995));
+  simulator.add_tracking_wheel(
+      PORT8, SimTrackingWheel(0, FORWARD_TRACKER_DISTANCE, false));
+  simulator.add_tracking_wheel(
+      PORT9, SimTrackingWheel(SIDEWAYS_TRACKER_DISTANCE, 0, true));
+  simulator.attach();
+
+  pursuit_parameters.track_width = TRACK_WIDTH;
+  pursuit_parameters.turning_radius = 0.3;
+
+  std::vector<Move> moves = {
+      {"drive_forward", TwoDPose(0.6, 0, 0),
+       [] { robot_drivetrain.drive_forward(0.6, 5); }},
+      {"turn_to", TwoDPose(0.6, 0, M_PI_2),
+       [] { robot_drivetrain.turn_to(M_PI_2, 5); }},
+      {"drive_to_point", TwoDPose(0.6, 0.6, M_PI_2),
+       [] { robot_drivetrain.drive_to_point(0.6, 0.6, 5); }},
+      {"drive_to_pose", TwoDPose(0, 0.9, M_PI),
+       [] { robot_drivetrain.drive_to_pose(0, 0.9, M_PI, 5); }},
+      {"reverse_to_pose", TwoDPose(0.6, 0.6, -M_PI_2),
+       [] { robot_drivetrain.reverse_to_pose(0.6, 0.6, -M_PI_2, 5); }},
+      {"drive_through_path", TwoDPose(0, 0, M_PI),
+       [] {
+         robot_drivetrain.drive_through_path(
+             {{0.3, 0.2, M_PI}, {0, 0, M_PI}}, 8);
+       }},
+      {"chained_drive", TwoDPose(-0.6, 0, M_PI),
+       [] {
+         // Gentle slews, so that a step at a hand-off would show above them
+         pursuit_parameters.max_forward_voltage_change = 40;
+         pursuit_parameters.max_turn_voltage_change = 60;
+         robot_drivetrain.chain(0.1);
+         robot_drivetrain.drive_to_point(-0.6, 0, 5);
+       },
+       true},
+      {"chained_turn", TwoDPose(-0.6, 0, -M_PI_2),
+       [] {
+         robot_drivetrain.chain(0.3);
+         robot_drivetrain.turn_to(-M_PI_2, 5);
+       },
+       true},
+      {"after_chain", TwoDPose(-0.6, -0.6, -M_PI_2),
+       [] { robot_drivetrain.drive_to_point(-0.6, -0.6, 5); }}};
+
+  auto real_start = std::chrono::steady_clock::now();
+  manager.start();
+  robot_drivetrain.set_state(drivetrainState::mode_autonomous); // Calibrates
+  robot_drivetrain.set_pose(0, 0, 0);
+
+  bool jumped = false;
+
+  std::vector<Result> results;
+  for (size_t i = 0; i < moves.size(); i++) {
+    const Move &move = moves[i];
+    double start_time = simulator.get_time();
+    double before_left = simulator.left_volts;
+    double before_right = simulator.right_volts;
+    robot_drivetrain.reset_mixer_stats();
+    simulator.record_start = true;
+    move.start();
+    robot_drivetrain.wait_until_completed();
+
+    TwoDPose truth = simulator.get_pose();
+    TwoDPose odometry = odom_fusion.get_pose_2d();
+    Result result;
+    result.name = move.name;
+    result.time = simulator.get_time() - start_time;
+    result.target_error =
+        std::hypot(truth.x - move.target.x, truth.y - move.target.y);
+    result.odometry_error = std::hypot(odometry.x - truth.x,
+                                       odometry.y - truth.y);
+    result.odometry_yaw_error =
+        std::abs(normalize_angle(odometry.yaw - truth.yaw));
+    result.saturated =
+        robot_drivetrain.get_mixer_stats().saturated_fraction();
+    result.start_jump =
+        std::max(std::abs(simulator.start_left_volts - before_left),
+                 std::abs(simulator.start_right_volts - before_right));
+    // A move that continues from a chained move starts its controllers from
+    // the voltages of the sides, so its first step changes them by no more
+    // than the forward and turning slews allow in a step
+    double max_slew_rate = pursuit_parameters.max_forward_voltage_change +
+                           pursuit_parameters.max_turn_voltage_change;
+    if (i > 0 && moves[i - 1].chained &&
+        result.start_jump > max_slew_rate * simulator.start_dt) {
+      fprintf(stderr, "%s starts %.2f V from where %s left the sides\n",
+              move.name.c_str(), result.start_jump,
+              moves[i - 1].name.c_str());
+      jumped = true;
+    }
+    results.push_back(result);
+  }
+  double real_time = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - real_start)
+                         .count();
+
+  fprintf(file,
+          "{\n  \"schema\": 1,\n  \"simulated_time\": %.3f,\n"
+          "  \"real_time\": %.3f,\n  \"moves\": [",
+          simulator.get_time(), real_time);
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &result = results[i];
+    fprintf(file,
+            "%s\n    {\"move\": \"%s\", \"time\": %.3f, "
+            "\"target_error\": %.4f, \"odometry_error\": %.4f, "
+            "\"odometry_yaw_error\": %.4f, \"saturated\": %.3f, "
+            "\"start_jump\": %.3f}",
+            i == 0 ? "" : ",", result.name.c_str(), result.time,
+            result.target_error, result.odometry_error,
+            result.odometry_yaw_error, result.saturated, result.start_jump);
+    fprintf(stderr,
+            "%-20s %5.2f s, target error %5.1f mm, odometry error %5.1f mm "
+            "and %4.2f deg, %3.0f%% saturated, starts %4.2f V off\n",
+            result.name.c_str(), result.time, result.target_error * 1000,
+            result.odometry_error * 1000, to_deg(result.odometry_yaw_error),
+            result.saturated * 100, result.start_jump);
+  }
+  fprintf(file, "\n  ]\n}\n");
+  fprintf(stderr, "Simulated %.1f s in %.2f s\n", simulator.get_time(),
+          real_time);
+  if (file != stdout) {
+    fclose(file);
+  }
+  return jumped ? 1 : 0;
+}
@@ -0,0 +1,304 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       tracking.cpp                                              */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Drives Paths With a Simulated Drivetrain                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Drives a few paths with PurePursuitConductor and a simulated drivetrain,
+ * where each side is a motor that takes time to speed up:
+ *
+ *   acceleration = (voltage - ks * sign(velocity) - kv * velocity) / ka
+ *
+ * Each path is driven with pure pursuit and the PIDs alone, with pure pursuit
+ * and feedforward, with RAMSETE and with MPC. The feedforward constants are
+ * either the same as the simulation, or off by 10-20% (as characterized
+ * constants usually are). As JSON:
+ *
+ *   {
+ *     "schema": 3,
+ *     "runs": [
+ *       {"path": "straight", "controller": "pid", "completed": true,
+ *        "time": 1.84, "overshoot": 0.002, "final_error": 0.01,
+ *        "tracking_error": 0.004, "mean_tracking_error": 0.001,
+ *        "max_solve_time": 0}, ...
+ *     ]
+ *   }
+ *
+ * time is how long the conductor took to complete, in seconds. overshoot is
+ * how far the robot went past the end of the path, and tracking_error the
+ * farthest it got from the path, in meters. max_solve_time is the longest
+ * step of the MPC, in seconds. It is given all the time it needs here, so
+ * that the runs do not depend on the speed of the computer. Exits with 1 if
+ * an MPC run measured no solve time, as the clock is then too coarse to hold
+ * the MPC to its time budget.
+ *
+ * Usage: tracking [output.json]
+ * Without an output file, the JSON is printed.
+ */
+
+#include "whooplib/include/calculators/Feedforward.hpp"
+#include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace whoop;
+
+static const double DT = 0.01; // Seconds per step, as on the brain
+static const double MAX_TIME = 10;
+
+// The simulated motors. The sides differ a little, as on a real robot
+static const MotorFeedforward LEFT_MOTORS(0.5, 7.6, 1.8);
+static const MotorFeedforward RIGHT_MOTORS(0.6, 8.0, 2.0);
+static const double TRACK_WIDTH = 0.3;
+
+struct SimSide {
+  MotorFeedforward model;
+  double velocity = 0;
+
+  explicit SimSide(const MotorFeedforward &model) : model(model) {}
+
+  void step(double voltage) {
+    voltage = clamp(voltage, -12.0, 12.0);
+    // Static friction holds the side still below ks
+    if (velocity == 0 && std::abs(voltage) <= model.ks) {
+      return;
+    }
+    double direction = velocity != 0 ? velocity : voltage;
+    double friction = direction > 0 ? model.ks : -model.ks;
+    double next = velocity +
+                  (voltage - friction - model.kv * velocity) / model.ka * DT;
+    // Friction stops the side instead of reversing it
+    if (velocity != 0 && (next > 0) != (velocity > 0) &&
+        std::abs(voltage) <= model.ks) {
+      next = 0;
+    }
+    velocity = next;
+  }
+};
+
+struct Run {
+  std::string path;
+  std::string controller;
+  bool completed = false;
+  double time = 0;
+  double overshoot = 0;
+  double final_error = 0;
+  double tracking_error = 0;
+  double mean_tracking_error = 0;
+  double max_solve_time = 0;
+};
+
+/**
+ * @returns The distance from a point to the closest segment of the path
+ */
+static double distance_to_path(const std::vector<barebonesPose> &points,
+                               double x, double y) {
+  double closest = INFINITY;
+  for (size_t i = 0; i + 1 < points.size(); i++) {
+    double dx = points[i + 1].x - points[i].x;
+    double dy = points[i + 1].y - points[i].y;
+    double length_squared = dx * dx + dy * dy;
+    double t = 0;
+    if (length_squared > 0) {
+      t = clamp(((x - points[i].x) * dx + (y - points[i].y) * dy) /
+                    length_squared,
+                0.0, 1.0);
+    }
+    closest = std::min(closest, std::hypot(points[i].x + t * dx - x,
+                                           points[i].y + t * dy - y));
+  }
+  return closest;
+}
+
+/**
+ * Drives a path until the conductor completes, mixing the powers the same
+ * way as WhoopDrivetrain
+ */
+static Run drive(const std::string &path_name,
+                 const std::vector<TwoDPose> &waypoints,
+                 const std::string &controller, const PursuitParams &params) {
+  PursuitParams run_params = params;
+  PurePursuitConductor conductor(&run_params);
+  conductor.generate_path(waypoints, -1);
+  std::vector<barebonesPose> path = conductor.pursuit_path.pursuit_points;
+
+  SimSide left(LEFT_MOTORS), right(RIGHT_MOTORS);
+  TwoDPose pose = waypoints[0];
+  TwoDPose end = waypoints.back();
+
+  bool near_end = false;
+  Run run;
+  run.path = path_name;
+  run.controller = controller;
+  long steps = 1;
+  for (; steps * DT <= MAX_TIME; steps++) {
+    PursuitResult result = conductor.step(pose);
+    if (!result.is_valid) {
+      break;
+    }
+    run.max_solve_time = std::max(run.max_solve_time, result.solve_time);
+    if (result.is_completed) {
+      run.completed = true;
+      run.time = steps * DT;
+      break;
+    }
+
+    double forward = result.forward_power * result.direction;
+    double left_voltage, right_voltage;
+    if (result.has_side_powers) {
+      left_voltage = result.left_power;
+      right_voltage = result.right_power;
+    } else if (conductor.forward_pid.is_settled() ||
+               result.suggest_point_turn) {
+      left_voltage = forward - result.steering_power / 1.5;
+      right_voltage = forward + result.steering_power / 1.5;
+    } else if (result.direction < 0) {
+      left_voltage = forward + std::max(-result.steering_power, 0.0);
+      right_voltage = forward + std::max(result.steering_power, 0.0);
+    } else {
+      left_voltage = forward + std::min(-result.steering_power, 0.0);
+      right_voltage = forward + std::min(result.steering_power, 0.0);
+    }
+    left.step(left_voltage);
+    right.step(right_voltage);
+
+    // The forward axis of a pose is (cos yaw, sin yaw)
+    double speed = (left.velocity + right.velocity) / 2;
+    double turn_rate = (right.velocity - left.velocity) / TRACK_WIDTH;
+    double yaw = pose.yaw + turn_rate * DT / 2;
+    pose.x += speed * std::cos(yaw) * DT;
+    pose.y += speed * std::sin(yaw) * DT;
+    pose.yaw = normalize_angle(pose.yaw + turn_rate * DT);
+
+    // How far past the end, along the heading of the end, once the robot is
+    // close to it (a path can cross the end line before)
+    near_end = near_end || std::hypot(pose.x - end.x, pose.y - end.y) < 0.2;
+    if (near_end) {
+      double past = (pose.x - end.x) * std::cos(end.yaw) +
+                    (pose.y - end.y) * std::sin(end.yaw);
+      run.overshoot = std::max(run.overshoot, past);
+    }
+
+    double error = distance_to_path(path, pose.x, pose.y);
+    run.tracking_error = std::max(run.tracking_error, error);
+    run.mean_tracking_error += error;
+  }
+  run.final_error = std::hypot(pose.x - end.x, pose.y - end.y);
+  run.mean_tracking_error /= steps;
+  return run;
+}
+
+int main(int argc, char **argv) {
+  FILE *file = stdout;
+  if (argc > 1) {
+    file = fopen(argv[1], "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  std::vector<std::pair<std::string, std::vector<TwoDPose>>> paths = {
+      {"straight", {TwoDPose(0, 0, 0), TwoDPose(1.2, 0, 0)}},
+      {"turn", {TwoDPose(0, 0, 0), TwoDPose(0.8, 0.8, M_PI_2)}},
+      {"s_curve",
+       {TwoDPose(0, 0, 0), TwoDPose(0.7, 0.4, 0), TwoDPose(1.4, 0, 0)}},
+      {"long",
+       {TwoDPose(0, 0, 0), TwoDPose(1.5, 0.5, M_PI_2), TwoDPose(0.5, 1.5, M_PI),
+        TwoDPose(-0.8, 0.6, -M_PI_2)}}};
+
+  PursuitParams pid_params;
+  pid_params.track_width = TRACK_WIDTH;
+  // Turns wider than the track, so that both sides drive forward through
+  // them, and the acceleration the motors can reach at forward_max_voltage
+  pid_params.turning_radius = 0.3;
+  pid_params.max_acceleration = 3.5;
+  pid_params.max_deceleration = 3.5;
+
+  PursuitParams feedforward_params = pid_params;
+  feedforward_params.left_ks = LEFT_MOTORS.ks;
+  feedforward_params.left_kv = LEFT_MOTORS.kv;
+  feedforward_params.left_ka = LEFT_MOTORS.ka;
+  feedforward_params.right_ks = RIGHT_MOTORS.ks;
+  feedforward_params.right_kv = RIGHT_MOTORS.kv;
+  feedforward_params.right_ka = RIGHT_MOTORS.ka;
+
+  PursuitParams mismatched_params = feedforward_params;
+  mismatched_params.left_ks *= 0.8;
+  mismatched_params.left_kv *= 0.9;
+  mismatched_params.left_ka *= 1.2;
+  mismatched_params.right_ks *= 1.2;
+  mismatched_params.right_kv *= 1.1;
+  mismatched_params.right_ka *= 0.8;
+
+  PursuitParams ramsete_params = feedforward_params;
+  ramsete_params.path_follower = pathfollower::follower_ramsete;
+  PursuitParams ramsete_mismatched_params = mismatched_params;
+  ramsete_mismatched_params.path_follower = pathfollower::follower_ramsete;
+
+  PursuitParams mpc_params = feedforward_params;
+  mpc_params.path_follower = pathfollower::follower_mpc;
+  mpc_params.mpc.time_budget = 1;
+  PursuitParams mpc_mismatched_params = mismatched_params;
+  mpc_mismatched_params.path_follower = pathfollower::follower_mpc;
+  mpc_mismatched_params.mpc.time_budget = 1;
+
+  std::vector<Run> runs;
+  for (const auto &path : paths) {
+    runs.push_back(drive(path.first, path.second, "pid", pid_params));
+    runs.push_back(
+        drive(path.first, path.second, "feedforward", feedforward_params));
+    runs.push_back(drive(path.first, path.second, "feedforward_mismatched",
+                         mismatched_params));
+    runs.push_back(
+        drive(path.first, path.second, "ramsete", ramsete_params));
+    runs.push_back(drive(path.first, path.second, "ramsete_mismatched",
+                         ramsete_mismatched_params));
+    runs.push_back(drive(path.first, path.second, "mpc", mpc_params));
+    runs.push_back(drive(path.first, path.second, "mpc_mismatched",
+                         mpc_mismatched_params));
+  }
+
+  fprintf(file, "{\n  \"schema\": 3,\n  \"runs\": [");
+  for (size_t i = 0; i < runs.size(); i++) {
+    const Run &run = runs[i];
+    fprintf(file,
+            "%s\n    {\"path\": \"%s\", \"controller\": \"%s\", "
+            "\"completed\": %s, \"time\": %.3f, \"overshoot\": %.4f, "
+            "\"final_error\": %.4f, \"tracking_error\": %.4f, "
+            "\"mean_tracking_error\": %.4f, \"max_solve_time\": %.6f}",
+            i == 0 ? "" : ",", run.path.c_str(), run.controller.c_str(),
+            run.completed ? "true" : "false", run.time, run.overshoot,
+            run.final_error, run.tracking_error, run.mean_tracking_error,
+            run.max_solve_time);
+    fprintf(stderr,
+            "%-10s %-24s %s %6.2f s, overshoot %5.1f mm, final error "
+            "%5.1f mm, tracking error %5.1f mm (mean %4.1f mm)\n",
+            run.path.c_str(), run.controller.c_str(),
+            run.completed ? "completed in" : "gave up after",
+            run.completed ? run.time : MAX_TIME, run.overshoot * 1000,
+            run.final_error * 1000, run.tracking_error * 1000,
+            run.mean_tracking_error * 1000);
+  }
+  fprintf(file, "\n  ]\n}\n");
+  if (file != stdout) {
+    fclose(file);
+  }
+
+  for (const Run &run : runs) {
+    if (run.controller.compare(0, 3, "mpc") == 0 && run.max_solve_time <= 0) {
+      fprintf(stderr, "%s %s measured no solve time\n", run.path.c_str(),
+              run.controller.c_str());
+      return 1;
+    }
+  }
+  return 0;
+}
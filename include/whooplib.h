@@ -43,13 +43,32 @@
 #include "whooplib/include/toolbox.hpp"
 
 // Calculators
+#include "whooplib/include/calculators/AnalyticPath.hpp"
+#include "whooplib/include/calculators/ConstexprDubins.hpp"
+#include "whooplib/include/calculators/DriveMixer.hpp"
 #include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include "whooplib/include/calculators/Feedforward.hpp"
+#include "whooplib/include/calculators/HeadingOptimizer.hpp"
+#include "whooplib/include/calculators/HybridAStar.hpp"
+#include "whooplib/include/calculators/ModelPredictive.hpp"
+#include "whooplib/include/calculators/OccupancyGrid.hpp"
+#include "whooplib/include/calculators/PathFile.hpp"
+#include "whooplib/include/calculators/PathFollower.hpp"
+#include "whooplib/include/calculators/PoseEKF.hpp"
+#include "whooplib/include/calculators/PoseHistory.hpp"
 #include "whooplib/include/calculators/PurePursuit.hpp"
 #include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/calculators/Ramsete.hpp"
+#include "whooplib/include/calculators/ReedsShepp.hpp"
 #include "whooplib/include/calculators/RollingAverage.hpp"
 #include "whooplib/include/calculators/SlewRateLimiter.hpp"
+#include "whooplib/include/calculators/Trajectory.hpp"
+#include "whooplib/include/calculators/Transform2D.hpp"
 #include "whooplib/include/calculators/TwoDPose.hpp"
+#include "whooplib/include/calculators/VelocityProfile.hpp"
 #include "whooplib/include/calculators/Units.hpp"
+#include "whooplib/include/calculators/VoltageTable.hpp"
 #include "whooplib/include/calculators/WheelOdom.hpp"
 
 // Nodes
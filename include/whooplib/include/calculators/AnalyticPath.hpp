@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       AnalyticPath.hpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Arc-Length Parameterized Line and Arc Path                */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef ANALYTIC_PATH_HPP
+#define ANALYTIC_PATH_HPP
+
+#include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/calculators/ReedsShepp.hpp"
+#include <vector>
+
+namespace whoop {
+
+/**
+ * A single line, circular arc, or clothoid (curvature changing linearly with
+ * arc length) of a path. Yaw is ccw-positive with zero along
+ * the +x axis, the same convention the Dubins solver uses. Yaw and curvature
+ * are in the direction of travel, so a reversing primitive has a yaw opposite
+ * of the robot's heading.
+ */
+struct PathPrimitive {
+  double x;         // Start x, in meters
+  double y;         // Start y, in meters
+  double yaw;       // Start yaw, in radians
+  double curvature; // Signed start curvature (1/radius). 0 is a line, + left
+  double length;    // Arc length of the primitive, in meters
+  double s_start;   // Arc length of the path at the start of this primitive
+  int direction;    // 1 if the robot drives forward, -1 if in reverse
+  double sharpness; // Change in curvature per meter. Non-zero for clothoids
+
+  constexpr PathPrimitive(double x = 0, double y = 0, double yaw = 0,
+                          double curvature = 0, double length = 0,
+                          double s_start = 0, int direction = 1,
+                          double sharpness = 0)
+      : x(x), y(y), yaw(yaw), curvature(curvature), length(length),
+        s_start(s_start), direction(direction), sharpness(sharpness) {}
+
+  /**
+   * Samples the primitive
+   * @param t The arc length from the start of this primitive, in meters
+   * @param q The configuration result (x, y, yaw)
+   */
+  void sample(double t, double q[3]) const;
+
+  /**
+   * @param t The arc length from the start of this primitive, in meters
+   * @returns The yaw of travel at t, in radians
+   */
+  double yaw_at(double t) const;
+
+  /**
+   * @param t The arc length from the start of this primitive, in meters
+   * @returns The signed curvature at t
+   */
+  double curvature_at(double t) const;
+};
+
+/**
+ * Result of a query against an AnalyticPath
+ */
+struct PathQuery {
+  bool found;
+  double s;        // Arc length along the path of the result, in meters
+  double x;        // x of the result, in meters
+  double y;        // y of the result, in meters
+  double distance; // Euclidean distance from the queried point, in meters
+
+  PathQuery(bool found = false, double s = 0, double x = 0, double y = 0,
+            double distance = 0)
+      : found(found), s(s), x(x), y(y), distance(distance) {}
+};
+
+/**
+ * A path that is stored as its line and arc primitives instead of as sampled
+ * points. Queries are solved in closed form per primitive, so memory is
+ * O(primitives) and the result does not depend on a sampling resolution.
+ */
+class AnalyticPath {
+public:
+  std::vector<PathPrimitive> primitives;
+
+  /**
+   * Removes all primitives from the path
+   */
+  void clear();
+
+  /**
+   * Appends the three segments of a Dubins path to the end of this path
+   * @param path An initialized Dubins path
+   */
+  void append_dubins(DubinsPath *path);
+
+  /**
+   * Appends the segments of a Reeds-Shepp path to the end of this path
+   * @param path An initialized Reeds-Shepp path
+   */
+  void append_reeds_shepp(ReedsSheppPath *path);
+
+  /**
+   * Appends a straight line to the end of this path
+   * @param x0 Start x, in meters
+   * @param y0 Start y, in meters
+   * @param x1 End x, in meters
+   * @param y1 End y, in meters
+   * @param direction 1 if the robot drives forward, -1 if in reverse
+   */
+  void append_line(double x0, double y0, double x1, double y1,
+                   int direction = 1);
+
+  /**
+   * Makes the path curvature-continuous by replacing each jump in curvature
+   * with a clothoid, centered on the junction. The curvature never exceeds
+   * that of the original path, and the heading change and total arc length
+   * are kept. Cusps are not smoothed since the robot stops there anyway.
+   * @param transition_length The length of each clothoid, in meters. Clamped
+   * to half of the length of the primitives on either side
+   */
+  void smooth(double transition_length);
+
+  /**
+   * @returns The total arc length of the path, in meters
+   */
+  double length() const;
+
+  /**
+   * Samples the path at a given arc length. The arc length is clamped to the
+   * bounds of the path.
+   * @param s Arc length along the path, in meters
+   * @param q The configuration result (x, y, yaw)
+   * @returns non-zero if the path is empty
+   */
+  int sample(double s, double q[3]) const;
+
+  /**
+   * @param s Arc length along the path, in meters
+   * @returns The signed curvature of the path at the given arc length
+   */
+  double curvature_at(double s) const;
+
+  /**
+   * Finds the point of the path closest to (x, y), only considering the
+   * portion of the path between s_min and s_max
+   * @param x The x position to query, in meters
+   * @param y The y position to query, in meters
+   * @param s_min The minimum arc length to consider, in meters
+   * @param s_max The maximum arc length to consider, in meters
+   */
+  PathQuery closest_point(double x, double y, double s_min,
+                          double s_max) const;
+
+  /**
+   * Finds the furthest point along the path, between s_min and s_max, that is
+   * within the radius of (x, y). This is the pure pursuit look-ahead point
+   * solved as a circle intersection rather than a search over samples.
+   * @param x The x position to query, in meters
+   * @param y The y position to query, in meters
+   * @param radius The look-ahead radius, in meters
+   * @param s_min The minimum arc length to consider, in meters
+   * @param s_max The maximum arc length to consider, in meters
+   */
+  PathQuery lookahead_point(double x, double y, double radius, double s_min,
+                            double s_max) const;
+
+private:
+  // Returns the primitive containing arc length s, or nullptr if empty
+  const PathPrimitive *primitive_at(double s) const;
+};
+
+} // namespace whoop
+
+#endif // ANALYTIC_PATH_HPP
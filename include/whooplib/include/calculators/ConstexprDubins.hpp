@@ -0,0 +1,399 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       ConstexprDubins.hpp                                       */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Compile-Time Dubins Paths for Fixed Autonomous Routines   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * A constexpr version of the Dubins solver and sampler in Dubins.hpp, so that
+ * paths between constant waypoints can be generated by the compiler and
+ * stored in flash:
+ *
+ *   static constexpr double route[][3] = {{0, 0, 0}, {0.4, 0.4, M_PI_2}};
+ *   static constexpr auto baked = bake_dubins_path(route, 0.127, 0.127);
+ *   robot_drivetrain.drive_through_baked_path(baked);
+ *
+ * The standard <cmath> functions are not constexpr, so this file comes with
+ * its own trigonometry. It is accurate to within a few ULP, which is the
+ * same geometry the runtime solver produces.
+ */
+#ifndef CONSTEXPR_DUBINS_HPP
+#define CONSTEXPR_DUBINS_HPP
+
+#include "whooplib/include/calculators/AnalyticPath.hpp"
+#include "whooplib/include/calculators/Dubins.hpp"
+#include <cstddef>
+
+namespace whoop {
+
+////////////////////////////////////////////////////////////////////////////////
+// Constexpr math
+
+constexpr double CONSTEXPR_PI = 3.14159265358979323846;
+
+constexpr double constexpr_abs(double x) { return x < 0 ? -x : x; }
+
+constexpr double constexpr_floor(double x) {
+  long long truncated = static_cast<long long>(x);
+  double result = static_cast<double>(truncated);
+  return (result > x) ? result - 1 : result;
+}
+
+/**
+ * Wraps an angle into [0, 2pi), the same as mod2pi in Dubins.cpp
+ */
+constexpr double constexpr_mod2pi(double theta) {
+  return theta - 2 * CONSTEXPR_PI * constexpr_floor(theta / (2 * CONSTEXPR_PI));
+}
+
+constexpr double constexpr_sqrt(double x) {
+  if (x <= 0) {
+    return 0;
+  }
+  // Newton's method, which converges quadratically from above
+  double guess = x > 1 ? x : 1;
+  for (int i = 0; i < 100; i++) {
+    double next = 0.5 * (guess + x / guess);
+    if (next >= guess) {
+      break;
+    }
+    guess = next;
+  }
+  return guess;
+}
+
+constexpr double constexpr_sin(double x) {
+  // Reduce into [-pi/2, pi/2], where the Taylor series converges quickly
+  x = constexpr_mod2pi(x + CONSTEXPR_PI) - CONSTEXPR_PI;
+  if (x > CONSTEXPR_PI / 2) {
+    x = CONSTEXPR_PI - x;
+  } else if (x < -CONSTEXPR_PI / 2) {
+    x = -CONSTEXPR_PI - x;
+  }
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 15; n++) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double constexpr_cos(double x) {
+  return constexpr_sin(x + CONSTEXPR_PI / 2);
+}
+
+constexpr double constexpr_atan(double x) {
+  if (x < 0) {
+    return -constexpr_atan(-x);
+  }
+  if (x > 1) {
+    return CONSTEXPR_PI / 2 - constexpr_atan(1 / x);
+  }
+  // Halve the angle twice so the series only needs a handful of terms
+  x = x / (1 + constexpr_sqrt(1 + x * x));
+  x = x / (1 + constexpr_sqrt(1 + x * x));
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 20; n++) {
+    term *= -x * x;
+    sum += term / (2 * n + 1);
+  }
+  return 4 * sum;
+}
+
+constexpr double constexpr_atan2(double y, double x) {
+  if (x > 0) {
+    return constexpr_atan(y / x);
+  }
+  if (x < 0) {
+    return y >= 0 ? constexpr_atan(y / x) + CONSTEXPR_PI
+                  : constexpr_atan(y / x) - CONSTEXPR_PI;
+  }
+  if (y > 0) {
+    return CONSTEXPR_PI / 2;
+  }
+  if (y < 0) {
+    return -CONSTEXPR_PI / 2;
+  }
+  return 0;
+}
+
+constexpr double constexpr_acos(double x) {
+  return constexpr_atan2(constexpr_sqrt(1 - x * x), x);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Constexpr Dubins solver
+
+/**
+ * Generate the shortest path between two configurations at compile time.
+ * Matches dubins_shortest_path in Dubins.hpp
+ *
+ * @param path  - the resultant path
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle
+ * @return      - non-zero on error
+ */
+constexpr int constexpr_dubins_shortest_path(DubinsPath &path,
+                                             const double (&q0)[3],
+                                             const double (&q1)[3],
+                                             double rho) {
+  if (rho <= 0.0) {
+    return EDUBBADRHO;
+  }
+
+  double dx = q1[0] - q0[0];
+  double dy = q1[1] - q0[1];
+  double d = constexpr_sqrt(dx * dx + dy * dy) / rho;
+  double theta = d > 0 ? constexpr_mod2pi(constexpr_atan2(dy, dx)) : 0;
+  double alpha = constexpr_mod2pi(q0[2] - theta);
+  double beta = constexpr_mod2pi(q1[2] - theta);
+  double sa = constexpr_sin(alpha);
+  double sb = constexpr_sin(beta);
+  double ca = constexpr_cos(alpha);
+  double cb = constexpr_cos(beta);
+  double c_ab = constexpr_cos(alpha - beta);
+  double d_sq = d * d;
+
+  double best_cost = -1;
+  for (int word = 0; word < 6; word++) {
+    double out[3] = {0, 0, 0};
+    bool found = false;
+
+    if (word == LSL || word == RSR) {
+      double sign = word == LSL ? 1 : -1;
+      double p_sq = 2 + d_sq - (2 * c_ab) + (2 * d * sign * (sa - sb));
+      if (constexpr_abs(p_sq) < 10e-13) { // A single arc, see dubins_LSL
+        out[0] = constexpr_mod2pi(sign * (beta - alpha));
+        found = true;
+      } else if (p_sq >= 0) {
+        double tmp1 = constexpr_atan2(sign * (cb - ca), d + sign * (sa - sb));
+        out[0] = constexpr_mod2pi(sign * (tmp1 - alpha));
+        out[1] = constexpr_sqrt(p_sq);
+        out[2] = constexpr_mod2pi(sign * (beta - tmp1));
+        found = true;
+      }
+    } else if (word == LSR) {
+      double p_sq = -2 + d_sq + (2 * c_ab) + (2 * d * (sa + sb));
+      if (p_sq >= 0) {
+        double p = constexpr_sqrt(p_sq);
+        double tmp0 = constexpr_atan2(-ca - cb, d + sa + sb) -
+                      constexpr_atan2(-2.0, p);
+        out[0] = constexpr_mod2pi(tmp0 - alpha);
+        out[1] = p;
+        out[2] = constexpr_mod2pi(tmp0 - beta);
+        found = true;
+      }
+    } else if (word == RSL) {
+      double p_sq = -2 + d_sq + (2 * c_ab) - (2 * d * (sa + sb));
+      if (p_sq >= 0) {
+        double p = constexpr_sqrt(p_sq);
+        double tmp0 = constexpr_atan2(ca + cb, d - sa - sb) -
+                      constexpr_atan2(2.0, p);
+        out[0] = constexpr_mod2pi(alpha - tmp0);
+        out[1] = p;
+        out[2] = constexpr_mod2pi(beta - tmp0);
+        found = true;
+      }
+    } else if (word == RLR) {
+      double tmp0 = (6. - d_sq + 2 * c_ab + 2 * d * (sa - sb)) / 8.;
+      double phi = constexpr_atan2(ca - cb, d - sa + sb);
+      if (constexpr_abs(tmp0) <= 1) {
+        double p = constexpr_mod2pi((2 * CONSTEXPR_PI) - constexpr_acos(tmp0));
+        double t = constexpr_mod2pi(alpha - phi + constexpr_mod2pi(p / 2.));
+        out[0] = t;
+        out[1] = p;
+        out[2] = constexpr_mod2pi(alpha - beta - t + constexpr_mod2pi(p));
+        found = true;
+      }
+    } else { // LRL
+      double tmp0 = (6. - d_sq + 2 * c_ab + 2 * d * (sb - sa)) / 8.;
+      double phi = constexpr_atan2(ca - cb, d + sa - sb);
+      if (constexpr_abs(tmp0) <= 1) {
+        double p = constexpr_mod2pi(2 * CONSTEXPR_PI - constexpr_acos(tmp0));
+        double t = constexpr_mod2pi(-alpha - phi + p / 2.);
+        out[0] = t;
+        out[1] = p;
+        out[2] = constexpr_mod2pi(beta - alpha - t + constexpr_mod2pi(p));
+        found = true;
+      }
+    }
+
+    double cost = out[0] + out[1] + out[2];
+    if (found && (best_cost < 0 || cost < best_cost)) {
+      best_cost = cost;
+      path.qi[0] = q0[0];
+      path.qi[1] = q0[1];
+      path.qi[2] = q0[2];
+      path.param[0] = out[0];
+      path.param[1] = out[1];
+      path.param[2] = out[2];
+      path.rho = rho;
+      path.type = static_cast<DubinsPathType>(word);
+    }
+  }
+  return best_cost < 0 ? EDUBNOPATH : EDUBOK;
+}
+
+/**
+ * @returns The length of a path, the same as dubins_path_length
+ */
+constexpr double constexpr_dubins_path_length(const DubinsPath &path) {
+  return (path.param[0] + path.param[1] + path.param[2]) * path.rho;
+}
+
+/**
+ * @returns The turn of a segment of a Dubins path: 1 for left, 0 for
+ * straight, -1 for right
+ */
+constexpr int constexpr_dubins_segment_turn(DubinsPathType type, int i) {
+  // Rows follow the DubinsPathType order: LSL, LSR, RSL, RSR, RLR, LRL
+  constexpr int turns[6][3] = {{1, 0, 1},  {1, 0, -1},  {-1, 0, 1},
+                               {-1, 0, -1}, {-1, 1, -1}, {1, -1, 1}};
+  return turns[type][i];
+}
+
+/**
+ * Moves a configuration along a line or arc
+ * @param q The configuration, which is updated in place
+ * @param curvature The signed curvature (1/radius), 0 for a line
+ * @param length The arc length to move, in meters
+ */
+constexpr void constexpr_advance(double (&q)[3], double curvature,
+                                 double length) {
+  if (curvature == 0) {
+    q[0] += length * constexpr_cos(q[2]);
+    q[1] += length * constexpr_sin(q[2]);
+    return;
+  }
+  double yaw = q[2] + curvature * length;
+  q[0] += (constexpr_sin(yaw) - constexpr_sin(q[2])) / curvature;
+  q[1] -= (constexpr_cos(yaw) - constexpr_cos(q[2])) / curvature;
+  q[2] = yaw;
+}
+
+/**
+ * Calculate the configuration along the path at compile time. Matches
+ * dubins_path_sample in Dubins.hpp
+ *
+ * @param path - an initialised path
+ * @param t    - a length measure, where 0 <= t <= dubins_path_length
+ * @param q    - the configuration result
+ * @returns    - non-zero if 't' is not in the correct range
+ */
+constexpr int constexpr_dubins_path_sample(const DubinsPath &path, double t,
+                                           double (&q)[3]) {
+  if (t < 0 || t > constexpr_dubins_path_length(path)) {
+    return EDUBPARAM;
+  }
+  q[0] = path.qi[0];
+  q[1] = path.qi[1];
+  q[2] = path.qi[2];
+  for (int i = 0; i < 3 && t > 0; i++) {
+    double segment = path.param[i] * path.rho;
+    double step = t < segment ? t : segment;
+    constexpr_advance(q, constexpr_dubins_segment_turn(path.type, i) / path.rho,
+                      step);
+    t -= step;
+  }
+  q[2] = constexpr_mod2pi(q[2]);
+  return EDUBOK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Baked paths
+
+/**
+ * A pure pursuit path generated at compile time, in the same form as the
+ * analytic representation of PurePursuitPath (line and arc primitives)
+ * @tparam W The number of waypoints the path was generated from
+ */
+template <size_t W> struct BakedDubinsPath {
+  static constexpr size_t MAX_PRIMITIVES = 3 * (W - 1) + 1;
+  static constexpr size_t MAX_CHECKPOINTS = 2 * (W - 1) + 1;
+
+  PathPrimitive primitives[MAX_PRIMITIVES];
+  size_t num_primitives = 0;
+  double checkpoints[MAX_CHECKPOINTS] = {}; // Arc length of each checkpoint
+  size_t num_checkpoints = 0;
+  double length = 0; // Total arc length, in meters
+  bool valid = false;
+};
+
+/**
+ * Generates a path through constant waypoints at compile time. The result
+ * is the same as PurePursuitPath with pathrepresentation::path_analytic
+ * @param waypoints The waypoints as {x, y, yaw}, in meters and radians
+ * (counter-clockwise, zero along +x). The first is where the robot starts
+ * @param turning_radius Turning radius of the dubin curve, in meters
+ * @param landing_strip The length of the straight line into the last
+ * waypoint, in meters. Use the lookahead distance for the usual behavior
+ */
+template <size_t W>
+constexpr BakedDubinsPath<W>
+bake_dubins_path(const double (&waypoints)[W][3], double turning_radius,
+                 double landing_strip) {
+  static_assert(W >= 2, "A path requires at least 2 waypoints");
+  BakedDubinsPath<W> baked;
+
+  // The end is driven into from behind, along the landing strip
+  const double *end = waypoints[W - 1];
+  double strip_start[3] = {end[0] - landing_strip * constexpr_cos(end[2]),
+                           end[1] - landing_strip * constexpr_sin(end[2]),
+                           end[2]};
+
+  for (size_t i = 0; i + 1 < W; i++) {
+    double q0[3] = {waypoints[i][0], waypoints[i][1], waypoints[i][2]};
+    double q1[3] = {waypoints[i + 1][0], waypoints[i + 1][1],
+                    waypoints[i + 1][2]};
+    if (i + 2 == W) {
+      q1[0] = strip_start[0];
+      q1[1] = strip_start[1];
+    }
+
+    DubinsPath path = {};
+    if (constexpr_dubins_shortest_path(path, q0, q1, turning_radius) !=
+        EDUBOK) {
+      return baked; // Left invalid
+    }
+
+    double q[3] = {q0[0], q0[1], q0[2]};
+    for (int j = 0; j < 3; j++) {
+      double segment_length = path.param[j] * turning_radius;
+      if (segment_length <= 0) {
+        continue; // Degenerate segment, nothing to store
+      }
+      double curvature =
+          constexpr_dubins_segment_turn(path.type, j) / turning_radius;
+      baked.primitives[baked.num_primitives++] = PathPrimitive(
+          q[0], q[1], q[2], curvature, segment_length, baked.length);
+      baked.length += segment_length;
+      constexpr_advance(q, curvature, segment_length);
+    }
+
+    // A checkpoint at the halfway mark and at the end of the sub-section
+    double sub_length = constexpr_dubins_path_length(path);
+    baked.checkpoints[baked.num_checkpoints++] = baked.length - sub_length / 2;
+    baked.checkpoints[baked.num_checkpoints++] = baked.length;
+  }
+
+  if (landing_strip > 0) {
+    baked.primitives[baked.num_primitives++] =
+        PathPrimitive(strip_start[0], strip_start[1], end[2], 0, landing_strip,
+                      baked.length);
+    baked.length += landing_strip;
+    baked.checkpoints[baked.num_checkpoints++] = baked.length;
+  }
+
+  baked.valid = true;
+  return baked;
+}
+
+} // namespace whoop
+
+#endif // CONSTEXPR_DUBINS_HPP
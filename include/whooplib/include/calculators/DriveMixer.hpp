@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       DriveMixer.hpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Mixes Side Voltages for the Battery and the Motor Limit   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef DRIVE_MIXER_HPP
+#define DRIVE_MIXER_HPP
+
+namespace whoop {
+
+/**
+ * The voltages to spin each side of the drivetrain at
+ */
+struct MixedOutput {
+  double left_voltage = 0;
+  double right_voltage = 0;
+  bool saturated = false; // Both sides were scaled down to fit the limit
+  double scale = 1;       // What both sides were scaled by (1 if not)
+};
+
+/**
+ * How often the mixer had to scale the sides down, since it was last reset
+ */
+struct MixerStats {
+  unsigned long steps = 0;           // Outputs mixed
+  unsigned long saturated_steps = 0; // Outputs scaled down to fit the limit
+  double peak_voltage = 0;           // The largest side voltage asked for
+  double min_scale = 1;              // The most the sides were scaled by
+  double battery_voltage = 0;        // The filtered battery voltage
+
+  /**
+   * @returns The fraction of the outputs that were scaled down (0 to 1)
+   */
+  double saturated_fraction() const;
+};
+
+/**
+ * Turns the voltages that the controllers ask of each side into the voltages
+ * to command the motors with.
+ *
+ * The motors run at a fraction of the battery: commanding max_voltage is all
+ * of it. So that a voltage drives the robot the same way on a full battery as
+ * on a tired one, the voltages are scaled by nominal_voltage over the battery
+ * voltage. Then, if either side is over max_voltage, both sides are scaled
+ * down by the same factor, so the ratio between them (the curvature the robot
+ * drives) is kept, instead of clipping the faster side and turning less.
+ */
+class DriveMixer {
+public:
+  double nominal_voltage = 12.0; // The battery voltage a voltage is meant at
+  double max_voltage = 12.0;     // The voltage commanding all of the battery
+  double battery_time_constant = 0.5; // Seconds that battery readings settle
+  bool battery_compensation = true;   // Set to false to not scale by battery
+
+  /**
+   * @param nominal_voltage The battery voltage that the voltages of the
+   * controllers are meant at
+   * @param max_voltage The voltage that commands all of the battery
+   */
+  DriveMixer(double nominal_voltage = 12.0, double max_voltage = 12.0);
+
+  /**
+   * Updates the battery voltage, through a low-pass filter as the readings sag
+   * under load. Readings under 1 volt (no battery reading) are ignored
+   * @param volts The measured battery voltage
+   * @param dt Seconds since the last reading
+   */
+  void set_battery_voltage(double volts, double dt);
+
+  /**
+   * @returns The filtered battery voltage (nominal_voltage until one is read)
+   */
+  double get_battery_voltage() const;
+
+  /**
+   * Mixes the voltages of each side
+   * @param left_voltage The voltage asked of the left side
+   * @param right_voltage The voltage asked of the right side
+   * @returns The voltages to command the motors with
+   */
+  MixedOutput mix(double left_voltage, double right_voltage);
+
+  /**
+   * Mixes a forward and a turning voltage, the turn being counter-clockwise
+   * (the right side faster)
+   * @param forward_voltage The voltage asked of both sides
+   * @param turn_voltage The voltage added to the right side and taken from
+   * the left
+   * @returns The voltages to command the motors with
+   */
+  MixedOutput mix_arcade(double forward_voltage, double turn_voltage);
+
+  /**
+   * @returns How often the sides were scaled down, since the last reset
+   */
+  MixerStats get_stats() const;
+
+  /**
+   * Clears the saturation statistics
+   */
+  void reset_stats();
+
+private:
+  double battery_voltage = 0; // 0 until the battery is read
+  MixerStats stats;
+};
+
+} // namespace whoop
+
+#endif // DRIVE_MIXER_HPP
@@ -36,16 +36,30 @@ typedef enum {
   LRL = 5
 } DubinsPathType;
 
-typedef struct {
+/**
+ * A Dubins path, in the precision of Scalar (float or double). "DubinsPath"
+ * is the double precision path used by the rest of the library. The routines
+ * below are compiled for both precisions in Dubins.cpp
+ */
+template <typename Scalar> struct DubinsPathT {
   /* the initial configuration */
-  double qi[3];
+  Scalar qi[3];
   /* the lengths of the three segments */
-  double param[3];
+  Scalar param[3];
   /* model forward velocity / model angular velocity */
-  double rho;
+  Scalar rho;
   /* the path type described */
   DubinsPathType type;
-} DubinsPath;
+};
+
+typedef DubinsPathT<double> DubinsPath;
+typedef DubinsPathT<float> DubinsPathf;
+
+/* Keeps the arguments after the path from changing the deduced precision, so
+ * that literals like 0.127 can be passed to a float path */
+template <typename Scalar> struct DubinsScalar {
+  typedef Scalar type;
+};
 
 #define EDUBOK (0)        /* No error */
 #define EDUBCOCONFIGS (1) /* Colocated configurations */
@@ -63,8 +77,11 @@ typedef struct {
  * @note the user_data parameter is forwarded from the caller
  * @note return non-zero to denote sampling should be stopped
  */
-typedef int (*DubinsPathSamplingCallback)(double q[3], double t,
-                                          void *user_data);
+template <typename Scalar>
+using DubinsPathSamplingCallbackT = int (*)(Scalar q[3], Scalar t,
+                                            void *user_data);
+
+typedef DubinsPathSamplingCallbackT<double> DubinsPathSamplingCallback;
 
 /**
  * Generate a path from an initial configuration to
@@ -81,8 +98,11 @@ typedef int (*DubinsPathSamplingCallback)(double q[3], double t,
  * maximum angular velocity)
  * @return      - non-zero on error
  */
-int dubins_shortest_path(DubinsPath *path, double q0[3], double q1[3],
-                         double rho);
+template <typename Scalar>
+int dubins_shortest_path(DubinsPathT<Scalar> *path,
+                         typename DubinsScalar<Scalar>::type q0[3],
+                         typename DubinsScalar<Scalar>::type q1[3],
+                         typename DubinsScalar<Scalar>::type rho);
 
 /**
  * Generate a path with a specified word from an initial configuration to
@@ -96,7 +116,11 @@ int dubins_shortest_path(DubinsPath *path, double q0[3], double q1[3],
  * @param pathType - the specific path type to use
  * @return         - non-zero on error
  */
-int dubins_path(DubinsPath *path, double q0[3], double q1[3], double rho,
+template <typename Scalar>
+int dubins_path(DubinsPathT<Scalar> *path,
+                typename DubinsScalar<Scalar>::type q0[3],
+                typename DubinsScalar<Scalar>::type q1[3],
+                typename DubinsScalar<Scalar>::type rho,
                 DubinsPathType pathType);
 
 /**
@@ -104,7 +128,8 @@ int dubins_path(DubinsPath *path, double q0[3], double q1[3], double rho,
  *
  * @param path - the path to find the length of
  */
-double dubins_path_length(DubinsPath *path);
+template <typename Scalar>
+Scalar dubins_path_length(DubinsPathT<Scalar> *path);
 
 /**
  * Return the length of a specific segment in an initialized path
@@ -112,7 +137,8 @@ double dubins_path_length(DubinsPath *path);
  * @param path - the path to find the length of
  * @param i    - the segment you to get the length of (0-2)
  */
-double dubins_segment_length(DubinsPath *path, int i);
+template <typename Scalar>
+Scalar dubins_segment_length(DubinsPathT<Scalar> *path, int i);
 
 /**
  * Return the normalized length of a specific segment in an initialized path
@@ -120,7 +146,8 @@ double dubins_segment_length(DubinsPath *path, int i);
  * @param path - the path to find the length of
  * @param i    - the segment you to get the length of (0-2)
  */
-double dubins_segment_length_normalized(DubinsPath *path, int i);
+template <typename Scalar>
+Scalar dubins_segment_length_normalized(DubinsPathT<Scalar> *path, int i);
 
 /**
  * Extract an integer that represents which path type was used
@@ -128,7 +155,8 @@ double dubins_segment_length_normalized(DubinsPath *path, int i);
  * @param path    - an initialised path
  * @return        - one of LSL, LSR, RSL, RSR, RLR or LRL
  */
-DubinsPathType dubins_path_type(DubinsPath *path);
+template <typename Scalar>
+DubinsPathType dubins_path_type(DubinsPathT<Scalar> *path);
 
 /**
  * Calculate the configuration along the path, using the parameter t
@@ -138,7 +166,10 @@ DubinsPathType dubins_path_type(DubinsPath *path);
  * @param q    - the configuration result
  * @returns    - non-zero if 't' is not in the correct range
  */
-int dubins_path_sample(DubinsPath *path, double t, double q[3]);
+template <typename Scalar>
+int dubins_path_sample(DubinsPathT<Scalar> *path,
+                       typename DubinsScalar<Scalar>::type t,
+                       typename DubinsScalar<Scalar>::type q[3]);
 
 /**
  * Walk along the path at a fixed sampling interval, calling the
@@ -154,8 +185,11 @@ int dubins_path_sample(DubinsPath *path, double t, double q[3]);
  *
  * @returns - zero on successful completion, or the result of the callback
  */
-int dubins_path_sample_many(DubinsPath *path, double stepSize,
-                            DubinsPathSamplingCallback cb, void *user_data);
+template <typename Scalar>
+int dubins_path_sample_many(
+    DubinsPathT<Scalar> *path, typename DubinsScalar<Scalar>::type stepSize,
+    DubinsPathSamplingCallbackT<typename DubinsScalar<Scalar>::type> cb,
+    void *user_data);
 
 /**
  * Convenience function to identify the endpoint of a path
@@ -163,7 +197,9 @@ int dubins_path_sample_many(DubinsPath *path, double stepSize,
  * @param path - an initialised path
  * @param q    - the configuration result
  */
-int dubins_path_endpoint(DubinsPath *path, double q[3]);
+template <typename Scalar>
+int dubins_path_endpoint(DubinsPathT<Scalar> *path,
+                         typename DubinsScalar<Scalar>::type q[3]);
 
 /**
  * Convenience function to extract a subset of a path
@@ -172,7 +208,10 @@ int dubins_path_endpoint(DubinsPath *path, double q[3]);
  * @param t       - a length measure, where 0 < t < dubins_path_length(path)
  * @param newpath - the resultant path
  */
-int dubins_extract_subpath(DubinsPath *path, double t, DubinsPath *newpath);
+template <typename Scalar>
+int dubins_extract_subpath(DubinsPathT<Scalar> *path,
+                           typename DubinsScalar<Scalar>::type t,
+                           DubinsPathT<Scalar> *newpath);
 
 } // namespace whoop
 
@@ -0,0 +1,221 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       FastMath.hpp                                              */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Fast Bounded-Error Trigonometry for the Control Loop      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Polynomial sin, cos, atan2 and angle wrapping that avoid the library calls
+ * (and fmod) in the control loop. The polynomials are Chebyshev fits, and the
+ * maximum absolute errors below are for doubles, checked by host/precision
+ * against the standard library. For floats the error is that of float itself.
+ *
+ *   fast_sin, fast_cos, fast_sincos   1e-10 for |x| <= 1e4 radians
+ *   fast_atan2                         5e-10 radians
+ *   fast_normalize_angle               1e-15 * (1 + |x|) radians
+ *
+ * The control_ functions are what the hot paths (TwoDPose, WheelOdom and the
+ * pursuit steering) call. They use the standard library unless WHOOP_FAST_MATH
+ * is true, which can be set here or with -DWHOOP_FAST_MATH=true
+ */
+#ifndef FAST_MATH_HPP
+#define FAST_MATH_HPP
+
+#ifndef WHOOP_FAST_MATH
+#define WHOOP_FAST_MATH false // Change to true to use the fast kernels
+#endif
+
+#include "whooplib/include/toolbox.hpp"
+#include <cmath>
+
+namespace whoop {
+
+namespace fast_math_detail {
+
+// pi/2 split in two (from fdlibm), so that q * PIO2_HI is exact for the
+// quadrant counts the reduction sees
+const double PIO2_HI = 1.57079632673412561417e+00;
+const double PIO2_LO = 6.07710050650619224932e-11;
+
+// sin(r) / r as a polynomial of r^2, for |r| <= pi/4
+template <typename Scalar> inline Scalar sin_kernel(Scalar r) {
+  const Scalar u = r * r;
+  return r * (Scalar(0.9999999999956727) +
+              u * (Scalar(-0.16666666631589938) +
+                   u * (Scalar(0.008333328782382006) +
+                        u * (Scalar(-0.0001983920219505109) +
+                             u * Scalar(2.7173455579772983e-06)))));
+}
+
+// cos(r) as a polynomial of r^2, for |r| <= pi/4
+template <typename Scalar> inline Scalar cos_kernel(Scalar r) {
+  const Scalar u = r * r;
+  return Scalar(0.9999999999524891) +
+         u * (Scalar(-0.49999999614856644) +
+              u * (Scalar(0.0416666166924646) +
+                   u * (Scalar(-0.001388661799797854) +
+                        u * Scalar(2.4379831119409912e-05))));
+}
+
+// atan(t) for |t| <= tan(pi/8)
+template <typename Scalar> inline Scalar atan_kernel(Scalar t) {
+  const Scalar u = t * t;
+  return t * (Scalar(0.9999999993712285) +
+              u * (Scalar(-0.33333306893060244) +
+                   u * (Scalar(0.19998183041580453) +
+                        u * (Scalar(-0.14239532677373956) +
+                             u * (Scalar(0.1056982885731789) +
+                                  u * Scalar(-0.060263053475660876))))));
+}
+
+} // namespace fast_math_detail
+
+/**
+ * Computes the sine and cosine of an angle with one range reduction
+ * @param x The angle, in radians
+ * @param sin_out Where to store the sine
+ * @param cos_out Where to store the cosine
+ */
+template <typename Scalar>
+inline void fast_sincos(Scalar x, Scalar *sin_out, Scalar *cos_out) {
+  using namespace fast_math_detail;
+  // x = q * pi/2 + r, with |r| <= pi/4
+  const Scalar q = std::floor(x * Scalar(M_2_PI) + Scalar(0.5));
+  const Scalar r = (x - q * Scalar(PIO2_HI)) - q * Scalar(PIO2_LO);
+  const Scalar s = sin_kernel(r);
+  const Scalar c = cos_kernel(r);
+  switch (static_cast<long>(q) & 3) {
+  case 0:
+    *sin_out = s;
+    *cos_out = c;
+    break;
+  case 1:
+    *sin_out = c;
+    *cos_out = -s;
+    break;
+  case 2:
+    *sin_out = -s;
+    *cos_out = -c;
+    break;
+  default:
+    *sin_out = -c;
+    *cos_out = s;
+    break;
+  }
+}
+
+/**
+ * @param x The angle, in radians
+ * @returns The sine of the angle
+ */
+template <typename Scalar> inline Scalar fast_sin(Scalar x) {
+  Scalar s, c;
+  fast_sincos(x, &s, &c);
+  return s;
+}
+
+/**
+ * @param x The angle, in radians
+ * @returns The cosine of the angle
+ */
+template <typename Scalar> inline Scalar fast_cos(Scalar x) {
+  Scalar s, c;
+  fast_sincos(x, &s, &c);
+  return c;
+}
+
+/**
+ * Same as std::atan2, including the signs of the result on the axes
+ * @param y The y coordinate
+ * @param x The x coordinate
+ * @returns The angle of (x, y) from the positive x axis, in [-pi, pi]
+ */
+template <typename Scalar> inline Scalar fast_atan2(Scalar y, Scalar x) {
+  using namespace fast_math_detail;
+  const Scalar abs_x = std::fabs(x);
+  const Scalar abs_y = std::fabs(y);
+  const bool steep = abs_y > abs_x;
+  const Scalar big = steep ? abs_y : abs_x;
+  if (big == 0) {
+    return std::atan2(y, x); // Signed zeros
+  }
+  // Angle in [0, pi/4]
+  Scalar t = (steep ? abs_x : abs_y) / big;
+  Scalar angle;
+  if (t > Scalar(0.41421356237309503)) { // tan(pi/8)
+    angle = Scalar(M_PI_4) + atan_kernel((t - 1) / (t + 1));
+  } else {
+    angle = atan_kernel(t);
+  }
+  // Back to the octant of (x, y)
+  if (steep) {
+    angle = Scalar(M_PI_2) - angle;
+  }
+  if (x < 0) {
+    angle = Scalar(M_PI) - angle;
+  }
+  return std::signbit(y) ? -angle : angle;
+}
+
+/**
+ * Same as normalize_angle without the fmod. Angles already in range are
+ * returned unchanged.
+ * @param angle Angle in radians to normalize.
+ * @return Normalized angle in radians, in [-pi, pi].
+ */
+template <typename Scalar> inline Scalar fast_normalize_angle(Scalar angle) {
+  const Scalar pi = Scalar(M_PI);
+  if (angle > pi || angle < -pi) {
+    const Scalar turns = std::floor((angle + pi) * Scalar(0.5 * M_1_PI));
+    angle -= turns * Scalar(2 * M_PI);
+  }
+  return angle;
+}
+
+#if WHOOP_FAST_MATH
+
+template <typename Scalar> inline Scalar control_sin(Scalar x) {
+  return fast_sin(x);
+}
+template <typename Scalar> inline Scalar control_cos(Scalar x) {
+  return fast_cos(x);
+}
+template <typename Scalar>
+inline void control_sincos(Scalar x, Scalar *sin_out, Scalar *cos_out) {
+  fast_sincos(x, sin_out, cos_out);
+}
+template <typename Scalar> inline Scalar control_atan2(Scalar y, Scalar x) {
+  return fast_atan2(y, x);
+}
+template <typename Scalar> inline Scalar control_normalize_angle(Scalar x) {
+  return fast_normalize_angle(x);
+}
+
+#else
+
+template <typename Scalar> inline Scalar control_sin(Scalar x) {
+  return std::sin(x);
+}
+template <typename Scalar> inline Scalar control_cos(Scalar x) {
+  return std::cos(x);
+}
+template <typename Scalar>
+inline void control_sincos(Scalar x, Scalar *sin_out, Scalar *cos_out) {
+  *sin_out = std::sin(x);
+  *cos_out = std::cos(x);
+}
+template <typename Scalar> inline Scalar control_atan2(Scalar y, Scalar x) {
+  return std::atan2(y, x);
+}
+template <typename Scalar> inline Scalar control_normalize_angle(Scalar x) {
+  return normalize_scalar_angle(x);
+}
+
+#endif // WHOOP_FAST_MATH
+
+} // namespace whoop
+
+#endif // FAST_MATH_HPP
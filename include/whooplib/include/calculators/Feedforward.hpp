@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Feedforward.hpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Motor Feedforward From Characterized kS, kV and kA        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef FEEDFORWARD_HPP
+#define FEEDFORWARD_HPP
+
+namespace whoop {
+
+/**
+ * The voltage that a side of the drivetrain needs to move at a velocity and
+ * acceleration, from the model
+ *
+ *   voltage = ks * sign(velocity) + kv * velocity + ka * acceleration
+ *
+ * ks is the voltage to overcome friction, kv the voltage per meter per second
+ * and ka the voltage per meter per second^2. They are found by driving the
+ * robot at a few constant voltages (for ks and kv) and from rest (for ka).
+ */
+class MotorFeedforward {
+public:
+  double ks = 0; // Volts
+  double kv = 0; // Volts per m/s
+  double ka = 0; // Volts per m/s^2
+
+  /**
+   * @param ks The voltage to overcome static friction
+   * @param kv The voltage per meter per second of velocity
+   * @param ka The voltage per meter per second^2 of acceleration
+   */
+  MotorFeedforward(double ks = 0, double kv = 0, double ka = 0);
+
+  /**
+   * @returns true if the constants are characterized (kv is above 0)
+   */
+  bool enabled() const;
+
+  /**
+   * @param velocity The target velocity, in meters per second
+   * @param acceleration The target acceleration, in meters per second^2
+   * @returns The voltage. From rest, ks takes the sign of the acceleration
+   */
+  double calculate(double velocity, double acceleration = 0) const;
+
+  /**
+   * @param voltage The voltage available
+   * @returns The highest steady velocity at that voltage, in meters per
+   * second, or 0 if not enabled
+   */
+  double max_velocity(double voltage) const;
+};
+
+} // namespace whoop
+
+#endif // FEEDFORWARD_HPP
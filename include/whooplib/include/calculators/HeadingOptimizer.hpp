@@ -0,0 +1,70 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       HeadingOptimizer.hpp                                      */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Picks Waypoint Headings That Minimize Dubins Path Length  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Waypoints given as {x, y} have no heading, so one must be picked before the
+ * Dubins curves between them can be generated. Looking at the next waypoint
+ * is simple, but the robot then has to turn to that heading at every
+ * waypoint and turn again right after it.
+ *
+ * Instead, each free heading is discretized into a number of bins, and
+ * dynamic programming finds the combination with the shortest total Dubins
+ * length. Waypoints given as {x, y, yaw} keep their heading. The heading that
+ * looks at the next waypoint is always one of the candidates, so the result
+ * is never longer than the path it replaces.
+ *
+ * The work is (waypoints - 1) x (heading_bins + 1)^2 Dubins solutions, and
+ * the search gives up and keeps the original headings if it runs out of time.
+ */
+#ifndef HEADING_OPTIMIZER_HPP
+#define HEADING_OPTIMIZER_HPP
+
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include <vector>
+
+namespace whoop {
+
+/**
+ * The outcome of a heading optimization
+ */
+struct HeadingOptimizationResult {
+  bool optimized = false; // True if the optimized headings were used
+  bool timed_out = false; // True if the search ran out of time
+  std::vector<TwoDPose> waypoints; // The waypoints with every heading filled
+  double original_length = 0;  // Length with headings at the next waypoint
+  double optimized_length = 0; // Length with the optimized headings
+  double planning_time = 0;    // Time spent optimizing, in seconds
+
+  /**
+   * @returns The fraction of the original length that was removed, from 0 to 1
+   */
+  double length_reduction() const;
+};
+
+/**
+ * Fills in the headings of waypoints that do not have one
+ * @param waypoints The waypoints, each either {x, y} or {x, y, yaw}, in
+ * meters and radians
+ * @param turning_radius The turning radius of the path, in meters
+ * @param landing_strip The length of the straight line into the last
+ * waypoint, in meters
+ * @param heading_bins The number of evenly spaced headings tried at each
+ * waypoint without a heading
+ * @param time_budget The longest the search may take, in seconds
+ * @returns The result. If the search timed out, the headings look at the next
+ * waypoint, the same as without optimization
+ */
+HeadingOptimizationResult
+optimize_headings(const std::vector<std::vector<double>> &waypoints,
+                  double turning_radius, double landing_strip = 0,
+                  int heading_bins = 16, double time_budget = 0.05);
+
+} // namespace whoop
+
+#endif // HEADING_OPTIMIZER_HPP
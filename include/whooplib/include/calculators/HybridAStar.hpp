@@ -0,0 +1,122 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       HybridAStar.hpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Obstacle-Aware Hybrid A* Planner Over Dubins Primitives   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Hybrid A*, as described in: D. Dolgov, S. Thrun, M. Montemerlo and
+ * J. Diebel, "Practical Search Techniques in Path Planning for Autonomous
+ * Driving", 2008.
+ *
+ * The search expands left, straight and right motions at the turning radius
+ * of the robot, and regularly tries to finish with an analytic Dubins path
+ * to the goal. Since every motion is a Dubins path in its own right, the
+ * result is returned as waypoints that PurePursuitConductor::generate_path
+ * turns back into the exact same curves.
+ */
+#ifndef HYBRID_A_STAR_HPP
+#define HYBRID_A_STAR_HPP
+
+#include "whooplib/include/calculators/OccupancyGrid.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include <vector>
+
+namespace whoop {
+
+/**
+ * The outcome of a search
+ */
+struct HybridAStarResult {
+  bool success = false;   // True if a collision-free path was found
+  bool timed_out = false; // True if the search ran out of time or expansions
+  std::vector<TwoDPose> waypoints; // Start, intermediate poses, and the goal
+  double length = 0;               // Length of the path, in meters
+  int expansions = 0;              // Number of nodes expanded
+  double planning_time = 0;        // Time spent searching, in seconds
+};
+
+class HybridAStar {
+private:
+  struct Node {
+    double x, y, yaw;
+    double g;   // Path length from the start
+    int parent; // Index of the parent node, -1 for the start
+    int steer;  // -1 right, 0 straight, 1 left, for the motion to this node
+  };
+
+  OccupancyGrid inflated_grid;
+  std::vector<float> heuristic; // Obstacle-aware distance to the goal per cell
+  std::vector<Node> nodes;
+  std::vector<bool> closed; // One bit per (column, row, heading) state
+
+  void compute_heuristic(double goal_x, double goal_y);
+  double estimate(const Node &node, double q_goal[3]);
+  int state_index(double x, double y, double yaw) const;
+  bool pose_free(double x, double y) const;
+  bool straight_free(double x0, double y0, double x1, double y1) const;
+  bool dubins_free(double q0[3], double q1[3], double &length) const;
+  void build_waypoints(int goal_node, const TwoDPose &goal,
+                       const TwoDPose &search_goal,
+                       HybridAStarResult &result) const;
+
+public:
+  double turning_radius; // Turning radius of the expansions, in meters
+  double robot_radius;   // Radius the obstacles are grown by, in meters
+  int heading_bins;      // Number of discrete headings per cell
+  double step_length;    // Arc length of each expansion, in meters
+  double time_budget;    // Hard limit on the search time, in seconds
+  int max_expansions;    // Hard limit on the number of expansions
+  int analytic_interval; // Try a Dubins path to the goal every N expansions
+
+  /**
+   * Creates a planner over a grid of the field
+   * @param grid The obstacles. The planner keeps an inflated copy, so call
+   * set_grid again after changing the grid
+   * @param turning_radius The turning radius of the robot, in meters. Use the
+   * same value as the PursuitParams
+   * @param robot_radius The radius of a circle around the robot, in meters
+   * @param time_budget The longest the search may take, in seconds
+   * @param heading_bins The number of discrete headings
+   * @param step_length The arc length of each expansion, in meters. Set to 0
+   * to pick one that always leaves the current cell
+   * @param max_expansions The most nodes to expand before giving up
+   */
+  HybridAStar(const OccupancyGrid &grid, double turning_radius,
+              double robot_radius, double time_budget = 0.1,
+              int heading_bins = 72, double step_length = 0,
+              int max_expansions = 20000);
+
+  /**
+   * Replaces the obstacles, inflating them by the robot radius
+   * @param grid The obstacles
+   */
+  void set_grid(const OccupancyGrid &grid);
+
+  /**
+   * @returns true if a circular robot centered at the position would touch an
+   * obstacle or leave the grid
+   */
+  bool in_collision(double x, double y) const;
+
+  /**
+   * Searches for a collision-free path
+   * @param start The starting pose, in meters and radians
+   * @param goal The goal pose, in meters and radians
+   * @param landing_strip The landing strip the path will be driven with, in
+   * meters. PurePursuitPath drives the last part of a path as a straight line
+   * into the goal, so the search aims for the start of it instead. Use the
+   * lookahead distance if the landing strip is left at its default
+   * @returns The result. On success, the waypoints can be given directly to
+   * PurePursuitConductor::generate_path
+   */
+  HybridAStarResult plan(const TwoDPose &start, const TwoDPose &goal,
+                         double landing_strip = 0);
+};
+
+} // namespace whoop
+
+#endif // HYBRID_A_STAR_HPP
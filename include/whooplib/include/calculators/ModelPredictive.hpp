@@ -0,0 +1,159 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       ModelPredictive.hpp                                       */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Constrained Model Predictive Trajectory Controller        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef MODEL_PREDICTIVE_HPP
+#define MODEL_PREDICTIVE_HPP
+
+#include "whooplib/include/calculators/Trajectory.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+
+namespace whoop {
+
+/**
+ * What one side of the drivetrain can do, for the constraints of
+ * ModelPredictiveController. A side at velocity v accelerating at a needs
+ *
+ *   voltage = ks * sign(v) + kv * v + ka * a
+ */
+struct MpcSide {
+  double ks = 0;               // Volts
+  double kv = 0;               // Volts per m/s (must be above 0)
+  double ka = 0;               // Volts per m/s^2
+  double max_voltage = 12;     // Volts
+  double max_acceleration = 2; // m/s^2
+
+  MpcSide(double ks = 0, double kv = 0, double ka = 0, double max_voltage = 12,
+          double max_acceleration = 2)
+      : ks(ks), kv(kv), ka(ka), max_voltage(max_voltage),
+        max_acceleration(max_acceleration) {}
+};
+
+/**
+ * Follows a Trajectory by planning the velocity of each side over a short
+ * horizon, so that turns and stops are started early enough and the motors
+ * are never asked for more voltage or acceleration than they have.
+ *
+ * The differential drive is linearized around the trajectory, with the error
+ * of the robot in the frame of the reference:
+ *
+ *   error_forward' = angular_velocity * error_left + (change in velocity)
+ *   error_left'    = -angular_velocity * error_forward + velocity * error_yaw
+ *   error_yaw'     = (change in angular velocity)
+ *
+ * Each step, the quadratic cost of the error and of the change in side
+ * velocities over the horizon is minimized, with the voltage and acceleration
+ * of each side as constraints. The QP is solved with a fixed number of ADMM
+ * iterations, warm started from the last step, in memory that is allocated
+ * with the controller. If the solve takes longer than time_budget, it gives
+ * up so that the caller can fall back to another controller for the step.
+ */
+class ModelPredictiveController {
+public:
+  static constexpr int MAX_HORIZON = 15; // The most steps of a horizon
+
+  int horizon = 10;           // Steps planned ahead, up to MAX_HORIZON
+  double step_time = 0.05;    // Seconds between the steps of the horizon
+  int iterations = 30;        // ADMM iterations per solve
+  double time_budget = 0.005; // The longest a solve may take, in seconds
+
+  double position_weight = 1000; // Cost per m^2 of error
+  double yaw_weight = 50;        // Cost per rad^2 of error
+  double velocity_weight = 1;    // Cost per (m/s)^2 of change in velocity
+
+  double last_solve_time = 0; // Seconds the last solve took
+  double max_solve_time = 0;  // The longest solve since reset
+  int fallbacks = 0;          // Solves since reset that gave up
+
+  /**
+   * @param horizon Steps planned ahead, up to MAX_HORIZON
+   * @param time_budget The longest a solve may take, in seconds
+   */
+  ModelPredictiveController(int horizon = 10, double time_budget = 0.005);
+
+  /**
+   * Forgets the last solution and the statistics, for a new trajectory
+   */
+  void reset();
+
+  /**
+   * Plans the velocity of each side
+   * @param pose The pose of the robot, facing the way it drives
+   * @param trajectory The trajectory to follow
+   * @param time Seconds since the start of the trajectory
+   * @param track_width The distance between the left and right wheels, in
+   * meters
+   * @param left What the left side can do
+   * @param right What the right side can do
+   * @param left_velocity The velocity of the left side now, in m/s
+   * @param right_velocity The velocity of the right side now, in m/s
+   * @param left_target Where to store the target velocity of the left side
+   * @param right_target Where to store the target velocity of the right side
+   * @returns false if the solve ran out of time (or the sides have no kv),
+   * in which case the targets are not set
+   */
+  bool calculate(const TwoDPose &pose, const Trajectory &trajectory,
+                 double time, double track_width, const MpcSide &left,
+                 const MpcSide &right, double left_velocity,
+                 double right_velocity, double *left_target,
+                 double *right_target);
+
+private:
+  static constexpr int MAX_VARIABLES = 2 * MAX_HORIZON; // Both sides
+  static constexpr int MAX_CONSTRAINTS = 4 * MAX_HORIZON; // 2 per side
+
+  /**
+   * A row of the constraints, lower <= coefficient * u[index] +
+   * previous_coefficient * u[previous_index] <= upper, where u is the side
+   * velocities. previous_index is -1 on the first step, where the previous
+   * velocity is known and moved into the bounds
+   */
+  struct Constraint {
+    int index, previous_index;
+    double coefficient, previous_coefficient;
+    double lower, upper;
+  };
+
+  // The QP: minimize 1/2 u' P u + q' u, subject to the constraints
+  double P[MAX_VARIABLES][MAX_VARIABLES];
+  double q[MAX_VARIABLES];
+  Constraint constraints[MAX_CONSTRAINTS];
+
+  // The Cholesky factor of P + sigma I + rho A'A, lower triangular
+  double L[MAX_VARIABLES][MAX_VARIABLES];
+
+  // The ADMM iterates, kept between solves as the warm start
+  double x[MAX_VARIABLES];
+  double z[MAX_CONSTRAINTS];
+  double y[MAX_CONSTRAINTS];
+  bool warm = false;
+  int warm_horizon = 0;
+
+  // The effect of each change in velocity on each later error, and the
+  // error with no change
+  double effect[MAX_HORIZON + 1][MAX_HORIZON][3][2];
+  double free_error[MAX_HORIZON + 1][3];
+
+  /**
+   * Builds P, q and the constraints
+   * @returns The number of constraints
+   */
+  int build(const TwoDPose &pose, const Trajectory &trajectory, double time,
+            double track_width, const MpcSide &left, const MpcSide &right,
+            double left_velocity, double right_velocity);
+
+  /**
+   * Runs ADMM on the QP, checking the time budget every iteration
+   * @returns false if it ran out of time
+   */
+  bool solve(int variables, int rows, double start_time);
+};
+
+} // namespace whoop
+
+#endif // MODEL_PREDICTIVE_HPP
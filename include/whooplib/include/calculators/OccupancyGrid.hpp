@@ -0,0 +1,126 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       OccupancyGrid.hpp                                         */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Compact Bit-Packed Occupancy Grid of the Field            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef OCCUPANCY_GRID_HPP
+#define OCCUPANCY_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace whoop {
+
+/**
+ * A grid of the field where each cell is either free or occupied by an
+ * obstacle. Each cell takes a single bit, so a 12ft field at 1 inch
+ * resolution fits in under 3KB. Everything outside of the grid is considered
+ * occupied.
+ */
+class OccupancyGrid {
+private:
+  std::vector<uint32_t> cells; // One bit per cell, row-major
+
+public:
+  double width;      // Width of the grid (x), in meters
+  double height;     // Height of the grid (y), in meters
+  double resolution; // Size of each (square) cell, in meters
+  double origin_x;   // X position of the bottom-left corner, in meters
+  double origin_y;   // Y position of the bottom-left corner, in meters
+  int columns;       // Number of cells along x
+  int rows;          // Number of cells along y
+
+  /**
+   * Creates an empty grid. Defaults to a 12ft x 12ft VEX field at 2 inch
+   * resolution, centered on (0, 0)
+   * @param width Width of the grid (x), in meters
+   * @param height Height of the grid (y), in meters
+   * @param resolution Size of each cell, in meters
+   * @param origin_x X position of the bottom-left corner, in meters
+   * @param origin_y Y position of the bottom-left corner, in meters
+   */
+  OccupancyGrid(double width = 3.6576, double height = 3.6576,
+                double resolution = 0.0508, double origin_x = -1.8288,
+                double origin_y = -1.8288);
+
+  /**
+   * Marks every cell as free
+   */
+  void clear();
+
+  /**
+   * @returns true if the cell is within the grid
+   */
+  bool in_bounds(int column, int row) const;
+
+  /**
+   * Finds the cell containing a position
+   * @param x The x position, in meters
+   * @param y The y position, in meters
+   * @param column The resulting column
+   * @param row The resulting row
+   * @returns true if the position is within the grid
+   */
+  bool to_cell(double x, double y, int &column, int &row) const;
+
+  /**
+   * Marks a single cell. Cells outside of the grid are ignored
+   * @param column The column of the cell
+   * @param row The row of the cell
+   * @param occupied true if the cell holds an obstacle
+   */
+  void set_cell(int column, int row, bool occupied = true);
+
+  /**
+   * @returns true if the cell is occupied, or outside of the grid
+   */
+  bool cell_occupied(int column, int row) const;
+
+  /**
+   * @returns true if the position is occupied, or outside of the grid
+   */
+  bool is_occupied(double x, double y) const;
+
+  /**
+   * Marks every cell whose center is inside an axis-aligned rectangle
+   * @param x0 X position of one corner, in meters
+   * @param y0 Y position of one corner, in meters
+   * @param x1 X position of the opposite corner, in meters
+   * @param y1 Y position of the opposite corner, in meters
+   * @param occupied true to add an obstacle, false to remove one
+   */
+  void add_rectangle(double x0, double y0, double x1, double y1,
+                     bool occupied = true);
+
+  /**
+   * Marks every cell whose center is inside a circle
+   * @param x X position of the center, in meters
+   * @param y Y position of the center, in meters
+   * @param radius Radius of the circle, in meters
+   * @param occupied true to add an obstacle, false to remove one
+   */
+  void add_circle(double x, double y, double radius, bool occupied = true);
+
+  /**
+   * Grows every obstacle, and the edges of the grid, by a radius. A circular
+   * robot of that radius is then collision-free wherever its center is on a
+   * free cell of the inflated grid
+   * @param radius The radius to grow by, in meters
+   * @returns The inflated grid
+   */
+  OccupancyGrid inflated(double radius) const;
+
+  /**
+   * @returns The number of bytes used to store the cells
+   */
+  size_t memory_usage() const;
+};
+
+} // namespace whoop
+
+#endif // OCCUPANCY_GRID_HPP
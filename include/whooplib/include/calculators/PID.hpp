@@ -41,38 +41,40 @@ namespace whoop {
 
 /**
  * General-use PID class for drivetrains. It includes both
- * control calculation and settling calculation. The default
- * update period is 10ms or 100Hz
+ * control calculation and settling calculation. The gains are tuned for an
+ * update period of 10ms or 100Hz, and a step of any other length is scaled
+ * to match, so the same gains work at other rates. Scalar is the precision
+ * of the calculations: PID is double precision and PIDf is single precision
  */
 
-class PID {
+template <typename Scalar> class PIDT {
 public:
-  double error = 0;
-  double kp = 0;
-  double ki = 0;
-  double kd = 0;
-  double ka = 0;
-  double starti = 0;
-  double settle_error = 0;
+  Scalar error = 0;
+  Scalar kp = 0;
+  Scalar ki = 0;
+  Scalar kd = 0;
+  Scalar ka = 0;
+  Scalar starti = 0;
+  Scalar settle_error = 0;
 
 private:
-  double settle_time = 0;
-  double timeout = 0;
-  double accumulated_error = 0;
-  double previous_error = 0;
-  double output = 0;
+  Scalar settle_time = 0;
+  Scalar timeout = 0;
+  Scalar accumulated_error = 0;
+  Scalar previous_error = 0;
+  Scalar output = 0;
 
   bool reject_first_accumulation = false;
 
-  double max_integral_power = 12.0;
-  double max_integral_power_scaled = 0;
+  Scalar max_integral_power = 12.0;
+  Scalar max_integral_power_scaled = 0;
 
 public:
-  double time_spent_settled = 0;
+  Scalar time_spent_settled = 0;
 
 private:
-  double time_spent_running = 0;
-  double update_period = 10;
+  Scalar time_spent_running = 0;
+  Scalar update_period = 10; // The period the gains are tuned for, in ms
 
 public:
   /**
@@ -94,7 +96,7 @@ public:
    * @param timeout Time after which to give up and move on
    * @param max_integral_power The maximum integral power, clamped
    */
-  PID(double error, double kp, double ki, double kd, double ka, double starti, double max_integral_power);
+  PIDT(Scalar error, Scalar kp, Scalar ki, Scalar kd, Scalar ka, Scalar starti, Scalar max_integral_power);
 
   /**
    * PID constructor with custom update period
@@ -112,8 +114,8 @@ public:
    * @param timeout Time after which to give up and move on, in seconds
    * @param max_integral_power The maximum integral power, clamped
    */
-  PID(double error, double kp, double ki, double kd, double ka, double starti, double max_integral_power,
-      double settle_error, double settle_time, double timeout);
+  PIDT(Scalar error, Scalar kp, Scalar ki, Scalar kd, Scalar ka, Scalar starti, Scalar max_integral_power,
+       Scalar settle_error, Scalar settle_time, Scalar timeout);
 
   /**
    * Computes the output power based on the error
@@ -125,7 +127,19 @@ public:
    * @param error Difference in desired and current position
    * @return Output power
    */
-  double step(double error);
+  Scalar step(Scalar error);
+
+  /**
+   * Computes the output power based on the error, for a step that did not
+   * take the usual 10ms. The derivative is the change in error per 10ms, and
+   * the integral grows by the error for each 10ms, so the output matches
+   * what the gains would give at 10ms
+   *
+   * @param error Difference in desired and current position
+   * @param dt Time since the previous step, in seconds
+   * @return Output power
+   */
+  Scalar step(Scalar error, Scalar dt);
 
   /**
    * Computes whether or not the movement has settled
@@ -146,8 +160,25 @@ public:
    *  Makes accumulated_error be zero
    */
   void zeroize_accumulated();
+
+  /**
+   * Starts the controller where another one left off, so that its first step
+   * continues from output instead of jumping: the derivative starts from
+   * error, and within starti the integral is set to make up the difference
+   *
+   * @param error The error of the first step
+   * @param output The output to continue from
+   */
+  void seed(Scalar error, Scalar output);
 };
 
+// Compiled in PID.cpp
+extern template class PIDT<double>;
+extern template class PIDT<float>;
+
+typedef PIDT<double> PID;
+typedef PIDT<float> PIDf;
+
 } // namespace whoop
 
 #endif // PID_HPP
\ No newline at end of file
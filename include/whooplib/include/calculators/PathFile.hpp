@@ -0,0 +1,98 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PathFile.hpp                                              */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Versioned Binary File Format for Pure Pursuit Paths       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * A generated PurePursuitPath can be saved as a binary file and loaded later
+ * without regenerating it. The file is a fixed-size header followed by the
+ * arrays of the path, each stored exactly as it is laid out in memory:
+ *
+ *   PathFileHeader
+ *   waypoints            num_waypoints   x PathFilePose
+ *   pursuit_points       num_points      x barebonesPose
+ *   pursuit_checkpoints  num_checkpoints x pursuitCheckpoint
+ *   pursuit_legs         num_legs        x pursuitLeg
+ *   primitives           num_primitives  x PathPrimitive
+ *   profile stations     num_stations    x double
+ *   profile velocities   num_stations    x double
+ *
+ * Loading is a size check and one copy per array, with no parsing, and the
+ * indexes and enums are checked to be in range. Values are little-endian with
+ * natural alignment, which is the same on the V5 brain and on x86 computers,
+ * so files can be generated on either.
+ */
+#ifndef PATH_FILE_HPP
+#define PATH_FILE_HPP
+
+#include "whooplib/include/calculators/PurePursuit.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace whoop {
+
+const uint32_t PATH_FILE_MAGIC = 0x48545057; // "WPTH"
+const uint16_t PATH_FILE_VERSION = 3; // 3: integer leg indexes
+
+struct PathFilePose {
+  double x, y, yaw;
+};
+
+struct PathFileHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_size;
+  uint8_t path_representation;
+  uint8_t path_planner;
+  uint8_t path_valid;
+  uint8_t reserved;
+  uint32_t num_waypoints;
+  uint32_t num_points;
+  uint32_t num_checkpoints;
+  uint32_t num_legs;
+  uint32_t num_primitives;
+  uint32_t num_stations;
+  uint32_t reserved_count;
+
+  // The parameters used to generate the path
+  double turning_radius;
+  double lookahead_distance;
+  double num_segments;
+  double landing_strip;
+  double push_back_distance;
+  double smoothing_length;
+  double step_size;
+  double t_max;
+
+  PathFilePose start;
+  PathFilePose end;
+  PathFilePose end_translated_back;
+};
+
+/**
+ * Writes a path into the binary path file format
+ * @param path The generated path
+ * @returns The bytes of the file
+ */
+std::vector<uint8_t> serialize_path(const PurePursuitPath &path);
+
+/**
+ * Reads a path from the binary path file format. The path is left untouched
+ * if the data is not a valid path file of the current version, or if an index
+ * of its checkpoints or legs is past its points
+ * @param data The bytes of the file
+ * @param size The number of bytes
+ * @param path The path to load into
+ * @returns true if the path was loaded
+ */
+bool deserialize_path(const uint8_t *data, size_t size,
+                      PurePursuitPath &path);
+
+} // namespace whoop
+
+#endif // PATH_FILE_HPP
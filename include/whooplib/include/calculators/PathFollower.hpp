@@ -0,0 +1,348 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PathFollower.hpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Path Followers of the Pure Pursuit Conductor              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef PATH_FOLLOWER_HPP
+#define PATH_FOLLOWER_HPP
+
+#include "whooplib/include/calculators/Feedforward.hpp"
+#include "whooplib/include/calculators/ModelPredictive.hpp"
+#include "whooplib/include/calculators/PurePursuit.hpp"
+#include "whooplib/include/calculators/Ramsete.hpp"
+#include "whooplib/include/calculators/Trajectory.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+
+namespace whoop {
+
+class PurePursuitConductor;
+
+/**
+ * Enum to specify how the conductor follows a path
+ */
+enum pathfollower {
+  follower_pure_pursuit, // Steers toward a look ahead point with the PIDs
+  follower_ramsete,      // Tracks a timed trajectory (see RamseteFollower)
+  follower_mpc // Plans ahead along a timed trajectory within the voltage and
+               // acceleration of each side (see MpcFollower)
+};
+
+/**
+ * The tuning of RamseteFollower
+ */
+struct RamseteParams {
+  double b;
+  double zeta;
+  double wheel_velocity_kp;
+
+  /**
+   * @param b How aggressively RAMSETE converges on the trajectory
+   * @param zeta The damping of RAMSETE, in (0, 1)
+   * @param wheel_velocity_kp The volts added to a side per m/s that it is
+   * slower than RAMSETE's target, measured from the change in pose
+   */
+  RamseteParams(double b = 10.0, double zeta = 0.7,
+                double wheel_velocity_kp = 20.0)
+      : b(b), zeta(zeta), wheel_velocity_kp(wheel_velocity_kp) {}
+};
+
+/**
+ * The tuning of MpcFollower
+ */
+struct MpcParams {
+  int horizon;
+  double time_budget;
+  double wheel_velocity_kp;
+
+  /**
+   * @param horizon The steps of 50ms that are planned ahead, up to
+   * ModelPredictiveController::MAX_HORIZON
+   * @param time_budget The longest a plan of a step may take, in seconds.
+   * Steps that take longer are driven with pure pursuit instead
+   * @param wheel_velocity_kp The volts added to a side per m/s that it is
+   * slower than the plan, measured from the change in pose
+   */
+  MpcParams(int horizon = 10, double time_budget = 0.005,
+            double wheel_velocity_kp = 20.0)
+      : horizon(horizon), time_budget(time_budget),
+        wheel_velocity_kp(wheel_velocity_kp) {}
+};
+
+struct PursuitResult {
+  bool is_valid;
+  double steering_angle;
+  double distance;
+  double forward_power;
+  double steering_power;
+  bool is_completed;
+  bool suggest_point_turn;
+  int direction;
+
+  // Set when a trajectory tracker drives each side directly. The sides are
+  // relative to the pose given to the conductor, and forward_power and
+  // steering_power are their average and half their difference
+  bool has_side_powers = false;
+  double left_power = 0, right_power = 0;       // Volts
+  double left_velocity = 0, right_velocity = 0; // Target m/s of each side
+
+  // Seconds the model predictive controller took this step, and whether it
+  // ran out of time so that pure pursuit drove the step instead
+  double solve_time = 0;
+  bool fell_back = false;
+
+  // Set when a chained motion completes at its exit condition instead of
+  // settling, so that the motors are left at speed for the next motion
+  bool chained = false;
+
+  /**
+   * @param is_valid would be true if the pursuit estimate returned no error
+   * @param steering_angle would be the angle to turn towards for course
+   * correction in radians, counter-clockwise-positive
+   * @param distance would be the distance from the target, in meters
+   * @param forward_power the suggested motor power to go forward
+   * @param steering_power the suggestedmotor power for steering
+   * @param is_completed if true, the pure pursuit is complete
+   * @param suggest_point_turn is true when it suggests a point turn instead of
+   * swing turn
+   * @param direction 1 if the robot should drive forward, -1 if in reverse.
+   * When in reverse, the powers are relative to the back of the robot
+   */
+  PursuitResult(bool is_valid = false, double steering_angle = 0,
+                double distance = 0, double forward_power = 0,
+                double steering_power = 0, bool is_completed = false,
+                bool suggest_point_turn = false, int direction = 1)
+      : is_valid(is_valid), steering_angle(steering_angle), distance(distance),
+        forward_power(forward_power), steering_power(steering_power),
+        is_completed(is_completed), suggest_point_turn(suggest_point_turn),
+        direction(direction) {}
+};
+
+/**
+ * Splits the powers of a pure pursuit step between the sides, as
+ * WhoopDrivetrain drives them. A point turn splits the turning power between
+ * the sides, and a swing turn subtracts it from the inner side
+ * @param forward_power The forward power, relative to the way the robot drives
+ * @param steering_power The turning power, counter-clockwise-positive
+ * @param point_turn true to turn in place, false to swing turn
+ * @param reverse_drive true if the robot drives backwards
+ * @param left_power Where to store the power of the left side
+ * @param right_power Where to store the power of the right side
+ */
+void pursuit_side_powers(double forward_power, double steering_power,
+                         bool point_turn, bool reverse_drive,
+                         double *left_power, double *right_power);
+
+/**
+ * The inverse of pursuit_side_powers: finds the powers of a pure pursuit step
+ * that drive the sides at the given powers
+ * @param left_power The power of the left side
+ * @param right_power The power of the right side
+ * @param point_turn true to turn in place, false to swing turn
+ * @param reverse_drive true if the robot drives backwards
+ * @param forward_power Where to store the forward power
+ * @param steering_power Where to store the turning power
+ */
+void pursuit_powers_of_sides(double left_power, double right_power,
+                             bool point_turn, bool reverse_drive,
+                             double *forward_power, double *steering_power);
+
+/**
+ * Drives the robot along the path of a conductor, one step at a time
+ */
+class PathFollower {
+public:
+  virtual ~PathFollower() {}
+
+  /**
+   * Forgets the last path, before the first step of a new path or turn
+   */
+  virtual void reset() = 0;
+
+  /**
+   * Steps the follower
+   * @param current_pose The pose of the robot, facing the way it drives
+   * @param dt Time since the previous step, in seconds
+   * @returns The powers to drive this step
+   */
+  virtual PursuitResult step(const TwoDPose &current_pose, double dt) = 0;
+};
+
+/**
+ * A follower that drives the path, PIDs and feedforward of a
+ * PurePursuitConductor. It stays with its own conductor when the conductor
+ * is copied, and only its state is copied over
+ */
+class ConductorFollower : public PathFollower {
+protected:
+  PurePursuitConductor *conductor;
+
+  explicit ConductorFollower(PurePursuitConductor *conductor)
+      : conductor(conductor) {}
+  ConductorFollower(const ConductorFollower &) = delete;
+  ConductorFollower &operator=(const ConductorFollower &) { return *this; }
+};
+
+/**
+ * Steers toward a look ahead point with the turning PID, and drives the
+ * distance left with the forward PID, or with the side feedforward when it
+ * is set (see PursuitParams::left_kv)
+ */
+class PurePursuitFollower : public ConductorFollower {
+private:
+  bool wipe_turn_once = false;
+  double profile_velocity_command = 0; // Acceleration-limited profile velocity
+
+  // The feedforward reference: the path distance it has left, and the
+  // direction of the leg it is on (it restarts at each cusp)
+  double reference_remaining = -1;
+  int reference_direction = 1;
+
+  /**
+   * Moves the feedforward reference along the path by one step
+   * @param estimate The pursuit estimate of this step
+   * @param dt Time since the previous step, in seconds
+   * @param turn_power Where to store the feedforward turning voltage
+   * @returns The feedforward forward voltage
+   */
+  double step_feedforward(const PursuitEstimate &estimate, double dt,
+                          double *turn_power);
+
+public:
+  explicit PurePursuitFollower(PurePursuitConductor *conductor)
+      : ConductorFollower(conductor) {}
+
+  void reset() override;
+  PursuitResult step(const TwoDPose &current_pose, double dt) override;
+
+  /**
+   * Steps the PIDs and the feedforward, without completing the motion, so
+   * that a trajectory follower can hand over to them smoothly
+   * @param current_pose The pose of the robot, facing the way it drives
+   * @param dt Time since the previous step, in seconds
+   */
+  PursuitResult steer(const TwoDPose &current_pose, double dt);
+
+  /**
+   * Completes the result of "steer" once the robot is settled at the end
+   * @param result The result of this step
+   */
+  void settle(PursuitResult *result);
+};
+
+/**
+ * Times the path into a Trajectory with the velocity limits, and drives each
+ * side along it until it is over. Pure pursuit is stepped along with it, so
+ * that it takes over smoothly to settle the robot at the end
+ */
+class TrajectoryFollower : public ConductorFollower {
+private:
+  // How far along the trajectory the follower is, in seconds (-1 before the
+  // first step)
+  double trajectory_time = -1;
+  double last_left_reference = 0, last_right_reference = 0; // m/s
+  double last_left_velocity = 0, last_right_velocity = 0;   // Targets, m/s
+  TwoDPose last_pose; // To measure the velocity of each side
+
+  void start_trajectory();
+
+  /**
+   * Drives each side along the trajectory for one step
+   * @param current_pose The pose of the robot, facing the way it drives
+   * @param dt Time since the previous step, in seconds
+   * @param result Where to store the side powers
+   */
+  void step_trajectory(const TwoDPose &current_pose, double dt,
+                       PursuitResult *result);
+
+  /**
+   * @returns The voltage for a side to move at a velocity, from the
+   * feedforward constants or else from max_velocity
+   */
+  double side_voltage(const MotorFeedforward &side, double velocity,
+                      double acceleration) const;
+
+protected:
+  Trajectory trajectory;        // The path, timed with the velocity limits
+  double wheel_velocity_kp = 0; // See RamseteParams::wheel_velocity_kp
+
+  /**
+   * Finds the velocity of each side for this step
+   * @param current_pose The pose of the robot, facing the way it drives
+   * @param reference Where the trajectory says the robot should be now
+   * @param time How far along the trajectory the step is, in seconds
+   * @param left The feedforward of the left side of the pose
+   * @param right The feedforward of the right side of the pose
+   * @param measured_left The measured velocity of the left side, in m/s
+   * @param measured_right The measured velocity of the right side, in m/s
+   * @param left_velocity Where to store the left velocity, in m/s
+   * @param right_velocity Where to store the right velocity, in m/s
+   * @param result Where to store how the step was solved
+   * @returns false if pure pursuit should drive this step instead
+   */
+  virtual bool side_velocities(
+      const TwoDPose &current_pose, const TrajectoryState &reference,
+      double time, const MotorFeedforward &left,
+      const MotorFeedforward &right, double measured_left,
+      double measured_right, double *left_velocity, double *right_velocity,
+      PursuitResult *result) = 0;
+
+public:
+  explicit TrajectoryFollower(PurePursuitConductor *conductor)
+      : ConductorFollower(conductor) {}
+
+  void reset() override;
+  PursuitResult step(const TwoDPose &current_pose, double dt) override;
+};
+
+/**
+ * Tracks the trajectory with a RamseteController
+ */
+class RamseteFollower : public TrajectoryFollower {
+protected:
+  bool side_velocities(const TwoDPose &current_pose,
+                       const TrajectoryState &reference, double time,
+                       const MotorFeedforward &left,
+                       const MotorFeedforward &right, double measured_left,
+                       double measured_right, double *left_velocity,
+                       double *right_velocity,
+                       PursuitResult *result) override;
+
+public:
+  RamseteController ramsete;
+
+  explicit RamseteFollower(PurePursuitConductor *conductor)
+      : TrajectoryFollower(conductor) {}
+
+  void reset() override;
+};
+
+/**
+ * Tracks the trajectory with a ModelPredictiveController. A step that takes
+ * longer than the time budget to plan is driven with pure pursuit instead
+ */
+class MpcFollower : public TrajectoryFollower {
+protected:
+  bool side_velocities(const TwoDPose &current_pose,
+                       const TrajectoryState &reference, double time,
+                       const MotorFeedforward &left,
+                       const MotorFeedforward &right, double measured_left,
+                       double measured_right, double *left_velocity,
+                       double *right_velocity,
+                       PursuitResult *result) override;
+
+public:
+  ModelPredictiveController mpc;
+
+  explicit MpcFollower(PurePursuitConductor *conductor)
+      : TrajectoryFollower(conductor) {}
+
+  void reset() override;
+};
+
+} // namespace whoop
+
+#endif // PATH_FOLLOWER_HPP
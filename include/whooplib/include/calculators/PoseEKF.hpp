@@ -0,0 +1,136 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PoseEKF.hpp                                               */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Extended Kalman Filter of a Pose in the Plane             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Estimates the pose of the robot (x, y, yaw) along with how uncertain it is
+ * (its covariance). Each step of wheel odometry moves the estimate and grows
+ * the uncertainty by how far the robot moved; each vision frame pulls the
+ * estimate toward it by how uncertain each of them is, and shrinks the
+ * uncertainty:
+ *
+ *   ekf.reset(TwoDPose(0, 0, 0));
+ *   ekf.predict(odom_dx, odom_dy, odom_dyaw, odom_yaw, dt); // Every step
+ *   ekf.update(vision.x, vision.y, vision.yaw, confidence); // Every frame
+ *
+ * Frames that are too unlikely for the uncertainty (their Mahalanobis
+ * distance is over gate_threshold) are rejected as outliers. So that the
+ * filter can recover if the odometry itself went wrong (i.e. the robot was
+ * pushed), a frame is taken anyway after max_rejections rejected in a row.
+ *
+ * The state is three numbers and a 3x3 matrix, so both steps take the same
+ * time and never allocate.
+ */
+#ifndef POSE_EKF_HPP
+#define POSE_EKF_HPP
+
+#include "whooplib/include/calculators/TwoDPose.hpp"
+
+namespace whoop {
+
+class PoseEKF {
+public:
+  /**
+   * The estimate and its covariance, to go back to (see PoseHistory.hpp)
+   */
+  struct Estimate {
+    double state[3];         // x, y, yaw
+    double covariance[3][3]; // Of the state
+  };
+
+  // Standard deviations of the wheel odometry, which grow with the motion
+  double odom_translation_noise = 0.02; // Meters per square root meter driven
+  double odom_rotation_noise = 0.02;  // Radians per square root radian turned
+  double yaw_drift_noise = 0.005;     // Radians per square root second (IMU)
+
+  // Standard deviations of a vision frame at a confidence of 1. Less confident
+  // frames are trusted less, by 1 over their confidence. These are wider than
+  // the noise of the camera alone, as a frame is also off by how far the
+  // robot moved while it was processed, unless its age is compensated for
+  double vision_position_noise = 0.1; // Meters
+  double vision_yaw_noise = 0.1;      // Radians
+
+  double gate_threshold = 11.34; // Chi-squared of 3 degrees of freedom at 99%
+  int max_rejections = 10; // Frames rejected in a row before one is taken
+
+  PoseEKF();
+
+  /**
+   * Sets the estimate, and how uncertain it is
+   * @param pose The pose, in meters and counter-clockwise radians
+   * @param position_std Standard deviation of the position, in meters
+   * @param yaw_std Standard deviation of the yaw, in radians
+   */
+  void reset(const TwoDPose &pose, double position_std = 0.01,
+             double yaw_std = 0.01);
+
+  /**
+   * Moves the estimate by a step of wheel odometry
+   * @param dx Meters the odometry moved along its x axis
+   * @param dy Meters the odometry moved along its y axis
+   * @param dyaw Radians the odometry turned, counter-clockwise
+   * @param odom_yaw The yaw of the odometry before the step, so that the step
+   * is turned into the frame of the estimate
+   * @param dt Seconds of the step
+   */
+  void predict(double dx, double dy, double dyaw, double odom_yaw, double dt);
+
+  /**
+   * Corrects the estimate with a measurement of the pose
+   * @param x Meters
+   * @param y Meters
+   * @param yaw Radians, counter-clockwise
+   * @param confidence How confident the measurement is (0.0 - 1.0)
+   * @returns false if it was rejected as an outlier
+   */
+  bool update(double x, double y, double yaw, double confidence);
+
+  /**
+   * @returns The estimate and its covariance
+   */
+  Estimate get_estimate() const;
+
+  /**
+   * Goes back to an estimate, keeping the counts of the measurements
+   * @param estimate An estimate from get_estimate
+   */
+  void set_estimate(const Estimate &estimate);
+
+  /**
+   * @returns The estimated pose
+   */
+  TwoDPose get_pose() const;
+
+  /**
+   * @returns Standard deviation of the position, in meters (the larger axis)
+   */
+  double get_position_std() const;
+
+  /**
+   * @returns Standard deviation of the yaw, in radians
+   */
+  double get_yaw_std() const;
+
+  /**
+   * @returns The Mahalanobis distance squared of the last measurement
+   */
+  double get_last_distance() const;
+
+  unsigned long accepted = 0; // Measurements taken
+  unsigned long rejected = 0; // Measurements rejected as outliers
+
+private:
+  double state[3];         // x, y, yaw
+  double covariance[3][3]; // Of the state
+  double last_distance = 0;
+  int rejections_in_a_row = 0;
+};
+
+} // namespace whoop
+
+#endif // POSE_EKF_HPP
@@ -0,0 +1,103 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PoseHistory.hpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Timestamped History of Wheel Odometry Steps               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * A vision frame describes where the robot was when the camera captured it,
+ * which is tens of milliseconds before it arrives. PoseHistory keeps the last
+ * SIZE steps of wheel odometry, each with the time it ended, so that a frame
+ * can be moved forward by the steps since it was captured:
+ *
+ *   history.push(step);                              // Every step
+ *   int i = history.find(capture_time);              // Every frame
+ *   TwoDPose now = history.replay(vision_pose, i);
+ *
+ * It is a ring buffer of a fixed size, so pushing never allocates, and a
+ * step older than SIZE steps is forgotten.
+ */
+#ifndef POSE_HISTORY_HPP
+#define POSE_HISTORY_HPP
+
+#include "whooplib/include/calculators/PoseEKF.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+
+namespace whoop {
+
+/**
+ * A step of wheel odometry, as it moved in the frame of the odometry
+ */
+struct OdomStep {
+  double time = 0;     // Seconds on the brain's clock, when the step ended
+  double dt = 0;       // Seconds of the step
+  double dx = 0;       // Meters moved along the x axis of the odometry
+  double dy = 0;       // Meters moved along the y axis of the odometry
+  double dyaw = 0;     // Radians turned, counter-clockwise
+  double odom_yaw = 0; // The yaw of the odometry before the step
+  PoseEKF::Estimate estimate; // The filter after the step, for fusion_ekf
+
+  /**
+   * Moves a pose by this step, turned from the frame of the odometry into
+   * the frame of the pose
+   * @param pose The pose before the step
+   * @returns The pose after the step
+   */
+  TwoDPose apply(const TwoDPose &pose) const;
+};
+
+class PoseHistory {
+public:
+  static constexpr int SIZE = 64; // Steps kept (0.64 seconds at 100 Hz)
+
+  /**
+   * Forgets every step
+   */
+  void clear();
+
+  /**
+   * Adds the newest step, forgetting the oldest if full
+   * @param step The step, which ended after every step before it
+   */
+  void push(const OdomStep &step);
+
+  /**
+   * @returns The number of steps kept
+   */
+  int size() const;
+
+  /**
+   * @param i 0 for the oldest step, up to size() - 1 for the newest
+   * @returns The step
+   */
+  OdomStep &operator[](int i);
+  const OdomStep &operator[](int i) const;
+
+  /**
+   * Finds the step that ended last at or before a time
+   * @param time Seconds on the brain's clock
+   * @returns Its index, size() - 1 if the time is after every step, or -1 if
+   * it is before every step kept (or none are)
+   */
+  int find(double time) const;
+
+  /**
+   * Moves a pose forward by every step after a step
+   * @param pose The pose at the end of step i
+   * @param i The index of the step, from find
+   * @returns The pose at the end of the newest step
+   */
+  TwoDPose replay(const TwoDPose &pose, int i) const;
+
+private:
+  OdomStep steps[SIZE];
+  int oldest = 0;
+  int count = 0;
+};
+
+} // namespace whoop
+
+#endif // POSE_HISTORY_HPP
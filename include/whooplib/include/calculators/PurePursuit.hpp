@@ -10,12 +10,34 @@
 #ifndef PURE_PURSUIT_HPP
 #define PURE_PURSUIT_HPP
 
+#include "whooplib/include/calculators/AnalyticPath.hpp"
 #include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/calculators/ReedsShepp.hpp"
+#include "whooplib/include/calculators/Trajectory.hpp"
 #include "whooplib/include/calculators/TwoDPose.hpp"
+#include "whooplib/include/calculators/VelocityProfile.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace whoop {
 
+/**
+ * Enum to specify how a pure pursuit path is stored
+ */
+enum pathrepresentation {
+  path_sampled, // Dubins curves are sampled into num_segments points each
+  path_analytic // Dubins curves are kept as line and arc primitives
+};
+
+/**
+ * Enum to specify which curves connect the waypoints of a pure pursuit path
+ */
+enum pathplanner {
+  planner_dubins,     // Forward-only Dubins curves
+  planner_reeds_shepp // Reeds-Shepp curves, which may reverse mid-path
+};
+
 /**
 PursuitEstimate is an object that is the result of a given pure pursuit path calculation
  */
@@ -26,6 +48,7 @@ struct PursuitEstimate {
   bool is_past_point;
   double last_steering;
   bool suggest_point_turn;
+  int direction;
 
   /**
    * @param is_valid would be true if the pursuit estimate returned no error
@@ -36,29 +59,56 @@ struct PursuitEstimate {
    * @param last_steering Is the suggested steering for last point
    * @param suggest_point_turn Would be true if the pure pursuits suggest a
    * point turn instead of swing turn
+   * @param direction 1 if the robot should drive forward, -1 if in reverse.
+   * When in reverse, steering_angle is relative to the back of the robot
    */
   PursuitEstimate(bool is_valid = false, double steering_angle = 0,
                   double distance = 0, bool is_past_point = false,
-                  double last_steering = 0, bool suggest_point_turn = false)
+                  double last_steering = 0, bool suggest_point_turn = false,
+                  int direction = 1)
       : is_valid(is_valid), steering_angle(steering_angle), distance(distance),
         is_past_point(is_past_point), last_steering(last_steering),
-        suggest_point_turn(suggest_point_turn) {}
+        suggest_point_turn(suggest_point_turn), direction(direction) {}
 };
 
-struct barebonesPose {
-  double x = 0;
-  double y = 0;
-  double yaw = 0;
-  barebonesPose(double x = 0, double y = 0, double yaw = 0)
+template <typename Scalar> struct barebonesPoseT {
+  Scalar x = 0;
+  Scalar y = 0;
+  Scalar yaw = 0;
+  barebonesPoseT(Scalar x = 0, Scalar y = 0, Scalar yaw = 0)
       : x(x), y(y), yaw(yaw) {}
 };
 
+typedef barebonesPoseT<double> barebonesPose;
+typedef barebonesPoseT<float> barebonesPosef;
+
+/**
+ * A point along the path that the robot has to pass on the way. Checkpoints
+ * are sorted along the path, and the robot pursues the section between the
+ * last checkpoint it passed and the next one.
+ */
 struct pursuitCheckpoint {
-  double i;
-  bool visited;
+  uint32_t i; // Index of the pursuit point at the checkpoint (sampled paths)
   bool is_last;
-  pursuitCheckpoint(double i, bool visited = false, bool is_last = false)
-      : i(i), visited(visited), is_last(is_last) {}
+  double s; // Arc length along the path, in meters
+  pursuitCheckpoint(uint32_t i = 0, bool is_last = false, double s = 0)
+      : i(i), is_last(is_last), s(s) {}
+};
+
+/**
+ * A portion of the path driven in a single direction. Legs are separated by
+ * cusps, where the robot stops and changes direction.
+ */
+struct pursuitLeg {
+  uint32_t start_i; // Index of the first pursuit point of the leg
+  uint32_t end_i;   // Index of the last pursuit point of the leg
+  double start_s;   // Arc length at the start of the leg, in meters
+  double end_s;     // Arc length at the end of the leg, in meters
+  int direction;    // 1 if the robot drives forward, -1 if in reverse
+  pursuitLeg(uint32_t start_i = 0, uint32_t end_i = 0, double start_s = 0,
+             double end_s = 0, int direction = 1)
+      : start_i(start_i), end_i(end_i), start_s(start_s), end_s(end_s),
+        direction(direction) {}
 };
 
 class PurePursuitPath {
@@ -87,12 +137,46 @@ private:
   double landing_strip;
   double push_back_distance = 0;
 
+  pathrepresentation path_representation;
+  pathplanner path_planner;
+  double smoothing_length;
+  ReedsSheppPath rs_path;
+  double sample_offset = 0; // Arc length of the sub-path being sampled
+  size_t current_leg = 0;
+
+  // The first checkpoint the robot has not passed. It only moves forward, so
+  // each estimate looks at the few checkpoints around it instead of all
+  size_t next_checkpoint = 0;
+  double progress_start_time = -1; // Time of the first estimate, in seconds
+
+  void extend_leg(uint32_t i, double s, int direction);
+  void reset_progress();
+  void pass_checkpoints(double closest_s, size_t closest_i);
+  double sampled_curvature(size_t i) const; // Circle through i - 1, i, i + 1
+  // The stations, curvatures and cusps a velocity profile is generated from
+  void profile_stations(std::vector<double> *stations,
+                        std::vector<double> *curvatures,
+                        std::vector<double> *stops) const;
   void initializeWaypoints(std::vector<TwoDPose> waypoints);
   void computeDubinsPath();
+  void smoothPath();
+
+  // The path file format (PathFile.hpp) saves and restores the private state
+  friend std::vector<uint8_t> serialize_path(const PurePursuitPath &path);
+  friend bool deserialize_path(const uint8_t *data, size_t size,
+                               PurePursuitPath &path);
 
 public:
   std::vector<barebonesPose> pursuit_points;
   std::vector<pursuitCheckpoint> pursuit_checkpoints;
+  std::vector<pursuitLeg> pursuit_legs;
+
+  // When the robot passed each checkpoint, in seconds since the first
+  // calculate_pursuit_estimate of the path, or -1 if it has not yet. Useful
+  // for profiling where the time of a path is spent
+  std::vector<double> checkpoint_arrival_times;
+  AnalyticPath analytic_path;
+  VelocityProfile velocity_profile;
 
   int create_points(double q[3], double x);
 
@@ -114,10 +198,21 @@ public:
    * points mean higher detail of the path, but at a higher computational cost
    * @param landing_strip The length of the landing strip of the robot, similar
    * to that of an airport runway landing strip at the end of a move
+   * @param path_representation Set to "pathrepresentation::path_analytic" to
+   * store the path as line and arc primitives instead of sampled points
+   * @param path_planner Set to "pathplanner::planner_reeds_shepp" to allow the
+   * path to change between driving forward and in reverse
+   * @param smoothing_length The length, in meters, of the clothoids that
+   * replace each jump in curvature so the path is curvature-continuous. Set
+   * to 0 to keep the original curves
    */
   PurePursuitPath(const TwoDPose start, const TwoDPose end,
                   double turning_radius, double lookahead_distance,
-                  double num_segments = 200, double landing_strip = -1);
+                  double num_segments = 200, double landing_strip = -1,
+                  pathrepresentation path_representation =
+                      pathrepresentation::path_sampled,
+                  pathplanner path_planner = pathplanner::planner_dubins,
+                  double smoothing_length = 0);
 
   /**
    * Creates a path for pure pursuit, using Dubin-Curves. NOTE: Yaw is
@@ -135,10 +230,103 @@ public:
    * points mean higher detail of the path, but at a higher computational cost
    * @param landing_strip The length of the landing strip of the robot, similar
    * to that of an airport runway landing strip at the end of the move
+   * @param path_representation Set to "pathrepresentation::path_analytic" to
+   * store the path as line and arc primitives instead of sampled points
+   * @param path_planner Set to "pathplanner::planner_reeds_shepp" to allow the
+   * path to change between driving forward and in reverse
+   * @param smoothing_length The length, in meters, of the clothoids that
+   * replace each jump in curvature so the path is curvature-continuous. Set
+   * to 0 to keep the original curves
    */
   PurePursuitPath(std::vector<TwoDPose> waypoints, double turning_radius,
                   double lookahead_distance, double num_segments = 200,
-                  double landing_strip = -1);
+                  double landing_strip = -1,
+                  pathrepresentation path_representation =
+                      pathrepresentation::path_sampled,
+                  pathplanner path_planner = pathplanner::planner_dubins,
+                  double smoothing_length = 0);
+
+  /**
+   * Replaces the path with line and arc primitives that were generated
+   * elsewhere, such as a BakedDubinsPath (see ConstexprDubins.hpp). The path
+   * switches to the analytic representation
+   * @param primitives The primitives, one after another along the path
+   * @param num_primitives The number of primitives
+   * @param checkpoints The arc length of each checkpoint, in meters
+   * @param num_checkpoints The number of checkpoints
+   */
+  void load_primitives(const PathPrimitive *primitives, size_t num_primitives,
+                       const double *checkpoints, size_t num_checkpoints);
+
+  /**
+   * Generates the velocity profile along the path. Call after the path is
+   * constructed, and look it up with "profile_velocity"
+   * @param max_velocity The maximum velocity, in meters per second
+   * @param max_acceleration The maximum acceleration, in meters per second^2
+   * @param max_deceleration The maximum deceleration, in meters per second^2
+   * @param max_lateral_acceleration The maximum centripetal acceleration on
+   * the curves of the path, in meters per second^2
+   * @param start_velocity The velocity at the start of the path, in m/s
+   */
+  void generate_velocity_profile(double max_velocity, double max_acceleration,
+                                 double max_deceleration,
+                                 double max_lateral_acceleration,
+                                 double start_velocity = 0);
+
+  /**
+   * Generates a trajectory along the path, timed by a velocity profile with
+   * the same limits as "generate_velocity_profile". The velocity is negative
+   * on legs driven in reverse
+   * @param trajectory Where to store the trajectory
+   * @param max_velocity The maximum velocity, in meters per second
+   * @param max_acceleration The maximum acceleration, in meters per second^2
+   * @param max_deceleration The maximum deceleration, in meters per second^2
+   * @param max_lateral_acceleration The maximum centripetal acceleration on
+   * the curves of the path, in meters per second^2
+   * @param track_width The distance between the left and right wheels, in
+   * meters, so that the outer wheels stay within max_velocity on curves
+   * @param free_velocity When above 0, the acceleration falls off to 0 at
+   * this velocity, in meters per second, as the acceleration of a motor does
+   */
+  void generate_trajectory(Trajectory &trajectory, double max_velocity,
+                           double max_acceleration, double max_deceleration,
+                           double max_lateral_acceleration,
+                           double track_width = 0,
+                           double free_velocity = 0) const;
+
+  /**
+   * Looks up the velocity profile
+   * @param distance The remaining distance along the path, in meters, such as
+   * the "distance" of a PursuitEstimate
+   * @returns The profiled velocity, in meters per second, or 0 if no profile
+   * was generated
+   */
+  double profile_velocity(double distance);
+
+  /**
+   * The curvature of the path, to turn with feedforward
+   * @param distance The remaining distance along the path, in meters, such as
+   * the "distance" of a PursuitEstimate
+   * @returns The signed curvature (1/radius) of the current leg at that
+   * distance from its end, positive when turning counter-clockwise
+   */
+  double path_curvature(double distance);
+
+  /**
+   * @returns true if the robot is on the last leg of the path, meaning there
+   * are no cusps left to drive through
+   */
+  bool on_final_leg();
+
+  /**
+   * @returns The pose the path ends at
+   */
+  TwoDPose end_pose() const;
+
+  /**
+   * @returns The number of checkpoints the robot has passed
+   */
+  size_t checkpoints_passed() const;
 
   /**
    * Calculates the pure pursuit estimate relative to the path. NOTE: Yaw is
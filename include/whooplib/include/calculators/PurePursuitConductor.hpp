@@ -10,7 +10,11 @@
 #ifndef PURE_PURSUIT_CONDUCTOR_HPP
 #define PURE_PURSUIT_CONDUCTOR_HPP
 
+#include "whooplib/include/calculators/ConstexprDubins.hpp"
+#include "whooplib/include/calculators/Feedforward.hpp"
+#include "whooplib/include/calculators/HeadingOptimizer.hpp"
 #include "whooplib/include/calculators/PID.hpp"
+#include "whooplib/include/calculators/PathFollower.hpp"
 #include "whooplib/include/calculators/PurePursuit.hpp"
 #include "whooplib/include/calculators/SlewRateLimiter.hpp"
 #include "whooplib/include/calculators/TwoDPose.hpp"
@@ -47,6 +51,38 @@ struct PursuitParams {
   double forward_i_activation;
   double max_forward_voltage_change;
 
+  pathrepresentation path_representation;
+
+  double max_velocity;
+  double max_acceleration;
+  double max_deceleration;
+  double max_lateral_acceleration;
+
+  pathplanner path_planner;
+  double smoothing_length;
+
+  int heading_bins;
+  double heading_time_budget;
+
+  double left_ks;
+  double left_kv;
+  double left_ka;
+  double right_ks;
+  double right_kv;
+  double right_ka;
+  double track_width;
+
+  // How paths are followed, unless WhoopDrivetrain::use_path_follower picks
+  // another for a move, and the tuning of each follower. These are set after
+  // construction, i.e. "params.ramsete = RamseteParams(2.0, 0.7)".
+  // "pathfollower::follower_ramsete" and "pathfollower::follower_mpc" time
+  // the path with the velocity limits and track it, then settle with pure
+  // pursuit. They need left_kv and right_kv, or max_velocity, to turn
+  // velocities into voltages
+  pathfollower path_follower = pathfollower::follower_pure_pursuit;
+  RamseteParams ramsete;
+  MpcParams mpc;
+
   /**
    * @param turning_radius Radius of the turns, in meters
    * @param lookahead_distance Pure Pursuit look ahead distance, in meters
@@ -79,6 +115,44 @@ struct PursuitParams {
    * activate forward_ki
    * @param max_forward_voltage_change The maximum forward voltage change per
    * second, as a slew rate
+   * @param path_representation How generated paths are stored.
+   * "pathrepresentation::path_analytic" keeps the line and arc primitives of
+   * the Dubins curves, which makes num_path_segments only affect checkpoints
+   * @param max_velocity The velocity of the robot at forward_max_voltage, in
+   * meters per second. When above 0, a velocity profile is generated along
+   * each path, and the forward voltage is capped to follow it. Set to 0 to
+   * disable
+   * @param max_acceleration The maximum acceleration of the velocity profile,
+   * in meters per second^2
+   * @param max_deceleration The maximum deceleration of the velocity profile,
+   * in meters per second^2
+   * @param max_lateral_acceleration The maximum centripetal acceleration of the
+   * velocity profile, in meters per second^2. Slows the robot on tight turns
+   * @param path_planner The curves that connect waypoints.
+   * "pathplanner::planner_reeds_shepp" allows paths to switch between driving
+   * forward and in reverse, which is often shorter than a forward-only path
+   * @param smoothing_length The length, in meters, of the clothoids that
+   * replace each jump in curvature, such as where a straight meets a turn.
+   * Curvature-continuous paths can be followed at higher speeds. Set to 0 to
+   * disable
+   * @param heading_bins The number of headings tried at each {x, y} waypoint
+   * when picking the headings that make the shortest path. Set to 0 to have
+   * each {x, y} waypoint look at the next one instead
+   * @param heading_time_budget The longest the heading optimization may take,
+   * in seconds. If it runs out of time, the waypoints look at the next one
+   * @param left_ks The voltage to overcome the static friction of the left
+   * side of the drivetrain
+   * @param left_kv The voltage per meter per second of the left side. When
+   * left_kv and right_kv are above 0, the forward and turning voltages are
+   * mostly feedforward from a target velocity, and the PIDs only correct
+   * what is left over (see MotorFeedforward). Set to 0 to disable
+   * @param left_ka The voltage per meter per second^2 of the left side
+   * @param right_ks The voltage to overcome the static friction of the right
+   * side of the drivetrain
+   * @param right_kv The voltage per meter per second of the right side
+   * @param right_ka The voltage per meter per second^2 of the right side
+   * @param track_width The distance between the left and right wheels, in
+   * meters, to split the target velocity between the sides on turns
    */
   PursuitParams(double turning_radius = to_meters(5),
                 double lookahead_distance = to_meters(5),
@@ -93,7 +167,18 @@ struct PursuitParams {
                 double forward_ki = 0.1, double forward_kd = 250,
                 double forward_kr = 0,
                 double forward_i_activation = to_meters(2),
-                double max_forward_voltage_change = 150)
+                double max_forward_voltage_change = 150,
+                pathrepresentation path_representation =
+                    pathrepresentation::path_sampled,
+                double max_velocity = 0, double max_acceleration = 2.0,
+                double max_deceleration = 2.0,
+                double max_lateral_acceleration = 2.0,
+                pathplanner path_planner = pathplanner::planner_dubins,
+                double smoothing_length = 0, int heading_bins = 0,
+                double heading_time_budget = 0.05, double left_ks = 0,
+                double left_kv = 0, double left_ka = 0, double right_ks = 0,
+                double right_kv = 0, double right_ka = 0,
+                double track_width = to_meters(12))
       : turning_radius(turning_radius), lookahead_distance(lookahead_distance),
         num_path_segments(num_path_segments),
         forward_max_voltage(forward_max_voltage),
@@ -105,55 +190,85 @@ struct PursuitParams {
         max_turn_voltage_change(max_turn_voltage_change),
         forward_kp(forward_kp), forward_ki(forward_ki), forward_kd(forward_kd),
         forward_kr(forward_kr), forward_i_activation(forward_i_activation),
-        max_forward_voltage_change(max_forward_voltage_change) {}
-};
-
-struct PursuitResult {
-  bool is_valid;
-  double steering_angle;
-  double distance;
-  double forward_power;
-  double steering_power;
-  bool is_completed;
-  bool suggest_point_turn;
-  /**
-   * @param is_valid would be true if the pursuit estimate returned no error
-   * @param steering_angle would be the angle to turn towards for course
-   * correction in radians, counter-clockwise-positive
-   * @param distance would be the distance from the target, in meters
-   * @param forward_power the suggested motor power to go forward
-   * @param steering_power the suggestedmotor power for steering
-   * @param is_completed if true, the pure pursuit is complete
-   * @param suggest_point_turn is true when it suggests a point turn instead of
-   * swing turn
-   */
-  PursuitResult(bool is_valid = false, double steering_angle = 0,
-                double distance = 0, double forward_power = 0,
-                double steering_power = 0, bool is_completed = false,
-                bool suggest_point_turn = false)
-      : is_valid(is_valid), steering_angle(steering_angle), distance(distance),
-        forward_power(forward_power), steering_power(steering_power),
-        is_completed(is_completed), suggest_point_turn(suggest_point_turn) {}
+        max_forward_voltage_change(max_forward_voltage_change),
+        path_representation(path_representation), max_velocity(max_velocity),
+        max_acceleration(max_acceleration), max_deceleration(max_deceleration),
+        max_lateral_acceleration(max_lateral_acceleration),
+        path_planner(path_planner), smoothing_length(smoothing_length),
+        heading_bins(heading_bins), heading_time_budget(heading_time_budget),
+        left_ks(left_ks), left_kv(left_kv), left_ka(left_ka),
+        right_ks(right_ks), right_kv(right_kv), right_ka(right_ka),
+        track_width(track_width) {}
 };
 
 class PurePursuitConductor {
 
 private:
-  bool wipe_turn_once = false;
+  // The followers drive the path, PIDs and feedforward of the conductor
+  friend class PurePursuitFollower;
+  friend class TrajectoryFollower;
+
+  // If the robot drives the whole move backwards (see "step")
+  bool reversed = false;
+
+  // The exit condition of a chained motion (see "chain"), and whether the
+  // robot has gone faster than chain_min_speed yet
+  bool chained = false;
+  double chain_exit_error = 0;
+  double chain_min_speed = 0;
+  bool chain_moved = false;
+  bool chain_has_last_pose = false;
+  TwoDPose chain_last_pose;
+
+  // The side voltages that the first step continues from (see "hand_off")
+  bool handoff_pending = false;
+  double handoff_left_power = 0, handoff_right_power = 0;
+
+  void reset_controllers(double timeout);
+  void start_loaded_path(double timeout);
+
+  /**
+   * @returns true if a chained motion has reached its exit condition
+   * @param current_pose The pose of the robot, facing the way it drives
+   * @param estimate The pursuit estimate of this step
+   * @param dt Time since the previous step, in seconds
+   */
+  bool chain_exited(const TwoDPose &current_pose,
+                    const PursuitEstimate &estimate, double dt);
+
+  /**
+   * Starts the controllers from the side voltages of hand_off, if there are
+   * any, so that the first step mixes back into them before it slews
+   * @param estimate The pursuit estimate of the first step
+   */
+  void apply_hand_off(const PursuitEstimate &estimate);
 
 public:
   PID turn_pid;
   PID forward_pid;
+  PID tracking_pid; // Corrects the distance behind the feedforward reference
+  MotorFeedforward left_feedforward;
+  MotorFeedforward right_feedforward;
+  PurePursuitFollower pure_pursuit;
+  RamseteFollower ramsete;
+  MpcFollower mpc;
   SlewRateLimiter turn_slew;
   SlewRateLimiter forward_slew;
   PurePursuitPath pursuit_path;
   TwoDPose end_position;
   PursuitParams *default_pursuit_parameters = nullptr;
 
+  // The outcome of the last heading optimization (see "heading_bins")
+  HeadingOptimizationResult heading_optimization;
+
   // If is_turn, then use turn_pose for the turn (see "generate_turn")
   bool is_turn = false;
   TwoDPose turn_pose;
 
+  // How the current path is followed. Reset to "path_follower" of the
+  // parameters by each new path, and can be changed before its first step
+  pathfollower path_follower = pathfollower::follower_pure_pursuit;
+
 public:
   bool enabled = false;
 
@@ -163,6 +278,19 @@ public:
    */
   PurePursuitConductor(PursuitParams *default_pursuit_parameters);
 
+  /**
+   * Copies the path and the state of another conductor. The followers stay
+   * with this conductor
+   * @param other The conductor to copy
+   */
+  PurePursuitConductor(const PurePursuitConductor &other);
+  PurePursuitConductor &operator=(const PurePursuitConductor &other) = default;
+
+  /**
+   * @returns The follower of "path_follower"
+   */
+  PathFollower *follower();
+
   /**
    * Generates the path for the point
    * @param start_position The TwoDPose of the start position
@@ -255,6 +383,33 @@ public:
   void generate_path(std::vector<TwoDPose> waypoints, double timeout,
                      double turning_radius, double landing_strip = -1);
 
+  /**
+   * Loads a path that was saved in the binary path file format, instead of
+   * generating one. See PathFile.hpp
+   * @param data The bytes of the path file
+   * @param timeout The timeout of the movement, in seconds
+   * @returns true if the path was loaded
+   */
+  bool load_path(const std::vector<uint8_t> &data, double timeout = -1);
+
+  /**
+   * Loads a path that was generated at compile time, instead of generating
+   * one. See ConstexprDubins.hpp
+   * @param baked The baked path
+   * @param timeout The timeout of the movement, in seconds
+   * @returns true if the path was loaded
+   */
+  template <size_t W>
+  bool load_path(const BakedDubinsPath<W> &baked, double timeout = -1) {
+    if (!baked.valid) {
+      return false;
+    }
+    pursuit_path.load_primitives(baked.primitives, baked.num_primitives,
+                                 baked.checkpoints, baked.num_checkpoints);
+    start_loaded_path(timeout);
+    return true;
+  }
+
   /**
    * Generates the turn request
    * @param turn_pose The pose of the desired turn
@@ -262,10 +417,42 @@ public:
    */
   void generate_turn(TwoDPose turn_pose, double timeout);
 
+  /**
+   * Makes the current motion complete as soon as it reaches an exit
+   * condition, instead of settling, so that the next motion can take over at
+   * speed. Applies until the next path or turn
+   * @param exit_error Exits within this distance of the end of the path, in
+   * meters, or this angle of the end of a turn, in radians
+   * @param min_speed Set above 0 to also exit once the robot, having gone
+   * faster, slows below this speed, in meters (or radians) per second
+   */
+  void chain(double exit_error, double min_speed = 0);
+
+  /**
+   * Continues the current motion from the voltages that the sides were left
+   * at by a chained motion, instead of from rest: the PIDs and slews start
+   * from the outputs that pursuit_side_powers splits into them on the first
+   * step
+   * @param left_power The voltage of the left side of the robot
+   * @param right_power The voltage of the right side of the robot
+   */
+  void hand_off(double left_power, double right_power);
+
+  /**
+   * @returns true if paths are driven with feedforward (see left_kv)
+   */
+  bool feedforward_enabled() const;
+
   /**
    * Steps the conductor
+   * @param current_pose The pose of the robot, facing the way it drives
+   * @param reversed If the robot drives the whole move backwards, so that the
+   * left and right feedforward constants swap sides
+   * @param dt Time since the previous step, in seconds. The gains are tuned
+   * for 10ms, and other steps are scaled to match
    */
-  PursuitResult step(TwoDPose current_pose);
+  PursuitResult step(TwoDPose current_pose, bool reversed = false,
+                     double dt = 0.01);
 };
 
 } // namespace whoop
@@ -0,0 +1,57 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Ramsete.hpp                                               */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  RAMSETE Trajectory Tracking Controller                    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef RAMSETE_HPP
+#define RAMSETE_HPP
+
+#include "whooplib/include/calculators/Trajectory.hpp"
+#include "whooplib/include/calculators/TwoDPose.hpp"
+
+namespace whoop {
+
+/**
+ * Follows a Trajectory with a nonlinear unicycle controller. Each step, the
+ * error between the robot and where the trajectory says it should be is
+ * turned into a corrected forward and turning velocity, which converge on
+ * the trajectory from any error smaller than half a turn.
+ *
+ *   k = 2 * zeta * sqrt(angular_velocity^2 + b * velocity^2)
+ *   v = velocity * cos(error_yaw) + k * error_forward
+ *   w = angular_velocity + k * error_yaw
+ *       + b * velocity * sin(error_yaw) / error_yaw * error_left
+ *
+ * The gains are in meters and radians. b = 2 and zeta = 0.7 are the usual
+ * starting point. A larger b holds the trajectory more tightly, which helps
+ * when the wheel velocities are only loosely controlled.
+ */
+class RamseteController {
+public:
+  double b = 2.0;    // Like a proportional gain. Higher converges faster
+  double zeta = 0.7; // Like a damping ratio, in (0, 1)
+
+  /**
+   * @param b How aggressively the robot converges on the trajectory (> 0)
+   * @param zeta The damping of the convergence, in (0, 1)
+   */
+  RamseteController(double b = 2.0, double zeta = 0.7);
+
+  /**
+   * @param pose The pose of the robot, facing the way it drives
+   * @param reference Where the trajectory says the robot should be now
+   * @param velocity Where to store the forward velocity, in m/s
+   * @param angular_velocity Where to store the turning velocity, in rad/s,
+   * counter-clockwise-positive
+   */
+  void calculate(const TwoDPose &pose, const TrajectoryState &reference,
+                 double *velocity, double *angular_velocity) const;
+};
+
+} // namespace whoop
+
+#endif // RAMSETE_HPP
@@ -0,0 +1,141 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       ReedsShepp.hpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Reeds-Shepp Curves (Forward and Reverse Motion)           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Shortest paths for a car that drives both forwards and backwards, as
+ * described in: J. A. Reeds and L. A. Shepp, "Optimal paths for a car that
+ * goes both forwards and backwards", Pacific Journal of Mathematics, 1990.
+ *
+ * The API mirrors Dubins.hpp, so a Reeds-Shepp path can be used wherever a
+ * Dubins path is sampled. Unlike Dubins, each segment also has a direction
+ * of travel, and the path may contain cusps where the direction changes.
+ */
+#ifndef REEDS_SHEPP_HPP
+#define REEDS_SHEPP_HPP
+
+#include "whooplib/include/calculators/Dubins.hpp"
+
+namespace whoop {
+
+typedef enum {
+  RS_NOP = 0,
+  RS_LEFT = 1,
+  RS_STRAIGHT = 2,
+  RS_RIGHT = 3
+} ReedsSheppSegmentType;
+
+typedef struct {
+  /* the initial configuration */
+  double qi[3];
+  /* the signed, normalized lengths of the five segments. Negative is reverse
+   */
+  double param[5];
+  /* model forward velocity / model angular velocity */
+  double rho;
+  /* the path type described, an index into the Reeds-Shepp words */
+  int type;
+} ReedsSheppPath;
+
+/**
+ * Generate the shortest Reeds-Shepp path from an initial configuration to
+ * a target configuration, with a specified turning radius
+ *
+ * A configuration is (x, y, theta), where theta is in radians, the same as
+ * dubins_shortest_path
+ *
+ * @param path  - the resultant path
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle
+ * @return      - non-zero on error
+ */
+int reeds_shepp_shortest_path(ReedsSheppPath *path, double q0[3],
+                              double q1[3], double rho);
+
+/**
+ * Calculate the length of an initialised path, counting reverse segments as
+ * positive distance
+ *
+ * @param path - the path to find the length of
+ */
+double reeds_shepp_path_length(ReedsSheppPath *path);
+
+/**
+ * Return the length of a specific segment in an initialized path
+ *
+ * @param path - the path to find the length of
+ * @param i    - the segment you to get the length of (0-4)
+ */
+double reeds_shepp_segment_length(ReedsSheppPath *path, int i);
+
+/**
+ * Return the turn of a specific segment in an initialized path
+ *
+ * @param path - an initialised path
+ * @param i    - the segment (0-4)
+ * @return     - one of RS_NOP, RS_LEFT, RS_STRAIGHT or RS_RIGHT
+ */
+ReedsSheppSegmentType reeds_shepp_segment_type(ReedsSheppPath *path, int i);
+
+/**
+ * Return the direction of travel of a specific segment in an initialized path
+ *
+ * @param path - an initialised path
+ * @param i    - the segment (0-4)
+ * @return     - 1 for forward, -1 for reverse, 0 for an empty segment
+ */
+int reeds_shepp_segment_direction(ReedsSheppPath *path, int i);
+
+/**
+ * Return the direction of travel at a length measure along the path
+ *
+ * @param path - an initialised path
+ * @param t    - a length measure, where 0 <= t <= reeds_shepp_path_length
+ * @return     - 1 for forward, -1 for reverse
+ */
+int reeds_shepp_direction_at(ReedsSheppPath *path, double t);
+
+/**
+ * Calculate the configuration along the path, using the parameter t. The
+ * angle of the configuration is the heading of the vehicle, even when it is
+ * travelling in reverse
+ *
+ * @param path - an initialised path
+ * @param t    - a length measure, where 0 <= t <= reeds_shepp_path_length
+ * @param q    - the configuration result
+ * @returns    - non-zero if 't' is not in the correct range
+ */
+int reeds_shepp_path_sample(ReedsSheppPath *path, double t, double q[3]);
+
+/**
+ * Walk along the path at a fixed sampling interval, calling the
+ * callback function at each interval
+ *
+ * @param path      - the path to sample
+ * @param stepSize  - the distance along the path for subsequent samples
+ * @param cb        - the callback function to call for each sample
+ * @param user_data - optional information to pass on to the callback
+ *
+ * @returns - zero on successful completion, or the result of the callback
+ */
+int reeds_shepp_path_sample_many(ReedsSheppPath *path, double stepSize,
+                                 DubinsPathSamplingCallback cb,
+                                 void *user_data);
+
+/**
+ * Convenience function to identify the endpoint of a path
+ *
+ * @param path - an initialised path
+ * @param q    - the configuration result
+ */
+int reeds_shepp_path_endpoint(ReedsSheppPath *path, double q[3]);
+
+} // namespace whoop
+
+#endif // REEDS_SHEPP_HPP
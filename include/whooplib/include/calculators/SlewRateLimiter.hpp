@@ -16,7 +16,8 @@ namespace whoop {
 
 /**
  * General-use Slew class for motor voltage.
- * The default update period is 10ms or 100Hz
+ * The default update period is 10ms or 100Hz, and a step can be given the
+ * time it actually took instead
  */
 class SlewRateLimiter {
 public:
@@ -34,7 +35,26 @@ public:
    */
   double step(double desired_output);
 
+  /**
+   * Steps the slew rate limiter over a step of a given length
+   * @param desired_output Difference in desired and current position
+   * @param dt Time since the previous step, in seconds
+   * @return Output power
+   */
+  double step(double desired_output, double dt);
+
+  /**
+   * Restarts the slew from an output, such as 0 when the motors stopped
+   * @param output The output to slew from
+   */
+  void reset(double output = 0);
+
 private:
+  /**
+   * Moves the output toward the desired output by at most max_change
+   */
+  double limit(double desired_output, double max_change);
+
   double max_slew_rate;
   double step_time_milliseconds;
   double max_slew_rate_scaled;
@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Trajectory.hpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Time-Parameterized Trajectory Along a Path                */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include <vector>
+
+namespace whoop {
+
+/**
+ * Where the robot should be at a point in time, and how it should be moving
+ */
+struct TrajectoryState {
+  double time;             // Seconds since the start of the trajectory
+  double x, y, yaw;        // The pose, facing the way the robot drives
+  double velocity;         // m/s, negative when driving in reverse
+  double angular_velocity; // rad/s, counter-clockwise-positive
+  double acceleration;     // m/s^2, of the velocity
+
+  TrajectoryState(double time = 0, double x = 0, double y = 0, double yaw = 0,
+                  double velocity = 0, double angular_velocity = 0,
+                  double acceleration = 0)
+      : time(time), x(x), y(y), yaw(yaw), velocity(velocity),
+        angular_velocity(angular_velocity), acceleration(acceleration) {}
+};
+
+/**
+ * A path with a velocity at each point, turned into the time the robot
+ * reaches each point. Trajectory trackers (see RamseteController) follow it
+ * by looking up where the robot should be now, instead of chasing a point
+ * ahead like pure pursuit.
+ */
+class Trajectory {
+public:
+  std::vector<TrajectoryState> states;
+
+  /**
+   * Removes the trajectory
+   */
+  void clear();
+
+  /**
+   * @returns true if no trajectory has been generated
+   */
+  bool empty() const;
+
+  /**
+   * Generates the trajectory. The time between two poses is the distance
+   * between them over the average of their velocities
+   * @param poses The poses along the path, facing the way the robot drives
+   * @param stations The arc length of each pose, in meters
+   * @param velocities The velocity at each pose, in m/s, negative when
+   * driving in reverse (such as from a VelocityProfile)
+   * @param max_acceleration The acceleration, in m/s^2, used to time
+   * sections where the velocity is 0 at both ends
+   */
+  void generate(const std::vector<TwoDPose> &poses,
+                const std::vector<double> &stations,
+                const std::vector<double> &velocities,
+                double max_acceleration);
+
+  /**
+   * @returns The time it takes to follow the trajectory, in seconds
+   */
+  double duration() const;
+
+  /**
+   * Interpolates the trajectory at a point in time. The time is clamped to
+   * the trajectory, so the end is held once it is over
+   * @param time Seconds since the start of the trajectory
+   * @returns The state at that time
+   */
+  TrajectoryState sample(double time) const;
+};
+
+} // namespace whoop
+
+#endif // TRAJECTORY_HPP
@@ -0,0 +1,134 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Transform2D.hpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Two-Dimensional Transforms With a Cached Rotation         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef TRANSFORM_2D_HPP
+#define TRANSFORM_2D_HPP
+
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include <cstddef>
+
+namespace whoop {
+
+/**
+ * A TwoDPose that keeps the cosine and sine of its yaw. Use it for a transform
+ * that is applied many times (like a fixed sensor offset, or a tare), so that
+ * the trigonometry is done once instead of on every toWorldSpace and
+ * toObjectSpace.
+ *
+ * Composing transforms multiplies the cached rotations instead of calling sin
+ * and cos again, and adds the yaws without wrapping them. The yaw is only
+ * wrapped to [-pi, pi] when converting back to a TwoDPose, or by normalize().
+ *
+ * Follows the conventions of TwoDPose: +x is right, +y is forward, and yaw is
+ * in radians, counter-clockwise. Transform2D is double precision and
+ * Transform2Df is single precision.
+ */
+template <typename Scalar> class Transform2DT {
+public:
+  Scalar x = 0, y = 0;
+  Scalar yaw = 0; // Not wrapped to [-pi, pi] (see normalize)
+  Scalar cos_yaw = 1, sin_yaw = 0;
+
+  /**
+   * Constructs the identity transform
+   */
+  Transform2DT() = default;
+
+  /**
+   * @param x The x-coordinate of the transform, where positive values indicate
+   * rightward movement.
+   * @param y The y-coordinate of the transform, where positive values indicate
+   * forward movement.
+   * @param yaw The orientation of the transform in radians, where positive
+   * values indicate counter-clockwise rotation.
+   */
+  Transform2DT(Scalar x, Scalar y, Scalar yaw);
+
+  /**
+   * @param pose The pose to cache the rotation of
+   */
+  explicit Transform2DT(const TwoDPoseT<Scalar> &pose);
+
+  /**
+   * Same as TwoDPose::toWorldSpace, without calling sin or cos
+   * @param pose A pose relative to this transform
+   * @returns The pose in world space, with the yaw in [-pi, pi]
+   */
+  TwoDPoseT<Scalar> to_world_space(const TwoDPoseT<Scalar> &pose) const;
+
+  /**
+   * Same as TwoDPose::toObjectSpace, without calling sin or cos
+   * @param pose A pose in world space
+   * @returns The pose relative to this transform, with the yaw in [-pi, pi]
+   */
+  TwoDPoseT<Scalar> to_object_space(const TwoDPoseT<Scalar> &pose) const;
+
+  /**
+   * Same as to_object_space, for a transform. The rotations are combined
+   * without calling sin or cos, and the yaw is not wrapped
+   * @param other A transform in world space
+   * @returns The transform relative to this transform
+   */
+  Transform2DT to_object_space(const Transform2DT &other) const;
+
+  /**
+   * Composes two transforms, like TwoDPose's * operator. The rotations are
+   * combined without calling sin or cos, and the yaw is not wrapped
+   * @param other A transform relative to this transform
+   * @returns The transform in world space
+   */
+  Transform2DT operator*(const Transform2DT &other) const;
+  Transform2DT &operator*=(const Transform2DT &other);
+
+  /**
+   * @returns The transform that undoes this one, so that
+   * transform * transform.inverse() is the identity
+   */
+  Transform2DT inverse() const;
+
+  /**
+   * Applies the transform to many points at once, the same as to_world_space
+   * on each one.
+   * @param points The points relative to this transform, as x0, y0, x1, y1...
+   * @param count The number of points
+   * @param out Where to write the points in world space (can be points)
+   */
+  void to_world_space(const Scalar *points, size_t count, Scalar *out) const;
+
+  /**
+   * Applies the inverse of the transform to many points at once, the same as
+   * to_object_space on each one.
+   * @param points The points in world space, as x0, y0, x1, y1...
+   * @param count The number of points
+   * @param out Where to write the relative points (can be points)
+   */
+  void to_object_space(const Scalar *points, size_t count, Scalar *out) const;
+
+  /**
+   * Wraps the yaw to [-pi, pi], and rescales the cached rotation to remove
+   * the rounding errors built up by composing many transforms
+   */
+  void normalize();
+
+  /**
+   * @returns The transform as a pose, with the yaw in [-pi, pi]
+   */
+  TwoDPoseT<Scalar> to_pose() const;
+};
+
+// Compiled in Transform2D.cpp
+extern template class Transform2DT<double>;
+extern template class Transform2DT<float>;
+
+typedef Transform2DT<double> Transform2D;
+typedef Transform2DT<float> Transform2Df;
+
+} // namespace whoop
+
+#endif // TRANSFORM_2D_HPP
@@ -25,10 +25,14 @@ namespace whoop {
  *
  * If you know CFrames in Roblox, this library should be very easy to
  * understand: https://create.roblox.com/docs/reference/engine/datatypes/CFrame
+ *
+ * Scalar is the precision of the pose. TwoDPose is double precision, and
+ * TwoDPosef is single precision, which is faster on the V5 brain at the cost
+ * of accuracy.
  */
-class TwoDPose {
+template <typename Scalar> class TwoDPoseT {
 public:
-  double x, y, yaw; // X and Y positions, and yaw (orientation) in radians.
+  Scalar x, y, yaw; // X and Y positions, and yaw (orientation) in radians.
 
   /**
    * Constructs a TwoDPose object representing a position and orientation in 2D
@@ -40,7 +44,16 @@ public:
    * @param yaw The orientation of the pose in radians, where positive values
    * indicate counter-clockwise rotation.
    */
-  TwoDPose(double x = 0, double y = 0, double yaw = 0);
+  TwoDPoseT(Scalar x = 0, Scalar y = 0, Scalar yaw = 0);
+
+  /**
+   * Converts a pose from another precision
+   * @param other The pose to convert
+   */
+  template <typename Other>
+  explicit TwoDPoseT(const TwoDPoseT<Other> &other)
+      : x(static_cast<Scalar>(other.x)), y(static_cast<Scalar>(other.y)),
+        yaw(static_cast<Scalar>(other.yaw)) {}
 
   // Overloaded * operator to combine two poses
   // Think of it as Roblox's CF = CFrame1 * CFrame2
@@ -52,7 +65,7 @@ public:
    * @param other Another TwoDPose to combine with this pose.
    * @return A new TwoDPose representing the combined transformation.
    */
-  TwoDPose operator*(const TwoDPose &other) const;
+  TwoDPoseT operator*(const TwoDPoseT &other) const;
 
   // This allows for *= as well
   /**
@@ -60,7 +73,7 @@ public:
    * @param other Another TwoDPose whose transformation is applied to this pose.
    * @return A reference to this pose after the transformation.
    */
-  TwoDPose &operator*=(const TwoDPose &other);
+  TwoDPoseT &operator*=(const TwoDPoseT &other);
 
   // Returns a TwoDPose that represents the delta change applied to the *=,
   // relative to the first TwoDPose
@@ -71,7 +84,7 @@ public:
    * @param other The pose to which the transformation is calculated.
    * @return A TwoDPose representing the required transformation.
    */
-  TwoDPose global_xy_delta_only(const TwoDPose &other) const;
+  TwoDPoseT global_xy_delta_only(const TwoDPoseT &other) const;
 
   // Method to compute the relative pose
   // Think of it as Roblox's CFrame1:ToObjectSpace(CFrame2)
@@ -84,7 +97,7 @@ public:
    * @param other The pose to transform into this pose's coordinate space.
    * @return A new TwoDPose representing the pose relative to this pose.
    */
-  TwoDPose toObjectSpace(const TwoDPose &other) const;
+  TwoDPoseT toObjectSpace(const TwoDPoseT &other) const;
 
   // Method to retreive world space from object space
   // Example of getting object space:
@@ -101,10 +114,10 @@ public:
    * back to global space.
    * @return A new TwoDPose representing the pose in global coordinates.
    */
-  TwoDPose toWorldSpace(const TwoDPose &other) const;
+  TwoDPoseT toWorldSpace(const TwoDPoseT &other) const;
 
   // Unary negation operator
-  TwoDPose operator-() const;
+  TwoDPoseT operator-() const;
 
   // Method to compute relative pose of just given x y and yaw.
   // This is useful for tare.
@@ -117,7 +130,7 @@ public:
    * @param yaw Orientation in radians to transform.
    * @return A new TwoDPose representing the transformed coordinates.
    */
-  TwoDPose toObjectSpace(double x, double y, double yaw) const;
+  TwoDPoseT toObjectSpace(Scalar x, Scalar y, Scalar yaw) const;
 
   /**
    * Returns a pose with the same x and y, but with the yaw turned to face the
@@ -125,7 +138,7 @@ public:
    * @param target_x the x position to look at
    * @param target_y the y position to look at
    */
-  TwoDPose lookAt(double target_x, double target_y);
+  TwoDPoseT lookAt(Scalar target_x, Scalar target_y);
 
   /**
    * Returns a string representation of the pose with the coordinates rounded to
@@ -148,6 +161,13 @@ public:
   std::string to_realsense_string(int decimal_places = 4);
 };
 
+// Compiled in TwoDPose.cpp
+extern template class TwoDPoseT<double>;
+extern template class TwoDPoseT<float>;
+
+typedef TwoDPoseT<double> TwoDPose;
+typedef TwoDPoseT<float> TwoDPosef;
+
 } // namespace whoop
 
 #endif // TWODPOSE_HPP
@@ -0,0 +1,96 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       VelocityProfile.hpp                                       */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Curvature-Constrained Velocity Profile Along a Path       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifndef VELOCITY_PROFILE_HPP
+#define VELOCITY_PROFILE_HPP
+
+#include <vector>
+
+namespace whoop {
+
+/**
+ * Time-optimal velocity along the arc length of a path, subject to a maximum
+ * velocity, acceleration, deceleration, and lateral (centripetal)
+ * acceleration on curves.
+ */
+class VelocityProfile {
+public:
+  std::vector<double> stations;   // Arc length of each station, in meters
+  std::vector<double> velocities; // Velocity at each station, in m/s
+
+  /**
+   * Removes the profile
+   */
+  void clear();
+
+  /**
+   * @returns true if no profile has been generated
+   */
+  bool empty() const;
+
+  /**
+   * Generates the profile
+   * @param stations Increasing arc lengths along the path, in meters
+   * @param curvatures The curvature (1/radius) of the path at each station
+   * @param max_velocity The maximum velocity, in meters per second
+   * @param max_acceleration The maximum acceleration, in meters per second^2
+   * @param max_deceleration The maximum deceleration, in meters per second^2
+   * @param max_lateral_acceleration The maximum centripetal acceleration on
+   * curves, in meters per second^2. Set to 0 or below to ignore curvature
+   * @param start_velocity The velocity at the first station, in m/s
+   * @param end_velocity The velocity at the last station, in m/s
+   * @param stops Arc lengths where the velocity must reach 0, such as the
+   * cusps of a path that changes direction
+   * @param track_width The distance between the left and right wheels, in
+   * meters. When above 0, curves are slowed so that the outer wheels stay
+   * within max_velocity
+   */
+  void generate(const std::vector<double> &stations,
+                const std::vector<double> &curvatures, double max_velocity,
+                double max_acceleration, double max_deceleration,
+                double max_lateral_acceleration, double start_velocity = 0,
+                double end_velocity = 0,
+                const std::vector<double> &stops = {},
+                double track_width = 0);
+
+  /**
+   * Slows the profile where motors could not keep up with its acceleration.
+   * The acceleration of a motor falls off linearly to 0 at its free velocity
+   * (see MotorFeedforward), so it is limited to
+   *
+   *   acceleration * (1 - velocity / free_velocity)
+   *
+   * @param acceleration The acceleration from rest, in meters per second^2
+   * @param free_velocity The velocity where the acceleration reaches 0, in
+   * meters per second
+   */
+  void limit_motor_acceleration(double acceleration, double free_velocity);
+
+  /**
+   * @returns The arc length of the last station, in meters
+   */
+  double length() const;
+
+  /**
+   * Linearly interpolates the velocity at a given arc length. The arc length
+   * is clamped to the bounds of the profile.
+   * @param s Arc length along the path, in meters
+   * @returns The velocity, in meters per second
+   */
+  double velocity_at(double s) const;
+
+  /**
+   * @returns The time it takes to follow the profile, in seconds
+   */
+  double duration() const;
+};
+
+} // namespace whoop
+
+#endif // VELOCITY_PROFILE_HPP
@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       VoltageTable.hpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Characterized Voltage Lookup Table for Linear Motors      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * A motor does not spin at a speed proportional to its voltage: it does not
+ * move at all until the voltage overcomes friction, and the load bends the
+ * rest of the curve. A VoltageTable is built from a sweep of voltages against
+ * the velocities they were measured to drive at, and turns a voltage into the
+ * voltage that drives at that fraction of the top speed:
+ *
+ *   velocity(table.lookup(volts)) = volts / 12 * velocity(12)
+ *
+ * The table has SIZE entries for each direction, evenly spaced from 0 to 12
+ * volts, so a lookup is an index and a linear interpolation.
+ *
+ * Tables can be saved as a binary file, which is a fixed-size header followed
+ * by the tables exactly as they are laid out in memory:
+ *
+ *   VoltageTableFileHeader
+ *   tables               num_tables x VoltageTable
+ */
+#ifndef VOLTAGE_TABLE_HPP
+#define VOLTAGE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace whoop {
+
+const uint32_t VOLTAGE_TABLE_MAGIC = 0x4C545657; // "WVTL"
+const uint16_t VOLTAGE_TABLE_VERSION = 1;
+
+class VoltageTable {
+public:
+  static constexpr int SIZE = 17; // Entries for each direction
+
+  // The voltage that drives at i / (SIZE - 1) of the top speed, forward and
+  // backward (both stored as positive voltages)
+  float forward[SIZE];
+  float backward[SIZE];
+
+  /**
+   * A table that leaves voltages as they are
+   */
+  VoltageTable();
+
+  /**
+   * Builds the table from a sweep. Each direction needs a voltage that moved
+   * the motor, and the largest voltage of each direction is its top speed
+   * (so the sweep should reach 12 volts)
+   * @param voltages The voltages of the sweep, forward positive
+   * @param velocities The velocity measured at each voltage, in any units
+   * @returns false if a direction did not move, leaving the table as it was
+   */
+  bool build(const std::vector<double> &voltages,
+             const std::vector<double> &velocities);
+
+  /**
+   * @param volts The voltage to drive at (-12.0 to 12.0), as a fraction of
+   * the top speed
+   * @returns The voltage that drives the motor at that fraction
+   */
+  double lookup(double volts) const {
+    const float *entries = forward;
+    double sign = 1;
+    if (volts < 0) {
+      entries = backward;
+      sign = -1;
+      volts = -volts;
+    }
+    double index = volts * ((SIZE - 1) / 12.0);
+    if (index >= SIZE - 1) {
+      return sign * entries[SIZE - 1];
+    }
+    int i = static_cast<int>(index);
+    double t = index - i;
+    return sign * (entries[i] + (entries[i + 1] - entries[i]) * t);
+  }
+};
+
+struct VoltageTableFileHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_size;
+  uint16_t table_size; // VoltageTable::SIZE
+  uint16_t num_tables;
+  uint32_t reserved;
+};
+
+/**
+ * Writes tables into the binary voltage table file format
+ * @param tables The tables, such as one for each side of a drivetrain
+ * @returns The bytes of the file
+ */
+std::vector<uint8_t>
+serialize_voltage_tables(const std::vector<VoltageTable> &tables);
+
+/**
+ * Reads tables from the binary voltage table file format. The tables are
+ * left untouched if the data is not a valid file of the current version
+ * @param data The bytes of the file
+ * @param size The number of bytes
+ * @param tables The tables to load into
+ * @returns true if the tables were loaded
+ */
+bool deserialize_voltage_tables(const uint8_t *data, size_t size,
+                                std::vector<VoltageTable> &tables);
+
+} // namespace whoop
+
+#endif // VOLTAGE_TABLE_HPP
@@ -40,21 +40,22 @@
 namespace whoop {
 
 /**
- * Wheel Odometry Object
+ * Wheel Odometry Object. Scalar is the precision of the tracking: WheelOdom is
+ * double precision and WheelOdomf is single precision
  */
-class WheelOdom {
+template <typename Scalar> class WheelOdomT {
 private:
-  double tare_angle{0.0}; // Stores the initial gyro angle for taring
-  double last_forward_tracker_pos{0.0};
-  double last_sideways_tracker_pos{0.0};
-  double forward_tracker_center_distance{0.0};
-  double sideways_tracker_center_distance{0.0};
+  Scalar tare_angle{0.0}; // Stores the initial gyro angle for taring
+  Scalar last_forward_tracker_pos{0.0};
+  Scalar last_sideways_tracker_pos{0.0};
+  Scalar forward_tracker_center_distance{0.0};
+  Scalar sideways_tracker_center_distance{0.0};
 
 public:
-  double X_position{0.0};
-  double Y_position{0.0};
-  double orientation_rad{0.0};
-  WheelOdom() = default;
+  Scalar X_position{0.0};
+  Scalar Y_position{0.0};
+  Scalar orientation_rad{0.0};
+  WheelOdomT() = default;
 
   /**
    * Setter method for tracker center distances.
@@ -70,7 +71,7 @@ public:
    * @param orientation The desired yaw position to start at (radians,
    * counter-clockwise)
    */
-  void set_position(double x, double y, double orientation);
+  void set_position(Scalar x, Scalar y, Scalar orientation);
 
   /**
    * Resets the position, including tracking wheels.
@@ -83,8 +84,8 @@ public:
    * @param gyro_angle_rad Current angle of the gyroscope (radians,
    * counter-clockwise positive)
    */
-  void update_pose(double forward_tracker_pos, double sideways_tracker_pos,
-                   double gyro_angle_rad);
+  void update_pose(Scalar forward_tracker_pos, Scalar sideways_tracker_pos,
+                   Scalar gyro_angle_rad);
 
   /**
    * Does the odometry math to update position
@@ -101,11 +102,18 @@ public:
    * tracker, in meters (positive implies a shift forward from the odom unit
    * center).
    */
-  void set_physical_distances(double forward_distance,
-                              double sideways_distance);
+  void set_physical_distances(Scalar forward_distance,
+                              Scalar sideways_distance);
   ;
 };
 
+// Compiled in WheelOdom.cpp
+extern template class WheelOdomT<double>;
+extern template class WheelOdomT<float>;
+
+typedef WheelOdomT<double> WheelOdom;
+typedef WheelOdomT<float> WheelOdomf;
+
 } // namespace whoop
 
 #endif // WHEEL_ODOM_HPP
\ No newline at end of file
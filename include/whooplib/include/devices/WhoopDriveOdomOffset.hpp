@@ -10,6 +10,7 @@
 #ifndef WHOOP_DRIVE_ODOM_OFFSET_HPP
 #define WHOOP_DRIVE_ODOM_OFFSET_HPP
 
+#include "whooplib/include/calculators/Transform2D.hpp"
 #include "whooplib/include/calculators/TwoDPose.hpp"
 #include "whooplib/include/devices/WhoopDriveOdomUnit.hpp"
 #include "whooplib/include/nodes/NodeManager.hpp"
@@ -42,12 +43,26 @@ public:
 
   TwoDPose pose = TwoDPose(0, 0, 0);
   TwoDPose last_pose = TwoDPose(0, 0, 0);
-  TwoDPose offset;
+  TwoDPose offset; // Set by the constructor (see negative_offset)
   WhoopMutex
       thread_lock; // Mutex for synchronizing access to odometry components.
 
   bool is_clean = false;
 
+private:
+  // The pose and last pose with their rotations cached, so the offset of
+  // get_velocity_vector is applied without calling sin or cos again
+  Transform2D pose_transform;
+  Transform2D last_pose_transform;
+  bool pose_transform_cached = true;
+  bool last_pose_transform_cached = true;
+
+  double pose_dt = 0.01; // Seconds between last_pose and pose
+
+  // -offset, which is applied to the odom unit pose every step
+  Transform2D negative_offset;
+
+public:
   /**
    * Constructor for Drive Odom Offset.
    * The odom unit center is the virtual intercept of the perpendicular faces of
@@ -108,6 +123,11 @@ public: // This is one of the ONLY exceptions to be public, as another module
   void __step_down(); // This steps down to the Odom Unit (meant to be managed
                       // by drivetrain or fusion object)
   void __step() override; // Protected helper function for processing steps
+
+private:
+  // Updates pose and pose_transform from the odom unit. Call with the
+  // thread_lock locked
+  void update_pose();
 };
 
 } // namespace whoop
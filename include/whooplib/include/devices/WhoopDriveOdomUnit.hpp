@@ -31,6 +31,25 @@ enum class DriveOdomConfig {
   DRIVE_WITH_BOTH_TRACKERS,
 };
 
+/**
+ * Every sensor of the odometry unit, read once on a step. Sensors the unit
+ * does not have read as 0
+ */
+struct SensorSnapshot {
+  double time = 0;              // Seconds on the brain's clock, when read
+  double left_distance = 0;     // Meters, of the left motor group
+  double left_velocity = 0;     // Radians/sec, of the left motor group
+  double right_distance = 0;    // Meters, of the right motor group
+  double right_velocity = 0;    // Radians/sec, of the right motor group
+  double forward_distance = 0;  // Meters, of the forward tracker
+  double forward_velocity = 0;  // Radians/sec, of the forward tracker
+  double sideways_distance = 0; // Meters, of the sideways tracker
+  double sideways_velocity = 0; // Radians/sec, of the sideways tracker
+  double yaw = 0;               // Radians, counter-clockwise
+  double roll = 0;              // Radians
+  double pitch = 0;             // Radians
+};
+
 /**
  * Class responsible for managing the odometry unit.
  */
@@ -71,6 +90,8 @@ private:
    */
   void set_motor_wheel_diameter(double diameter_meters);
 
+  SensorSnapshot snapshot; // Read at the start of each step
+
 public:
   WhoopInertial *inertial_sensor;
 
@@ -218,9 +239,20 @@ public:
   void tare(double x, double y, double yaw);
   void tare();
 
-  // Returns true if the system is moving
+  // Returns true if the system is moving, as of the last step
   bool is_moving(double rads_s_threshold = 0.02);
 
+  /**
+   * Reads every sensor once into the snapshot, which is_moving and
+   * get_snapshot return until the next read. Each step reads them first
+   */
+  void read_sensors();
+
+  /**
+   * @returns Every sensor, as read on the last step
+   */
+  SensorSnapshot get_snapshot();
+
   /**
    * Retrieves the corrected and computed pose.
    * @return The current pose of the system.
@@ -10,7 +10,9 @@
 #ifndef WHOOP_DRIVETRAIN_HPP
 #define WHOOP_DRIVETRAIN_HPP
 
+#include "whooplib/include/calculators/DriveMixer.hpp"
 #include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/calculators/VoltageTable.hpp"
 #include "whooplib/include/calculators/WheelOdom.hpp"
 #include "whooplib/include/devices/WhoopController.hpp"
 #include "whooplib/include/devices/WhoopMotor.hpp"
@@ -79,6 +81,22 @@ private:
   bool auton_traveling = false;
   bool auton_reverse = false;
   bool request_reverse = false;
+  bool request_path_follower = false;
+  pathfollower requested_path_follower = pathfollower::follower_pure_pursuit;
+  bool request_chain = false;
+  double requested_chain_exit_error = 0;
+  double requested_chain_min_speed = 0;
+
+  // Set when a chained motion completes, until the next motion takes over
+  // from the voltages it left the sides at
+  bool chain_handoff = false;
+  double chain_handoff_time = 0; // Seconds
+  double last_left_voltage = 0, last_right_voltage = 0;
+
+  // The characterized voltages of each side (see characterize_motors)
+  VoltageTable left_voltage_table, right_voltage_table;
+  bool has_voltage_tables = false;
+  bool characterizing = false;
 
 protected:
   // Upon initialization
@@ -95,6 +113,8 @@ protected:
 
   PurePursuitConductor pursuit_conductor;
 
+  DriveMixer mixer; // Every voltage to the sides goes through it
+
   bool autonomous_driving = false;
 
   PursuitResult pursuit_result;
@@ -114,6 +134,25 @@ private:
   bool using_degrees();
   bool using_clockwise();
 
+  // Starts driving a path that the conductor loaded instead of generated
+  void start_loaded_path();
+
+  // Gives the path follower of use_path_follower to the new path
+  void apply_requested_path_follower();
+
+  // Spins each side at a voltage, through the mixer
+  void spin_sides(double left_voltage, double right_voltage);
+
+  // Stops both sides
+  void stop_sides();
+
+  // Gives the exit condition of chain to the new motion, and continues it
+  // from the motors of a chained motion
+  void apply_chain(bool is_turn);
+
+  // Spins the sides through their voltage tables, if they are characterized
+  void apply_voltage_tables();
+
 public:
   bool temp_disable = false; // Set to true to temp disable drivetrain
 
@@ -233,6 +272,123 @@ public:
                           double turning_radius = -1,
                           double landing_strip = -1);
 
+  /**
+   * Drives a path that was saved to the SD card in the binary path file
+   * format (see PathFile.hpp), instead of generating it. The path is driven
+   * as saved, in meters and counter-clockwise radians, so it should start
+   * near the current pose of the robot
+   * @param filename The file to load (i.e. "path.bin")
+   * @param timeout_seconds The timeout of the movement, in seconds
+   * @returns true if the path was loaded
+   */
+  bool drive_through_path_file(std::string filename,
+                               double timeout_seconds = -1);
+
+  /**
+   * Drives a path that was generated at compile time (see
+   * ConstexprDubins.hpp). The path is driven as baked, in meters and
+   * counter-clockwise radians, so it should start near the current pose of
+   * the robot
+   * @param baked The baked path
+   * @param timeout_seconds The timeout of the movement, in seconds
+   * @returns true if the path was loaded
+   */
+  template <size_t W>
+  bool drive_through_baked_path(const BakedDubinsPath<W> &baked,
+                                double timeout_seconds = -1) {
+    this->wait_until_completed(); // Wait before loading path
+    if (!pursuit_conductor.load_path(baked, timeout_seconds)) {
+      return false;
+    }
+    start_loaded_path();
+    return true;
+  }
+
+  /**
+   * Saves the last generated path to the SD card in the binary path file
+   * format, so it can be driven later with drive_through_path_file
+   * @param filename The file to save to (i.e. "path.bin")
+   * @returns true if the path was saved
+   */
+  bool save_path_file(std::string filename);
+
+  /**
+   * Sets how the next path is followed, instead of the "path_follower" of the
+   * pursuit parameters. Only applies to the next path
+   * @param follower i.e. "pathfollower::follower_ramsete"
+   */
+  void use_path_follower(pathfollower follower);
+
+  /**
+   * @returns The result of the last autonomous step of the conductor, such as
+   * how long the MPC took to plan it (solve_time) and whether it ran out of
+   * time and fell back to pure pursuit (fell_back)
+   */
+  PursuitResult get_pursuit_result();
+
+  /**
+   * Chains the next motion into the one after it. Instead of settling, it
+   * completes as soon as it reaches an exit condition and leaves the motors
+   * driving, and the motion after it continues from their voltages instead
+   * of from rest. Only applies to the next motion:
+   *
+   *   robot_drivetrain.chain(3); // Within 3 inches of the end
+   *   robot_drivetrain.drive_to_point(24, 24);
+   *   robot_drivetrain.drive_to_point(48, 0);
+   *
+   * If no motion follows within half a second, the motors stop
+   * @param exit_error Exits within this distance of the end of a drive, or
+   * this angle of the end of a turn, in the configured units
+   * @param min_speed Set above 0 to also exit once the robot, having gone
+   * faster, slows below this speed (i.e. when pushed against a wall), in the
+   * configured units per second
+   */
+  void chain(double exit_error, double min_speed = 0);
+
+  /**
+   * Characterizes the motors of each side, so that they spin at a velocity
+   * proportional to their voltage (see VoltageTable.hpp), instead of through
+   * linearize_voltage. The robot turns in place while the voltage is swept up
+   * to 12 volts each way, measuring the velocity of each side. With the
+   * defaults this takes about 20 seconds. Run it in autonomous, with room to
+   * turn
+   * @param filename Set to save the tables to the SD card (i.e. "motors.bin"),
+   * to load with load_motor_characterization
+   * @param steps The number of voltages each way
+   * @param step_time Seconds at each voltage. The last third is measured
+   * @returns true if both sides moved and were characterized (and saved, if
+   * filename is set)
+   */
+  bool characterize_motors(std::string filename = "", int steps = 12,
+                           double step_time = 0.75);
+
+  /**
+   * Loads the voltage tables saved by characterize_motors
+   * @param filename The file to load (i.e. "motors.bin")
+   * @returns true if the tables were loaded
+   */
+  bool load_motor_characterization(std::string filename);
+
+  /**
+   * Sets whether the voltages to the sides are scaled by the battery voltage,
+   * so that they drive the robot the same on a full battery as on a tired one
+   * (on by default)
+   * @param enabled Set to false to command the voltages as they are
+   */
+  void set_battery_compensation(bool enabled);
+
+  /**
+   * @returns How often the voltages to the sides, in autonomous and user
+   * control, were over the limit of the motors and scaled down together
+   * since the last reset_mixer_stats
+   */
+  MixerStats get_mixer_stats();
+
+  /**
+   * Clears the statistics of get_mixer_stats
+   */
+  void reset_mixer_stats();
+
   /**
    * Drive the robot backward the respectable distance
    * @param distance The x position to travel to, in specified units configured
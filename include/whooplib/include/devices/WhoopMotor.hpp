@@ -10,6 +10,7 @@
 #ifndef WHOOP_MOTOR_HPP
 #define WHOOP_MOTOR_HPP
 
+#include "whooplib/include/calculators/VoltageTable.hpp"
 #include "whooplib/includer.hpp"
 
 namespace whoop {
@@ -40,6 +41,8 @@ class WhoopMotor : private pros::Motor {
 protected:
   double pos_offset =
       0; // Offset applied to the position readings of the motor.
+  const VoltageTable *voltage_table =
+      nullptr; // Characterized voltages, instead of linearize_voltage.
 public:
   /**
    * Constructor to initialize a motor on a specified port.
@@ -83,6 +86,14 @@ public:
   void stop_brake();                  // Stops the motor with braking.
   void stop_coast();                  // Stops the motor and allows it to coast.
 
+  /**
+   * Spins the motor through a characterized voltage table (see
+   * VoltageTable.hpp) instead of linearize_voltage, so that its velocity is
+   * proportional to the voltage. The table is not copied
+   * @param table The table, or nullptr to go back to linearize_voltage
+   */
+  void set_voltage_table(const VoltageTable *table);
+
   // Receiving rotation
   double get_rotation(); // Degrees is default
   double
@@ -49,6 +49,9 @@ protected:
   double wheel_circumference = circumference_from_diameter(wheel_diameter);
 
 public:
+  static constexpr int MAX_MOTORS = 8; // Motors a group can hold, so that
+                                       // reading them never allocates
+
   /**
    * Constructor that initializes a motor group with a vector of motors.
    * @param motors Vector of pointers to initialized WhoopMotors.
@@ -94,6 +97,13 @@ public:
   void stop_brake(); // Commands all motors to stop with braking.
   void stop_coast(); // Commands all motors to stop and coast.
 
+  /**
+   * Spins all motors through a characterized voltage table (see
+   * WhoopMotor::set_voltage_table)
+   * @param table The table, or nullptr to go back to linearize_voltage
+   */
+  void set_voltage_table(const VoltageTable *table);
+
   /**
    * Sets the gear ratio multiplier for the motor group.
    * i.e. motor on 32 tooth powering the 64 tooth: ratio = 32.0/64.0 = 0.5
@@ -141,6 +151,14 @@ public:
    */
   double get_distance_meters(); // Gets distance traveled in meters
 
+  /**
+   * Reads the rotation and velocity of every motor once, averaged as
+   * get_distance_meters and get_velocity_rad_s do
+   * @param distance_meters Set to the distance traveled, in meters
+   * @param velocity_rad_s Set to the velocity, in radians/sec
+   */
+  void read(double *distance_meters, double *velocity_rad_s);
+
   // Tare (reset)
   void tare(); // Resets the encoder count for all motors in the group.
   void tare(double degrees); // Resets the encoder count for all motors to a
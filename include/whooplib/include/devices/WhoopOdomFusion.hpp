@@ -10,6 +10,8 @@
 #ifndef WHOOP_ODOM_FUSION_HPP
 #define WHOOP_ODOM_FUSION_HPP
 
+#include "whooplib/include/calculators/PoseEKF.hpp"
+#include "whooplib/include/calculators/PoseHistory.hpp"
 #include "whooplib/include/calculators/RollingAverage.hpp"
 #include "whooplib/include/devices/WhoopDriveOdomOffset.hpp"
 #include "whooplib/include/devices/WhoopVision.hpp"
@@ -23,15 +25,20 @@ namespace whoop {
 // Enumeration defining possible fusion modes between visual and wheel odometry
 // data.
 enum fusionmode {
-  fusion_instant, // Instantly aligns wheel odometry to vision odometry upon
-                  // data retrieval.
-  fusion_gradual, // Gradually aligns wheel odometry to vision odometry over
-                  // time.
-  vision_only,    // Vision Odometry Only
-  wheel_odom_only // Wheel Odometry Only
+  fusion_instant,  // Instantly aligns wheel odometry to vision odometry upon
+                   // data retrieval.
+  fusion_gradual,  // Gradually aligns wheel odometry to vision odometry over
+                   // time.
+  vision_only,     // Vision Odometry Only
+  wheel_odom_only, // Wheel Odometry Only
+  fusion_ekf       // Weighs wheel odometry against vision odometry by how
+                   // uncertain each is, with an extended Kalman filter.
 };
 
-// Class responsible for fusing visual and wheel odometry data.
+// Class responsible for fusing visual and wheel odometry data. The drivetrain
+// steps it on each of its own steps. Added to the ComputeManager instead, it
+// runs as its own node, at its own step time (i.e. set_step_time(5) for 200
+// Hz), and the drivetrain reads the latest pose it published.
 class WhoopOdomFusion : public ComputeNode {
 protected:
   WhoopMutex self_lock;            // Mutex for thread-safe operations.
@@ -53,9 +60,33 @@ protected:
 
   bool accepting_fuses = false;
 
+  TwoDPose last_odom_pose = TwoDPose(0, 0, 0); // The wheel odometry of the
+                                               // last step.
+  PoseHistory history; // The last steps of wheel odometry, to move vision
+                       // frames forward from when they were captured.
+
+  /**
+   * Sets the filter and the wheel odometry it follows to a pose, and forgets
+   * the steps before
+   */
+  void reset_history(const TwoDPose &pose);
+
+  /**
+   * Corrects the filter with a vision frame, at the step it was captured,
+   * and replays the steps since
+   * @param p The frame
+   * @param capture_time When the frame was captured, in seconds on the
+   * brain's clock
+   * @returns false if the frame was rejected as an outlier
+   */
+  bool fuse_ekf(const Pose &p, double capture_time);
+
 public:
   Pose pose = Pose(); // Current fused pose of the odometry system.
 
+  PoseEKF ekf; // The filter of fusion_ekf. Its noise can be tuned before the
+               // robot starts.
+
   /**
    * Constructs a new odometry fusion object.
    * @param whoop_vision Pointer to the vision odometry system.
@@ -63,7 +94,7 @@ public:
    * @param min_confidence_threshold Minimum confidence required to consider
    * vision data (0.0 - 1.0).
    * @param fusion_mode Method of fusing vision with wheel odometry (instant,
-   * gradual, vision_only, wheel_odom_only).
+   * gradual, vision_only, wheel_odom_only, ekf).
    * @param max_fusion_shift_meters If FusionMode is fusion_gradual, it is the
    * maximum allowable shift in meters for gradual fusion, per second.
    * @param max_fusion_shift_radians If FusionMode is fusion_gradual, it is the
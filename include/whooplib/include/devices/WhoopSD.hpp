@@ -12,6 +12,7 @@
 
 #include "whooplib/include/nodes/NodeManager.hpp"
 #include "whooplib/includer.hpp"
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -37,6 +38,18 @@ public:
      * Gets text from file in the sd card
      */
     std::string get_string();
+
+    /**
+     * Writes raw bytes to file in the sd card
+     * @param bytes The bytes to put into the file
+     */
+    bool write_bytes(const std::vector<uint8_t> &bytes);
+
+    /**
+     * Gets raw bytes from file in the sd card
+     * @param bytes Filled with the contents of the file
+     */
+    bool get_bytes(std::vector<uint8_t> &bytes);
 };
 
 
@@ -55,6 +68,22 @@ bool write_string_to_sd(std::string filename, std::string text);
  */
 std::string get_string_from_sd(std::string filename);
 
+/**
+ * Writes raw bytes to the micro SD card, such as a binary path file
+ * @param filename The name of the file to write to (i.e. "path.bin")
+ * @param bytes The bytes to put into the file
+ * @returns A boolean. True if successfully worked, false otherwise
+ */
+bool write_bytes_to_sd(std::string filename, const std::vector<uint8_t> &bytes);
+
+/**
+ * Gets raw bytes from the sd card. The file is read with a single allocation
+ * @param filename The file to get bytes from (i.e. "path.bin")
+ * @param bytes Filled with the contents of the file
+ * @returns A boolean. True if successfully worked, false otherwise
+ */
+bool get_bytes_from_sd(std::string filename, std::vector<uint8_t> &bytes);
+
 /**
  * Returns true if the MicroSD card is inserted
  */
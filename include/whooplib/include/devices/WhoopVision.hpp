@@ -10,6 +10,7 @@
 #ifndef WHOOP_VISION_HPP
 #define WHOOP_VISION_HPP
 
+#include "whooplib/include/calculators/Transform2D.hpp"
 #include "whooplib/include/calculators/TwoDPose.hpp"
 #include "whooplib/include/nodes/BufferNode.hpp"
 #include "whooplib/include/nodes/NodeManager.hpp"
@@ -89,12 +90,15 @@ protected:
 
   double last_vision_message_time = 0;
 
+  double latency = 0;      // Seconds from sending a frame to receiving it
+  double capture_time = 0; // Seconds on the brain's clock of the last frame
+
   // Tared computes
   double tared_z = this->raw_pose.z - tare_z;
   double tared_pitch = this->raw_pose.pitch - tare_pitch;
   double tared_roll = this->raw_pose.roll - tare_roll;
-  TwoDPose tared_position; // Position adjusted for tare.
-  TwoDPose offset_change;  // Computed change due to offset adjustments.
+  Transform2D tared_position; // Position adjusted for tare.
+  TwoDPose offset_change;     // Computed change due to offset adjustments.
 
   RobotVisionOffset
       *robot_offset; // Offset configuration for vision adjustments.
@@ -111,7 +115,9 @@ protected:
   void _transform_pose(bool apply_delta = false);
 
   /**
-   * Updates the pose based on incoming data.
+   * Updates the pose based on incoming data. After the pose, the data can
+   * have the milliseconds from when the frame was captured to when it was
+   * sent.
    * @param pose_data The string containing serialized pose data.
    */
   void _update_pose(std::string pose_data);
@@ -142,6 +148,18 @@ public:
 
   bool vision_running();
 
+  /**
+   * Sets how long frames take to arrive after they are sent, as measured
+   * @param seconds The latency of the link, in seconds
+   */
+  void set_latency(double seconds);
+
+  /**
+   * @returns When the camera captured the last frame, in seconds on the
+   * brain's clock (when it arrived, less its age and the latency)
+   */
+  double get_capture_time();
+
   /**
    * Retrieves the corrected and computed pose.
    * @return The current pose of the system.
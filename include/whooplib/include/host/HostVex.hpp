@@ -0,0 +1,333 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       HostVex.hpp                                               */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Stand-In for the VEXcode API When Building on a Computer  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Defining WHOOP_HOST_BUILD makes includer.hpp include this header instead of
+ * "vex.h", so that WhoopLib can be compiled and run on a computer. Only the
+ * parts of the VEXcode API that WhoopLib uses are provided.
+ *
+ * Tasks are scheduled the way the brain schedules them: one runs at a time,
+ * until it waits. The motors, rotation sensors and inertial sensors read and
+ * drive whatever HostDevices is attached (see Simulator.hpp). Once a
+ * simulation is attached, the brain runs on its clock, which only moves when
+ * every task is waiting, so a program runs as fast as the computer can step
+ * it. Before that, the clock is the computer's. See host/makefile
+ */
+#ifndef HOST_VEX_HPP
+#define HOST_VEX_HPP
+
+#include <cstdint>
+#include <string> // As vex.h has it
+
+namespace vex {
+
+enum timeUnits { sec, msec };
+enum percentUnits { pct };
+enum rotationUnits { deg, rev };
+enum velocityUnits { dps, rpm };
+enum voltageUnits { volt, mV };
+enum brakeType { coast, brake, hold };
+enum directionType { fwd, reverse };
+enum gearSetting { ratio36_1, ratio18_1, ratio6_1 };
+enum controllerType { primary, partner };
+
+/**
+ * What the devices of a host build are plugged into. Ports count from 0, as
+ * PORT1 does. Without anything attached, the motors drive nothing and the
+ * sensors read 0
+ */
+class HostDevices {
+public:
+  virtual ~HostDevices() = default;
+
+  // 12 volts commands all of the battery, whatever its voltage
+  virtual void motor_spin(int /*port*/, double /*volts*/) {}
+  virtual void motor_stop(int /*port*/, brakeType /*mode*/) {}
+  virtual double motor_position(int /*port*/) { return 0; } // Degrees
+  virtual double motor_velocity(int /*port*/) { return 0; } // Degrees/second
+
+  virtual double rotation_position(int /*port*/) { return 0; } // Degrees
+  virtual double rotation_velocity(int /*port*/) { return 0; } // Degrees/s
+
+  virtual double inertial_heading(int /*port*/) { return 0; } // Degrees, CW
+  virtual double inertial_roll(int /*port*/) { return 0; }    // Degrees
+  virtual double inertial_pitch(int /*port*/) { return 0; }   // Degrees
+  virtual void inertial_calibrate(int /*port*/) {}
+  virtual bool inertial_calibrating(int /*port*/) { return false; }
+
+  virtual double battery_voltage() { return 12.8; }
+
+  /**
+   * Moves the devices forward as the brain's clock moves forward
+   * @param time The time of the clock, in seconds
+   */
+  virtual void advance_to(double /*time*/) {}
+};
+
+namespace host {
+
+/**
+ * Plugs the devices into devices, and runs the brain on the simulated clock
+ * from then on (nullptr unplugs them, and goes back to the computer's clock)
+ */
+void attach(HostDevices *devices);
+
+/**
+ * @returns What the devices are plugged into
+ */
+HostDevices &devices();
+
+/**
+ * @returns Seconds on the brain's clock
+ */
+double time();
+
+/**
+ * Lets the other tasks run until the brain's clock moves forward by seconds
+ */
+void sleep(double seconds);
+
+/**
+ * Starts a task, which first runs when the current task waits
+ */
+void start_task(int (*callback)(void *), void *arg);
+
+} // namespace host
+
+class timer {
+public:
+  double time(timeUnits units) {
+    return units == timeUnits::msec ? host::time() * 1000.0 : host::time();
+  }
+
+  /**
+   * @returns The time since the brain started, in microseconds
+   */
+  static std::uint64_t systemHighResolution() {
+    return static_cast<std::uint64_t>(host::time() * 1e6);
+  }
+};
+
+class brain {
+public:
+  class lcd {
+  public:
+    void print(const char * /*format*/, ...) {}
+    void clearScreen() {}
+    void clearLine(int /*row*/) {}
+    void setCursor(int /*row*/, int /*column*/) {}
+  };
+
+  class sdcard {
+  public:
+    bool isInserted() { return false; } // Files are not part of host builds
+  };
+
+  class battery {
+  public:
+    double voltage(voltageUnits units = voltageUnits::volt) {
+      double volts = host::devices().battery_voltage();
+      return units == voltageUnits::mV ? volts * 1000.0 : volts;
+    }
+  };
+
+  lcd Screen;
+  vex::timer Timer;
+  sdcard SDcard;
+  battery Battery;
+
+  /**
+   * @returns The time since the program started
+   */
+  double timer(timeUnits units) { return Timer.time(units); }
+};
+
+class motor {
+private:
+  int port;
+  bool is_reversed;
+  double position_offset = 0;
+
+  double direction() { return is_reversed ? -1 : 1; }
+
+public:
+  motor(std::int32_t port, gearSetting /*gears*/, bool reversed)
+      : port(port), is_reversed(reversed) {}
+
+  void spin(directionType direction, double voltage, voltageUnits units) {
+    double volts = units == voltageUnits::mV ? voltage / 1000.0 : voltage;
+    if (direction == directionType::reverse) {
+      volts = -volts;
+    }
+    host::devices().motor_spin(port, volts * this->direction());
+  }
+  void stop(brakeType mode) { host::devices().motor_stop(port, mode); }
+
+  double position(rotationUnits units) {
+    double degrees = host::devices().motor_position(port) * direction() -
+                     position_offset;
+    return units == rotationUnits::rev ? degrees / 360.0 : degrees;
+  }
+  double velocity(velocityUnits units) {
+    double dps = host::devices().motor_velocity(port) * direction();
+    return units == velocityUnits::rpm ? dps / 6.0 : dps;
+  }
+  void resetPosition() {
+    position_offset = host::devices().motor_position(port) * direction();
+  }
+};
+
+class rotation {
+private:
+  int port;
+  bool is_reversed;
+  double position_offset = 0;
+
+  double direction() { return is_reversed ? -1 : 1; }
+
+public:
+  rotation(std::int32_t port, bool reversed = false)
+      : port(port), is_reversed(reversed) {}
+
+  double position(rotationUnits units) {
+    double degrees = host::devices().rotation_position(port) * direction() -
+                     position_offset;
+    return units == rotationUnits::rev ? degrees / 360.0 : degrees;
+  }
+  double velocity(velocityUnits units) {
+    double dps = host::devices().rotation_velocity(port) * direction();
+    return units == velocityUnits::rpm ? dps / 6.0 : dps;
+  }
+  void resetPosition() {
+    position_offset = host::devices().rotation_position(port) * direction();
+  }
+};
+
+class inertial {
+private:
+  int port;
+  double heading_offset = 0;
+
+public:
+  inertial(std::int32_t port) : port(port) {}
+
+  double heading(rotationUnits units = rotationUnits::deg) {
+    double degrees = host::devices().inertial_heading(port) - heading_offset;
+    while (degrees < 0) {
+      degrees += 360;
+    }
+    while (degrees >= 360) {
+      degrees -= 360;
+    }
+    return units == rotationUnits::rev ? degrees / 360.0 : degrees;
+  }
+  double roll() { return host::devices().inertial_roll(port); }
+  double pitch() { return host::devices().inertial_pitch(port); }
+  void calibrate() {
+    heading_offset = 0;
+    host::devices().inertial_calibrate(port);
+  }
+  bool isCalibrating() { return host::devices().inertial_calibrating(port); }
+  void resetHeading() {
+    heading_offset = host::devices().inertial_heading(port);
+  }
+};
+
+/**
+ * A controller that nobody is holding
+ */
+class controller {
+public:
+  class axis {
+  public:
+    double position(percentUnits /*units*/) { return 0; }
+  };
+
+  class button {
+  public:
+    bool pressing() { return false; }
+  };
+
+  brain::lcd Screen;
+  axis Axis1, Axis2, Axis3, Axis4;
+  button ButtonUp, ButtonDown, ButtonLeft, ButtonRight, ButtonA, ButtonB,
+      ButtonX, ButtonY, ButtonR1, ButtonR2, ButtonL1, ButtonL2;
+
+  controller(controllerType /*type*/ = controllerType::primary) {}
+
+  void rumble(const char * /*pattern*/) {}
+};
+
+/**
+ * Lets the tasks that are waiting on the mutex run until it is unlocked
+ */
+class mutex {
+private:
+  bool locked = false;
+
+public:
+  void lock() {
+    while (locked) {
+      host::sleep(0.001);
+    }
+    locked = true;
+  }
+  void unlock() { locked = false; }
+};
+
+class task {
+public:
+  task(int (*callback)(void *), void *arg) { host::start_task(callback, arg); }
+  task(int (*callback)())
+      : task([](void *callback) { return ((int (*)())callback)(); },
+             (void *)callback) {}
+
+  static void sleep(std::uint32_t time_ms) { host::sleep(time_ms / 1000.0); }
+};
+
+namespace this_thread {
+inline void sleep_for(std::uint32_t time_ms) {
+  host::sleep(time_ms / 1000.0);
+}
+} // namespace this_thread
+
+inline void wait(double time, timeUnits units) {
+  host::sleep(units == timeUnits::msec ? time / 1000.0 : time);
+}
+
+} // namespace vex
+
+#define PORT1 0
+#define PORT2 1
+#define PORT3 2
+#define PORT4 3
+#define PORT5 4
+#define PORT6 5
+#define PORT7 6
+#define PORT8 7
+#define PORT9 8
+#define PORT10 9
+#define PORT11 10
+#define PORT12 11
+#define PORT13 12
+#define PORT14 13
+#define PORT15 14
+#define PORT16 15
+#define PORT17 16
+#define PORT18 17
+#define PORT19 18
+#define PORT20 19
+#define PORT21 20
+
+// As robot-config.h does for the brain
+using namespace vex;
+
+inline vex::brain Brain;
+
+#endif // HOST_VEX_HPP
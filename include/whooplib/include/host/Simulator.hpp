@@ -0,0 +1,288 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Simulator.hpp                                             */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Simulated Differential Drivetrain for Host Builds         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * A differential drivetrain for the devices of a host build to drive (see
+ * HostVex.hpp), so that WhoopDrivetrain, WhoopDriveOdomUnit and the
+ * calculators run the same code as on the brain:
+ *
+ *   Simulator simulator;
+ *   simulator.add_drive_motor(PORT1, driveside::side_left, yes_reverse);
+ *   simulator.add_drive_motor(PORT2, driveside::side_right);
+ *   simulator.add_tracking_wheel(PORT6, SimTrackingWheel(0.04, 0, false));
+ *   simulator.add_inertial(PORT7);
+ *   simulator.attach();
+ *
+ *   manager.start();
+ *   robot_drivetrain.set_state(drivetrainState::mode_autonomous);
+ *   robot_drivetrain.drive_to_point(0.5, 0.5);
+ *   TwoDPose truth = simulator.get_pose();
+ *
+ * Each motor turns its voltage into torque, less its back-EMF. The torque of
+ * each side pushes the chassis, which the wheels resist turning (scrub) and
+ * hold from sliding sideways, up to their grip. The tracking wheels and the
+ * inertial sensor read the motion of the chassis, with noise and bias.
+ *
+ * The simulation steps every step_time seconds of the brain's clock, which
+ * only moves when every task waits, so a program runs faster than real time.
+ * Only host builds have it (see host/makefile).
+ */
+#ifndef SIMULATOR_HPP
+#define SIMULATOR_HPP
+
+#include "whooplib/include/calculators/TwoDPose.hpp"
+#include "whooplib/include/devices/WhoopMotor.hpp"
+#include "whooplib/includer.hpp"
+#include <random>
+
+namespace whoop {
+
+/**
+ * Enum to specify which side of the drivetrain a motor drives
+ */
+enum driveside { side_left = 0, side_right = 1 };
+
+/**
+ * A V5 motor and its cartridge. At a voltage and a speed of the output shaft:
+ *
+ *   torque = stall_torque * (voltage / 12 - speed / free_speed)
+ */
+struct SimMotor {
+  double free_speed = 0;            // Output shaft rad/s at 12 volts
+  double stall_torque = 0;          // Output shaft Nm at 12 volts
+  double friction_torque = 0.01;    // Nm the gearbox loses to friction
+  double hold_voltage_per_rad = 50; // Volts per radian that stop_hold holds
+
+  /**
+   * @param motor_cartridge The cartridge of the motor (red, green, blue)
+   */
+  SimMotor(cartridge motor_cartridge = cartridge::blue);
+
+  /**
+   * @param volts The voltage across the motor
+   * @param speed The speed of the output shaft, in rad/s
+   * @returns The torque of the output shaft, in Nm
+   */
+  double torque(double volts, double speed) const;
+};
+
+/**
+ * The chassis of the drivetrain
+ */
+struct SimChassis {
+  double mass = 6.8;               // kg
+  double moment_of_inertia = 0.25; // kg m^2, about the center
+  double track_width = 0.3;        // Meters between the left and right wheels
+  double wheel_diameter = 0.08255; // Meters (3.25")
+  double gear_ratio = 0.75;        // Wheel turns per motor turn
+  double rolling_resistance = 2;   // Newtons against the direction of travel
+  double lateral_grip = 1.0;       // Friction coefficient against sliding
+  double scrub_torque = 1.0;       // Nm the wheels resist turning with
+};
+
+/**
+ * An unpowered wheel on a rotation sensor
+ */
+struct SimTrackingWheel {
+  double forward_offset = 0; // Meters forward of the center of the robot
+  double right_offset = 0;   // Meters right of the center of the robot
+  bool sideways = false;     // Measures motion to the left, not forward
+  double diameter = 0.06985; // Meters (2.75")
+  double resolution = 0.088; // Degrees between readings of the sensor
+  double noise = 0;          // Standard deviation of each reading, degrees
+
+  /**
+   * @param forward_offset Meters forward of the center of the robot
+   * @param right_offset Meters right of the center of the robot
+   * @param sideways Set to true if the wheel measures motion to the left
+   * (which WheelOdom counts as positive), instead of forward
+   * @param diameter The diameter of the wheel, in meters
+   */
+  SimTrackingWheel(double forward_offset = 0, double right_offset = 0,
+                   bool sideways = false, double diameter = 0.06985)
+      : forward_offset(forward_offset), right_offset(right_offset),
+        sideways(sideways), diameter(diameter) {}
+};
+
+/**
+ * An inertial sensor, as it reads the yaw of the robot
+ */
+struct SimInertial {
+  double noise = 0.01;           // Standard deviation of each reading, degrees
+  double drift = 0;              // Degrees per second the heading drifts by
+  double scale = 1;              // Degrees read per degree turned
+  double calibration_time = 2.0; // Seconds that calibrate takes
+
+  /**
+   * @param noise Standard deviation of each reading, in degrees
+   * @param drift Degrees per second the heading drifts by (its bias)
+   * @param scale Degrees read per degree turned (1 for a perfect sensor)
+   */
+  SimInertial(double noise = 0.01, double drift = 0, double scale = 1)
+      : noise(noise), drift(drift), scale(scale) {}
+};
+
+/**
+ * A differential drivetrain for the devices of a host build
+ */
+class Simulator : public vex::HostDevices {
+public:
+  static constexpr int PORTS = 21;
+
+  SimChassis chassis;
+  double step_time = 0.001; // Seconds per step of the simulation
+  double battery = 12.8;    // Volts
+
+  /**
+   * @param chassis The chassis of the drivetrain
+   * @param seed Seeds the noise of the sensors, so that runs repeat
+   */
+  Simulator(const SimChassis &chassis = SimChassis(), unsigned int seed = 1);
+
+  /**
+   * Unplugs the devices, if this simulation is attached
+   */
+  ~Simulator() override;
+
+  /**
+   * Adds a motor to a side of the drivetrain
+   * @param port The port of the motor (i.e. PORT1)
+   * @param side The side the motor drives
+   * @param reversed yes_reverse if the motor is mounted so that spinning
+   * forward drives its side backward, as it is configured in WhoopMotor
+   * @param motor The motor and its cartridge
+   */
+  void add_drive_motor(int port, driveside side,
+                       reversed reversed = reversed::no_reverse,
+                       const SimMotor &motor = SimMotor());
+
+  /**
+   * Adds a tracking wheel, on a rotation sensor
+   * @param port The port of the rotation sensor
+   * @param wheel Where the wheel is, and how it reads
+   */
+  void add_tracking_wheel(int port, const SimTrackingWheel &wheel);
+
+  /**
+   * Adds an inertial sensor
+   * @param port The port of the inertial sensor
+   * @param inertial How it reads
+   */
+  void add_inertial(int port, const SimInertial &inertial = SimInertial());
+
+  /**
+   * Plugs the devices into this simulation, and runs the brain on its clock
+   */
+  void attach();
+
+  /**
+   * Places the robot, at rest
+   * @param pose The pose of the robot, in meters and counter-clockwise radians
+   */
+  void set_pose(const TwoDPose &pose);
+
+  /**
+   * @returns Where the robot truly is, in meters and counter-clockwise radians
+   */
+  TwoDPose get_pose() const;
+
+  /**
+   * @returns How fast the robot truly drives forward, in m/s
+   */
+  double get_velocity() const;
+
+  /**
+   * @returns How fast the robot truly turns, in rad/s, counter-clockwise
+   */
+  double get_angular_velocity() const;
+
+  /**
+   * @returns Seconds of simulated time
+   */
+  double get_time() const;
+
+  /**
+   * Steps the simulation forward to a time, without running any tasks
+   * @param time The time to step to, in seconds
+   */
+  void advance_to(double time) override;
+
+  void motor_spin(int port, double volts) override;
+  void motor_stop(int port, vex::brakeType mode) override;
+  double motor_position(int port) override;
+  double motor_velocity(int port) override;
+
+  double rotation_position(int port) override;
+  double rotation_velocity(int port) override;
+
+  double inertial_heading(int port) override;
+  void inertial_calibrate(int port) override;
+  bool inertial_calibrating(int port) override;
+
+  double battery_voltage() override;
+
+private:
+  struct DriveMotor {
+    bool connected = false;
+    driveside side = driveside::side_left;
+    double direction = 1; // -1 when mounted reversed
+    SimMotor model;
+    double volts = 0;
+    bool stopped = true;
+    vex::brakeType stop_mode = vex::brakeType::coast;
+    double hold_position = 0; // Radians
+    double position = 0;      // Radians of the output shaft
+    double speed = 0;         // rad/s of the output shaft
+  };
+
+  struct TrackingWheel {
+    bool connected = false;
+    SimTrackingWheel wheel;
+    double position = 0; // Degrees
+    double speed = 0;    // Degrees per second
+  };
+
+  struct Inertial {
+    bool connected = false;
+    SimInertial model;
+    double zero_yaw = 0;          // The true yaw at its last calibration
+    double calibrated_time = 0;   // When it last finished calibrating
+    double calibrating_until = 0; // When the calibration finishes
+  };
+
+  DriveMotor motors[PORTS];
+  TrackingWheel wheels[PORTS];
+  Inertial inertials[PORTS];
+
+  bool attached = false;
+  long steps = 0; // Steps since the start
+  double time = 0;
+  TwoDPose pose;
+  double turned = 0; // The yaw, without wrapping around
+  double velocity = 0;         // Forward, in m/s
+  double lateral_velocity = 0; // Left, in m/s
+  double angular_velocity = 0; // Counter-clockwise, in rad/s
+
+  std::mt19937 random;
+  std::normal_distribution<double> gaussian{0.0, 1.0};
+
+  /**
+   * @returns Whether port is one of the smart ports
+   */
+  static bool valid_port(int port);
+
+  /**
+   * Moves the chassis and its devices forward by dt seconds
+   */
+  void step(double dt);
+};
+
+} // namespace whoop
+
+#endif // SIMULATOR_HPP
@@ -77,6 +77,8 @@ public:
   bool omit_steptime_compensation = false;
   int initial_computational_time =
       0; // Time to process data (to try to adapt step time to be more precise)
+  double step_dt =
+      0.01; // Measured seconds since the previous step began, for __step
 
   /**
    * Constructor for ComputeNode.
@@ -110,6 +112,14 @@ public:
       int step_time_ms,
       omitStepCompensation omit_steptime_compensation =
           omitStepCompensation::dont_omit); // Stops the computation process
+
+  /**
+   * Sets step_dt for a node that is stepped by another node instead of its
+   * own pipeline, so that it sees the same time between steps
+   * @param dt Seconds since the previous step began
+   */
+  void set_step_dt(double dt);
+
 protected:
   /**
    * Virtual function intended to be overridden by derived classes to implement
@@ -78,6 +78,12 @@ bool intToBool(int value);
 int boolToInt(bool value);
 double stringToDouble(const std::string &str);
 
+/**
+ * The clock that timestamps and times everything, to the microsecond
+ * @returns Seconds since the brain started
+ */
+double now_seconds();
+
 /**
  * Converts degrees to radians.
  * @param deg Angle in degrees.
@@ -113,6 +119,21 @@ double to_inches(double meters);
  */
 double normalize_angle(double angle_radians);
 
+/**
+ * Normalizes a radian angle to the range [-π, π], in the precision of the
+ * angle. For doubles, this is the same as normalize_angle.
+ * @param angle_radians Angle in radians to normalize.
+ * @return Normalized angle in radians.
+ */
+template <typename Scalar> Scalar normalize_scalar_angle(Scalar angle_radians) {
+  const Scalar pi = static_cast<Scalar>(M_PI);
+  angle_radians = std::fmod(angle_radians + pi, 2 * pi) - pi;
+  if (angle_radians < -pi) {
+    angle_radians += 2 * pi;
+  }
+  return angle_radians;
+}
+
 /**
  * Normalizes a radian angle to the range [0, 2π].
  * @param angle_radians Angle in radians to normalize.
@@ -16,7 +16,11 @@
 
 #ifndef VEX_H
 #define VEX_H
+#ifdef WHOOP_HOST_BUILD // Compiling on a computer (see host/makefile)
+#include "whooplib/include/host/HostVex.hpp"
+#else
 #include "vex.h"
+#endif
 #define USE_PROS false
 #define MICRO_USB_SERIAL_CONNECTION_OUT "/dev/serial1"
 #define MICRO_USB_SERIAL_CONNECTION_IN "/dev/serial1"
@@ -159,6 +159,88 @@ PursuitParams pursuit_parameters(
     ,2.0_in
     // The maximum forward voltage change per second, as a slew rate
     ,150.0_volts
+
+    /////////////////////////
+    // Path Representation
+    /////////////////////////
+    // How paths are stored. "path_sampled" samples the curves into points, "path_analytic" keeps the exact line and arc primitives (less memory, no resolution limit)
+    ,pathrepresentation::path_sampled
+
+    /////////////////////////
+    // Velocity Profile
+    /////////////////////////
+    // The speed of the robot at the forward max voltage, in meters per second. Set above 0 to slow down on tight turns and towards the end of each path
+    ,0.0_m
+    // The maximum acceleration of the velocity profile, in meters per second^2
+    ,2.0_m
+    // The maximum deceleration of the velocity profile, in meters per second^2
+    ,2.0_m
+    // The maximum centripetal acceleration on curves, in meters per second^2
+    ,2.0_m
+
+    /////////////////////////
+    // Path Planner
+    /////////////////////////
+    // The curves between waypoints. "planner_dubins" only drives forward, "planner_reeds_shepp" may reverse mid-path when it is shorter
+    ,pathplanner::planner_dubins
+
+    /////////////////////////
+    // Path Smoothing
+    /////////////////////////
+    // Length of the clothoid transitions that smooth out each jump in curvature (where a straight meets a turn). Set to 0 to disable
+    ,0_in
+
+    /////////////////////////
+    // Heading Optimization
+    /////////////////////////
+    // The number of headings tried at each {x, y} waypoint to find the shortest path. Set to 0 to have each {x, y} waypoint look at the next one instead
+    ,0_points
+    // The longest the heading optimization may take, in seconds. Waypoints look at the next one if it runs out of time
+    ,0.05_sec
+
+    /////////////////////////
+    // Feedforward
+    /////////////////////////
+    // Left side kS: the voltage to overcome static friction
+    ,0.0_volts
+    // Left side kV: the voltage per meter per second. Set above 0 (with the right side kV) to drive paths with feedforward, where the forward PID only corrects what is left over
+    ,0.0_volts
+    // Left side kA: the voltage per meter per second^2
+    ,0.0_volts
+    // Right side kS: the voltage to overcome static friction
+    ,0.0_volts
+    // Right side kV: the voltage per meter per second
+    ,0.0_volts
+    // Right side kA: the voltage per meter per second^2
+    ,0.0_volts
+    // The distance between the left and right wheels
+    ,12_in
+);
+
+////////////////////////////////////////////////////////////
+/**
+ *    Path Followers
+ */
+////////////////////////////////////////////////////////////
+// How paths are followed. "follower_ramsete" times the path and tracks it with RAMSETE (needs the kV above, or the max velocity), then settles with pure pursuit. "follower_mpc" tracks it with MPC instead. Use robot_drivetrain.use_path_follower to pick one for a single move
+pathfollower path_follower = pathfollower::follower_pure_pursuit;
+
+RamseteParams ramsete_parameters(
+    // RAMSETE b: how tightly the robot holds the trajectory
+    10.0
+    // RAMSETE zeta: the damping of the corrections, in (0, 1)
+    ,0.7
+    // The volts added to a side per m/s that it is slower than RAMSETE asks for
+    ,20.0_volts
+);
+
+MpcParams mpc_parameters(
+    // MPC horizon: the steps of 50ms that "follower_mpc" plans ahead (up to 15). It plans the velocity of each side within their voltage (from the kS, kV and kA above) and the max acceleration
+    10
+    // MPC time budget: the longest a plan may take. A step that takes longer is driven with pure pursuit instead
+    ,0.005_sec
+    // The volts added to a side per m/s that it is slower than the plan
+    ,20.0_volts
 );
 
 ////////////////////////////////////////////////////////////
@@ -234,6 +316,10 @@ ComputeManager manager({&robot_drivetrain, &controller1, &auton_selector});
 /*---------------------------------------------------------------------------*/
 void pre_auton()
 {
+    // Gives the path followers their tuning
+    pursuit_parameters.path_follower = path_follower;
+    pursuit_parameters.ramsete = ramsete_parameters;
+    pursuit_parameters.mpc = mpc_parameters;
     robot_drivetrain.set_state(drivetrainState::mode_disabled);
     auton_selector.run_selector();
 
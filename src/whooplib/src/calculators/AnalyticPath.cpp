@@ -0,0 +1,460 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       AnalyticPath.cpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Arc-Length Parameterized Line and Arc Path                */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/AnalyticPath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace whoop {
+
+// Turn direction of each Dubins segment, +1 is left, -1 is right, 0 is
+// straight. Indexed the same way as DubinsPathType.
+static const int DUBINS_DIRECTIONS[][3] = {{1, 0, 1},  {1, 0, -1},
+                                           {-1, 0, 1}, {-1, 0, -1},
+                                           {-1, 1, -1}, {1, -1, 1}};
+
+// Number of chords used to approximate a clothoid in queries, and the number
+// of Simpson intervals used to integrate its position
+static const int CLOTHOID_SUBDIVISIONS = 16;
+
+// Positive modulus, so that the result is always within [0, y)
+static double positive_fmod(double x, double y) {
+  return x - y * std::floor(x / y);
+}
+
+// Wraps an angle to [-pi, pi)
+static double wrap_angle(double angle) {
+  return positive_fmod(angle + M_PI, 2 * M_PI) - M_PI;
+}
+
+void PathPrimitive::sample(double t, double q[3]) const {
+  if (sharpness != 0) {
+    // Clothoids have no closed form (Fresnel integrals), so integrate the
+    // heading with Simpson's rule
+    double h = t / CLOTHOID_SUBDIVISIONS;
+    double sum_x = 0;
+    double sum_y = 0;
+    for (int i = 0; i <= CLOTHOID_SUBDIVISIONS; i++) {
+      double weight = (i == 0 || i == CLOTHOID_SUBDIVISIONS) ? 1
+                      : (i % 2 == 1)                         ? 4
+                                                             : 2;
+      double heading = yaw_at(i * h);
+      sum_x += weight * std::cos(heading);
+      sum_y += weight * std::sin(heading);
+    }
+    q[0] = x + sum_x * h / 3;
+    q[1] = y + sum_y * h / 3;
+    q[2] = yaw_at(t);
+  } else if (curvature == 0) {
+    q[0] = x + std::cos(yaw) * t;
+    q[1] = y + std::sin(yaw) * t;
+    q[2] = yaw;
+  } else {
+    double end_yaw = yaw + curvature * t;
+    q[0] = x + (std::sin(end_yaw) - std::sin(yaw)) / curvature;
+    q[1] = y + (std::cos(yaw) - std::cos(end_yaw)) / curvature;
+    q[2] = end_yaw;
+  }
+}
+
+double PathPrimitive::yaw_at(double t) const {
+  return yaw + curvature * t + sharpness * t * t / 2;
+}
+
+double PathPrimitive::curvature_at(double t) const {
+  return curvature + sharpness * t;
+}
+
+// Finds the closest point of a clothoid by projecting onto its chords
+static void clothoid_closest(const PathPrimitive &p, double x, double y,
+                             double lo, double hi, double candidates[],
+                             int &n) {
+  double best_distance = std::numeric_limits<double>::max();
+  double best_t = lo;
+  double a[3], b[3];
+  p.sample(lo, a);
+  for (int i = 1; i <= CLOTHOID_SUBDIVISIONS; i++) {
+    double t_a = lo + (hi - lo) * (i - 1) / CLOTHOID_SUBDIVISIONS;
+    double t_b = lo + (hi - lo) * i / CLOTHOID_SUBDIVISIONS;
+    p.sample(t_b, b);
+    double dx = b[0] - a[0];
+    double dy = b[1] - a[1];
+    double chord_sq = dx * dx + dy * dy;
+    double u = 0;
+    if (chord_sq > 0) {
+      u = std::max(0.0, std::min(1.0, ((x - a[0]) * dx + (y - a[1]) * dy) /
+                                          chord_sq));
+    }
+    double px = a[0] + u * dx - x;
+    double py = a[1] + u * dy - y;
+    double distance = px * px + py * py;
+    if (distance < best_distance) {
+      best_distance = distance;
+      best_t = t_a + u * (t_b - t_a);
+    }
+    a[0] = b[0];
+    a[1] = b[1];
+  }
+  candidates[n++] = best_t;
+}
+
+// Finds the furthest point of a clothoid within the radius, walking its
+// chords backwards
+static bool clothoid_lookahead(const PathPrimitive &p, double x, double y,
+                               double radius, double lo, double hi,
+                               double &t) {
+  double a[3], b[3];
+  p.sample(hi, b);
+  if ((b[0] - x) * (b[0] - x) + (b[1] - y) * (b[1] - y) <= radius * radius) {
+    t = hi;
+    return true;
+  }
+  for (int i = CLOTHOID_SUBDIVISIONS; i > 0; i--) {
+    double t_a = lo + (hi - lo) * (i - 1) / CLOTHOID_SUBDIVISIONS;
+    double t_b = lo + (hi - lo) * i / CLOTHOID_SUBDIVISIONS;
+    p.sample(t_a, a);
+
+    // Solve |a + u * (b - a) - point| = radius for the exit u
+    double dx = b[0] - a[0];
+    double dy = b[1] - a[1];
+    double qa = dx * dx + dy * dy;
+    double qb = (a[0] - x) * dx + (a[1] - y) * dy;
+    double qc = (a[0] - x) * (a[0] - x) + (a[1] - y) * (a[1] - y) -
+                radius * radius;
+    double discriminant = qb * qb - qa * qc;
+    if (qa > 0 && discriminant >= 0) {
+      double u = (-qb + std::sqrt(discriminant)) / qa;
+      if (u >= 0 && u <= 1) {
+        t = t_a + u * (t_b - t_a);
+        return true;
+      }
+    }
+    b[0] = a[0];
+    b[1] = a[1];
+  }
+  return false;
+}
+
+void AnalyticPath::clear() { primitives.clear(); }
+
+double AnalyticPath::length() const {
+  if (primitives.empty()) {
+    return 0;
+  }
+  const PathPrimitive &last = primitives.back();
+  return last.s_start + last.length;
+}
+
+void AnalyticPath::append_dubins(DubinsPath *path) {
+  const int *directions = DUBINS_DIRECTIONS[dubins_path_type(path)];
+  double q[3] = {path->qi[0], path->qi[1], path->qi[2]};
+
+  for (int i = 0; i < 3; i++) {
+    double segment_length = dubins_segment_length(path, i);
+    if (segment_length <= 0) {
+      continue; // Degenerate segment, nothing to store
+    }
+
+    PathPrimitive primitive(q[0], q[1], q[2], directions[i] / path->rho,
+                            segment_length, length());
+    primitives.push_back(primitive);
+
+    // The end of this segment is the start of the next
+    primitive.sample(segment_length, q);
+  }
+}
+
+void AnalyticPath::append_reeds_shepp(ReedsSheppPath *path) {
+  double q[3] = {path->qi[0], path->qi[1], path->qi[2]};
+
+  for (int i = 0; i < 5; i++) {
+    int direction = reeds_shepp_segment_direction(path, i);
+    if (direction == 0) {
+      continue; // Degenerate segment, nothing to store
+    }
+
+    ReedsSheppSegmentType type = reeds_shepp_segment_type(path, i);
+    double turn = 0;
+    if (type == RS_LEFT) {
+      turn = 1;
+    } else if (type == RS_RIGHT) {
+      turn = -1;
+    }
+
+    // Reversing flips the heading of travel, and a left turn of the robot
+    // becomes a right turn along the direction of travel
+    double travel_yaw = direction > 0 ? q[2] : q[2] + M_PI;
+    PathPrimitive primitive(q[0], q[1], travel_yaw,
+                            direction * turn / path->rho,
+                            reeds_shepp_segment_length(path, i), length(),
+                            direction);
+    primitives.push_back(primitive);
+
+    // The end of this segment is the start of the next
+    primitive.sample(primitive.length, q);
+    if (direction < 0) {
+      q[2] -= M_PI;
+    }
+  }
+}
+
+void AnalyticPath::append_line(double x0, double y0, double x1, double y1,
+                               int direction) {
+  double dx = x1 - x0;
+  double dy = y1 - y0;
+  double distance = std::sqrt(dx * dx + dy * dy);
+  if (distance <= 0) {
+    return;
+  }
+  primitives.push_back(
+      PathPrimitive(x0, y0, std::atan2(dy, dx), 0, distance, length(),
+                    direction));
+}
+
+const PathPrimitive *AnalyticPath::primitive_at(double s) const {
+  if (primitives.empty()) {
+    return nullptr;
+  }
+
+  // Binary search for the last primitive that starts at or before s
+  auto it = std::upper_bound(
+      primitives.begin(), primitives.end(), s,
+      [](double value, const PathPrimitive &p) { return value < p.s_start; });
+  if (it != primitives.begin()) {
+    --it;
+  }
+  return &*it;
+}
+
+int AnalyticPath::sample(double s, double q[3]) const {
+  s = std::max(0.0, std::min(s, length()));
+
+  const PathPrimitive *primitive = primitive_at(s);
+  if (primitive == nullptr) {
+    return EDUBPARAM;
+  }
+
+  primitive->sample(std::min(s - primitive->s_start, primitive->length), q);
+  return EDUBOK;
+}
+
+double AnalyticPath::curvature_at(double s) const {
+  const PathPrimitive *primitive = primitive_at(s);
+  if (primitive == nullptr) {
+    return 0;
+  }
+  return primitive->curvature_at(s - primitive->s_start);
+}
+
+void AnalyticPath::smooth(double transition_length) {
+  size_t n = primitives.size();
+  if (n < 2 || transition_length <= 0) {
+    return;
+  }
+
+  // Half of the clothoid that replaces the junction after each primitive
+  std::vector<double> half(n - 1, 0);
+  for (size_t k = 0; k + 1 < n; k++) {
+    const PathPrimitive &a = primitives[k];
+    const PathPrimitive &b = primitives[k + 1];
+    if (a.direction != b.direction ||
+        std::abs(a.curvature_at(a.length) - b.curvature) < 1e-9) {
+      continue;
+    }
+    half[k] = std::min({transition_length / 2, a.length / 2, b.length / 2});
+  }
+
+  std::vector<PathPrimitive> smoothed;
+  double q[3] = {primitives[0].x, primitives[0].y, primitives[0].yaw};
+  double s = 0;
+
+  for (size_t k = 0; k < n; k++) {
+    const PathPrimitive &p = primitives[k];
+    double trim_start = k > 0 ? half[k - 1] : 0;
+    double trim_end = k + 1 < n ? half[k] : 0;
+
+    // The heading change of each clothoid matches the portion it replaces,
+    // so the original headings stay exact. Only the position is chained.
+    double core_length = p.length - trim_start - trim_end;
+    if (core_length > 0) {
+      PathPrimitive core(q[0], q[1], p.yaw_at(trim_start),
+                         p.curvature_at(trim_start), core_length, s,
+                         p.direction, p.sharpness);
+      smoothed.push_back(core);
+      core.sample(core_length, q);
+      s += core_length;
+    }
+
+    if (trim_end > 0) {
+      const PathPrimitive &next = primitives[k + 1];
+      double start_curvature = p.curvature_at(p.length - trim_end);
+      double end_curvature = next.curvature_at(trim_end);
+      PathPrimitive transition(q[0], q[1], p.yaw_at(p.length - trim_end),
+                               start_curvature, 2 * trim_end, s, p.direction,
+                               (end_curvature - start_curvature) /
+                                   (2 * trim_end));
+      smoothed.push_back(transition);
+      transition.sample(transition.length, q);
+      s += transition.length;
+    }
+  }
+
+  primitives = smoothed;
+}
+
+PathQuery AnalyticPath::closest_point(double x, double y, double s_min,
+                                      double s_max) const {
+  PathQuery best;
+  best.distance = std::numeric_limits<double>::max();
+
+  double q[3];
+  for (const PathPrimitive &p : primitives) {
+    // Restrict to the portion of the primitive within [s_min, s_max]
+    double lo = std::max(0.0, s_min - p.s_start);
+    double hi = std::min(p.length, s_max - p.s_start);
+    if (lo > hi) {
+      continue;
+    }
+
+    // Up to a handful of candidates: both bounds, and any interior point
+    // where the arc faces the queried point
+    double candidates[8];
+    int n = 0;
+    candidates[n++] = lo;
+    candidates[n++] = hi;
+
+    if (p.sharpness != 0) {
+      clothoid_closest(p, x, y, lo, hi, candidates, n);
+    } else if (p.curvature == 0) {
+      double t = (x - p.x) * std::cos(p.yaw) + (y - p.y) * std::sin(p.yaw);
+      candidates[n++] = std::max(lo, std::min(t, hi));
+    } else {
+      double center_x = p.x - std::sin(p.yaw) / p.curvature;
+      double center_y = p.y + std::cos(p.yaw) / p.curvature;
+      double start_angle = std::atan2(p.y - center_y, p.x - center_x);
+      double point_angle = std::atan2(y - center_y, x - center_x);
+
+      // Arc length at which the arc angle equals the point's angle
+      double period = 2 * M_PI / std::abs(p.curvature);
+      double t = lo + positive_fmod((point_angle - start_angle) / p.curvature -
+                                        lo,
+                                    period);
+      while (t <= hi && n < 8) {
+        candidates[n++] = t;
+        t += period;
+      }
+    }
+
+    for (int i = 0; i < n; i++) {
+      p.sample(candidates[i], q);
+      double distance = std::sqrt((q[0] - x) * (q[0] - x) +
+                                  (q[1] - y) * (q[1] - y));
+      if (distance < best.distance) {
+        best = PathQuery(true, p.s_start + candidates[i], q[0], q[1],
+                         distance);
+      }
+    }
+  }
+
+  return best;
+}
+
+PathQuery AnalyticPath::lookahead_point(double x, double y, double radius,
+                                        double s_min, double s_max) const {
+  // Walk backwards so the first primitive with a solution holds the furthest
+  // point along the path
+  for (auto it = primitives.rbegin(); it != primitives.rend(); ++it) {
+    const PathPrimitive &p = *it;
+    double lo = std::max(0.0, s_min - p.s_start);
+    double hi = std::min(p.length, s_max - p.s_start);
+    if (lo > hi) {
+      continue;
+    }
+
+    bool found = false;
+    double t = hi;
+
+    if (p.sharpness != 0) {
+      found = clothoid_lookahead(p, x, y, radius, lo, hi, t);
+    } else if (p.curvature == 0) {
+      // Solve |start + t * direction - point| = radius for t
+      double rel_x = p.x - x;
+      double rel_y = p.y - y;
+      double b = rel_x * std::cos(p.yaw) + rel_y * std::sin(p.yaw);
+      double c = rel_x * rel_x + rel_y * rel_y - radius * radius;
+      double discriminant = b * b - c;
+      if (discriminant >= 0) {
+        double root = std::sqrt(discriminant);
+        double t_enter = -b - root;
+        double t_exit = -b + root;
+        if (t_enter <= hi && t_exit >= lo) {
+          found = true;
+          t = std::min(t_exit, hi);
+        }
+      }
+    } else {
+      // A point on the arc is within the radius when its angle is within
+      // half_width of the angle towards the queried point (law of cosines)
+      double r = 1.0 / std::abs(p.curvature);
+      double center_x = p.x - std::sin(p.yaw) / p.curvature;
+      double center_y = p.y + std::cos(p.yaw) / p.curvature;
+      double d = std::sqrt((x - center_x) * (x - center_x) +
+                           (y - center_y) * (y - center_y));
+      double start_angle = std::atan2(p.y - center_y, p.x - center_x);
+
+      if (d < 1e-12) {
+        found = r <= radius; // Every point of the arc is equally far
+      } else {
+        double k = (r * r + d * d - radius * radius) / (2 * r * d);
+        if (k <= -1) {
+          found = true; // Entire circle is within the radius
+        } else if (k <= 1) {
+          double half_width = std::acos(k);
+          double point_angle = std::atan2(y - center_y, x - center_x);
+          double end_angle = start_angle + p.curvature * hi;
+
+          if (std::abs(wrap_angle(end_angle - point_angle)) <= half_width) {
+            found = true;
+          } else {
+            // Latest boundary crossing at or before hi
+            double period = 2 * M_PI / std::abs(p.curvature);
+            double boundaries[2] = {point_angle + half_width,
+                                    point_angle - half_width};
+            for (double boundary : boundaries) {
+              double crossing =
+                  hi - positive_fmod(hi - (boundary - start_angle) /
+                                              p.curvature,
+                                     period);
+              if (crossing >= lo && (!found || crossing > t)) {
+                found = true;
+                t = crossing;
+              }
+            }
+            if (!found) {
+              t = hi;
+            }
+          }
+        }
+      }
+    }
+
+    if (found) {
+      double q[3];
+      p.sample(t, q);
+      double distance =
+          std::sqrt((q[0] - x) * (q[0] - x) + (q[1] - y) * (q[1] - y));
+      return PathQuery(true, p.s_start + t, q[0], q[1], distance);
+    }
+  }
+
+  return PathQuery();
+}
+
+} // namespace whoop
@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       DriveMixer.cpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Mixes Side Voltages for the Battery and the Motor Limit   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/DriveMixer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+// Readings under this are from no battery (i.e. a computer)
+static const double MIN_BATTERY_VOLTAGE = 1.0;
+
+double MixerStats::saturated_fraction() const {
+  if (steps == 0) {
+    return 0;
+  }
+  return static_cast<double>(saturated_steps) / steps;
+}
+
+DriveMixer::DriveMixer(double nominal_voltage, double max_voltage)
+    : nominal_voltage(nominal_voltage), max_voltage(max_voltage) {}
+
+void DriveMixer::set_battery_voltage(double volts, double dt) {
+  if (volts < MIN_BATTERY_VOLTAGE) {
+    return;
+  }
+  if (battery_voltage == 0 || battery_time_constant <= 0) {
+    battery_voltage = volts;
+  } else {
+    double alpha = std::max(dt, 0.0) / (battery_time_constant + dt);
+    battery_voltage += (volts - battery_voltage) * alpha;
+  }
+}
+
+double DriveMixer::get_battery_voltage() const {
+  return battery_voltage > 0 ? battery_voltage : nominal_voltage;
+}
+
+MixedOutput DriveMixer::mix(double left_voltage, double right_voltage) {
+  MixedOutput output;
+  double compensation = 1;
+  if (battery_compensation) {
+    compensation = nominal_voltage / get_battery_voltage();
+  }
+  output.left_voltage = left_voltage * compensation;
+  output.right_voltage = right_voltage * compensation;
+
+  // Scale both sides by the same factor, keeping the turn between them
+  double largest = std::max(std::abs(output.left_voltage),
+                            std::abs(output.right_voltage));
+  if (largest > max_voltage) {
+    output.saturated = true;
+    output.scale = max_voltage / largest;
+    output.left_voltage *= output.scale;
+    output.right_voltage *= output.scale;
+  }
+
+  stats.steps++;
+  if (output.saturated) {
+    stats.saturated_steps++;
+  }
+  stats.peak_voltage = std::max(stats.peak_voltage, largest);
+  stats.min_scale = std::min(stats.min_scale, output.scale);
+  stats.battery_voltage = get_battery_voltage();
+  return output;
+}
+
+MixedOutput DriveMixer::mix_arcade(double forward_voltage,
+                                   double turn_voltage) {
+  return mix(forward_voltage - turn_voltage, forward_voltage + turn_voltage);
+}
+
+MixerStats DriveMixer::get_stats() const { return stats; }
+
+void DriveMixer::reset_stats() {
+  stats = MixerStats();
+  stats.battery_voltage = get_battery_voltage();
+}
+
+} // namespace whoop
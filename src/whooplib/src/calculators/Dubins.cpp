@@ -23,12 +23,19 @@
 #define _USE_MATH_DEFINES
 #endif
 #include "whooplib/include/calculators/Dubins.hpp"
+#include <cmath>
 #include <math.h>
 
 namespace whoop {
 
 #define EPSILON (10e-10)
 
+/* Below this squared (normalized) straight length, a CSC word is one arc. The
+ * threshold sits above the round-off of p_sq in each precision */
+template <typename Scalar> static Scalar dubins_arc_epsilon();
+template <> double dubins_arc_epsilon<double>() { return 10e-13; }
+template <> float dubins_arc_epsilon<float>() { return 1e-4f; }
+
 typedef enum { L_SEG = 0, S_SEG = 1, R_SEG = 2 } SegmentType;
 
 /* The segment types for each of the Path types */
@@ -36,39 +43,48 @@ const SegmentType DIRDATA[][3] = {{L_SEG, S_SEG, L_SEG}, {L_SEG, S_SEG, R_SEG},
                                   {R_SEG, S_SEG, L_SEG}, {R_SEG, S_SEG, R_SEG},
                                   {R_SEG, L_SEG, R_SEG}, {L_SEG, R_SEG, L_SEG}};
 
-typedef struct {
-  double alpha;
-  double beta;
-  double d;
-  double sa;
-  double sb;
-  double ca;
-  double cb;
-  double c_ab;
-  double d_sq;
-} DubinsIntermediateResults;
-
-int dubins_word(DubinsIntermediateResults *in, DubinsPathType pathType,
-                double out[3]);
-int dubins_intermediate_results(DubinsIntermediateResults *in, double q0[3],
-                                double q1[3], double rho);
+template <typename Scalar> struct DubinsIntermediateResults {
+  Scalar alpha;
+  Scalar beta;
+  Scalar d;
+  Scalar sa;
+  Scalar sb;
+  Scalar ca;
+  Scalar cb;
+  Scalar c_ab;
+  Scalar d_sq;
+};
+
+template <typename Scalar>
+static int dubins_word(DubinsIntermediateResults<Scalar> *in,
+                       DubinsPathType pathType, Scalar out[3]);
+template <typename Scalar>
+static int dubins_intermediate_results(DubinsIntermediateResults<Scalar> *in,
+                                       Scalar q0[3], Scalar q1[3], Scalar rho);
 
 /**
  * Floating point modulus suitable for rings
  *
  * fmod doesn't behave correctly for angular quantities, this function does
  */
-double fmodr(double x, double y) { return x - y * floor(x / y); }
+template <typename Scalar> static Scalar fmodr(Scalar x, Scalar y) {
+  return x - y * std::floor(x / y);
+}
 
-double mod2pi(double theta) { return fmodr(theta, 2 * M_PI); }
+template <typename Scalar> static Scalar mod2pi(Scalar theta) {
+  return fmodr(theta, static_cast<Scalar>(2 * M_PI));
+}
 
-int dubins_shortest_path(DubinsPath *path, double q0[3], double q1[3],
-                         double rho) {
+template <typename Scalar>
+int dubins_shortest_path(DubinsPathT<Scalar> *path,
+                         typename DubinsScalar<Scalar>::type q0[3],
+                         typename DubinsScalar<Scalar>::type q1[3],
+                         typename DubinsScalar<Scalar>::type rho) {
   int i, errcode;
-  DubinsIntermediateResults in;
-  double params[3];
-  double cost;
-  double best_cost = INFINITY;
+  DubinsIntermediateResults<Scalar> in;
+  Scalar params[3];
+  Scalar cost;
+  Scalar best_cost = INFINITY;
   int best_word = -1;
   errcode = dubins_intermediate_results(&in, q0, q1, rho);
   if (errcode != EDUBOK) {
@@ -101,13 +117,17 @@ int dubins_shortest_path(DubinsPath *path, double q0[3], double q1[3],
   return EDUBOK;
 }
 
-int dubins_path(DubinsPath *path, double q0[3], double q1[3], double rho,
+template <typename Scalar>
+int dubins_path(DubinsPathT<Scalar> *path,
+                typename DubinsScalar<Scalar>::type q0[3],
+                typename DubinsScalar<Scalar>::type q1[3],
+                typename DubinsScalar<Scalar>::type rho,
                 DubinsPathType pathType) {
   int errcode;
-  DubinsIntermediateResults in;
+  DubinsIntermediateResults<Scalar> in;
   errcode = dubins_intermediate_results(&in, q0, q1, rho);
   if (errcode == EDUBOK) {
-    double params[3];
+    Scalar params[3];
     errcode = dubins_word(&in, pathType, params);
     if (errcode == EDUBOK) {
       path->param[0] = params[0];
@@ -123,8 +143,9 @@ int dubins_path(DubinsPath *path, double q0[3], double q1[3], double rho,
   return errcode;
 }
 
-double dubins_path_length(DubinsPath *path) {
-  double length = 0.;
+template <typename Scalar>
+Scalar dubins_path_length(DubinsPathT<Scalar> *path) {
+  Scalar length = 0.;
   length += path->param[0];
   length += path->param[1];
   length += path->param[2];
@@ -132,32 +153,39 @@ double dubins_path_length(DubinsPath *path) {
   return length;
 }
 
-double dubins_segment_length(DubinsPath *path, int i) {
+template <typename Scalar>
+Scalar dubins_segment_length(DubinsPathT<Scalar> *path, int i) {
   if ((i < 0) || (i > 2)) {
     return INFINITY;
   }
   return path->param[i] * path->rho;
 }
 
-double dubins_segment_length_normalized(DubinsPath *path, int i) {
+template <typename Scalar>
+Scalar dubins_segment_length_normalized(DubinsPathT<Scalar> *path, int i) {
   if ((i < 0) || (i > 2)) {
     return INFINITY;
   }
   return path->param[i];
 }
 
-DubinsPathType dubins_path_type(DubinsPath *path) { return path->type; }
+template <typename Scalar>
+DubinsPathType dubins_path_type(DubinsPathT<Scalar> *path) {
+  return path->type;
+}
 
-void dubins_segment(double t, double qi[3], double qt[3], SegmentType type) {
-  double st = sin(qi[2]);
-  double ct = cos(qi[2]);
+template <typename Scalar>
+static void dubins_segment(Scalar t, Scalar qi[3], Scalar qt[3],
+                           SegmentType type) {
+  Scalar st = std::sin(qi[2]);
+  Scalar ct = std::cos(qi[2]);
   if (type == L_SEG) {
-    qt[0] = +sin(qi[2] + t) - st;
-    qt[1] = -cos(qi[2] + t) + ct;
+    qt[0] = +std::sin(qi[2] + t) - st;
+    qt[1] = -std::cos(qi[2] + t) + ct;
     qt[2] = t;
   } else if (type == R_SEG) {
-    qt[0] = -sin(qi[2] - t) + st;
-    qt[1] = +cos(qi[2] - t) - ct;
+    qt[0] = -std::sin(qi[2] - t) + st;
+    qt[1] = +std::cos(qi[2] - t) - ct;
     qt[2] = -t;
   } else if (type == S_SEG) {
     qt[0] = ct * t;
@@ -169,14 +197,17 @@ void dubins_segment(double t, double qi[3], double qt[3], SegmentType type) {
   qt[2] += qi[2];
 }
 
-int dubins_path_sample(DubinsPath *path, double t, double q[3]) {
+template <typename Scalar>
+int dubins_path_sample(DubinsPathT<Scalar> *path,
+                       typename DubinsScalar<Scalar>::type t,
+                       typename DubinsScalar<Scalar>::type q[3]) {
   /* tprime is the normalised variant of the parameter t */
-  double tprime = t / path->rho;
-  double qi[3]; /* The translated initial configuration */
-  double q1[3]; /* end-of segment 1 */
-  double q2[3]; /* end-of segment 2 */
+  Scalar tprime = t / path->rho;
+  Scalar qi[3]; /* The translated initial configuration */
+  Scalar q1[3]; /* end-of segment 1 */
+  Scalar q2[3]; /* end-of segment 2 */
   const SegmentType *types = DIRDATA[path->type];
-  double p1, p2;
+  Scalar p1, p2;
 
   if (t < 0 || t > dubins_path_length(path)) {
     return EDUBPARAM;
@@ -209,12 +240,15 @@ int dubins_path_sample(DubinsPath *path, double t, double q[3]) {
   return EDUBOK;
 }
 
-int dubins_path_sample_many(DubinsPath *path, double stepSize,
-                            DubinsPathSamplingCallback cb, void *user_data) {
+template <typename Scalar>
+int dubins_path_sample_many(
+    DubinsPathT<Scalar> *path, typename DubinsScalar<Scalar>::type stepSize,
+    DubinsPathSamplingCallbackT<typename DubinsScalar<Scalar>::type> cb,
+    void *user_data) {
   int retcode;
-  double q[3];
-  double x = 0.0;
-  double length = dubins_path_length(path);
+  Scalar q[3];
+  Scalar x = 0.0;
+  Scalar length = dubins_path_length(path);
   while (x < length) {
     dubins_path_sample(path, x, q);
     retcode = cb(q, x, user_data);
@@ -226,13 +260,19 @@ int dubins_path_sample_many(DubinsPath *path, double stepSize,
   return 0;
 }
 
-int dubins_path_endpoint(DubinsPath *path, double q[3]) {
-  return dubins_path_sample(path, dubins_path_length(path) - EPSILON, q);
+template <typename Scalar>
+int dubins_path_endpoint(DubinsPathT<Scalar> *path,
+                         typename DubinsScalar<Scalar>::type q[3]) {
+  return dubins_path_sample(
+      path, dubins_path_length(path) - static_cast<Scalar>(EPSILON), q);
 }
 
-int dubins_extract_subpath(DubinsPath *path, double t, DubinsPath *newpath) {
+template <typename Scalar>
+int dubins_extract_subpath(DubinsPathT<Scalar> *path,
+                           typename DubinsScalar<Scalar>::type t,
+                           DubinsPathT<Scalar> *newpath) {
   /* calculate the true parameter */
-  double tprime = t / path->rho;
+  Scalar tprime = t / path->rho;
 
   if ((t < 0) || (t > dubins_path_length(path))) {
     return EDUBPARAM;
@@ -246,29 +286,30 @@ int dubins_extract_subpath(DubinsPath *path, double t, DubinsPath *newpath) {
   newpath->type = path->type;
 
   /* fix the parameters */
-  newpath->param[0] = fmin(path->param[0], tprime);
-  newpath->param[1] = fmin(path->param[1], tprime - newpath->param[0]);
-  newpath->param[2] =
-      fmin(path->param[2], tprime - newpath->param[0] - newpath->param[1]);
+  newpath->param[0] = std::fmin(path->param[0], tprime);
+  newpath->param[1] = std::fmin(path->param[1], tprime - newpath->param[0]);
+  newpath->param[2] = std::fmin(path->param[2],
+                                tprime - newpath->param[0] - newpath->param[1]);
   return 0;
 }
 
-int dubins_intermediate_results(DubinsIntermediateResults *in, double q0[3],
-                                double q1[3], double rho) {
-  double dx, dy, D, d, theta, alpha, beta;
+template <typename Scalar>
+static int dubins_intermediate_results(DubinsIntermediateResults<Scalar> *in,
+                                       Scalar q0[3], Scalar q1[3], Scalar rho) {
+  Scalar dx, dy, D, d, theta, alpha, beta;
   if (rho <= 0.0) {
     return EDUBBADRHO;
   }
 
   dx = q1[0] - q0[0];
   dy = q1[1] - q0[1];
-  D = sqrt(dx * dx + dy * dy);
+  D = std::sqrt(dx * dx + dy * dy);
   d = D / rho;
   theta = 0;
 
   /* test required to prevent domain errors if dx=0 and dy=0 */
   if (d > 0) {
-    theta = mod2pi(atan2(dy, dx));
+    theta = mod2pi(std::atan2(dy, dx));
   }
   alpha = mod2pi(q0[2] - theta);
   beta = mod2pi(q1[2] - theta);
@@ -276,52 +317,70 @@ int dubins_intermediate_results(DubinsIntermediateResults *in, double q0[3],
   in->alpha = alpha;
   in->beta = beta;
   in->d = d;
-  in->sa = sin(alpha);
-  in->sb = sin(beta);
-  in->ca = cos(alpha);
-  in->cb = cos(beta);
-  in->c_ab = cos(alpha - beta);
+  in->sa = std::sin(alpha);
+  in->sb = std::sin(beta);
+  in->ca = std::cos(alpha);
+  in->cb = std::cos(beta);
+  in->c_ab = std::cos(alpha - beta);
   in->d_sq = d * d;
 
   return EDUBOK;
 }
 
-int dubins_LSL(DubinsIntermediateResults *in, double out[3]) {
-  double tmp0, tmp1, p_sq;
+template <typename Scalar>
+static int dubins_LSL(DubinsIntermediateResults<Scalar> *in, Scalar out[3]) {
+  Scalar tmp0, tmp1, p_sq;
 
   tmp0 = in->d + in->sa - in->sb;
   p_sq = 2 + in->d_sq - (2 * in->c_ab) + (2 * in->d * (in->sa - in->sb));
 
+  if (std::fabs(p_sq) < dubins_arc_epsilon<Scalar>()) {
+    // A single arc. The direction of the (empty) straight is ill-defined, so
+    // the two turns could otherwise each wrap into an extra loop
+    out[0] = mod2pi(in->beta - in->alpha);
+    out[1] = 0;
+    out[2] = 0;
+    return EDUBOK;
+  }
   if (p_sq >= 0) {
-    tmp1 = atan2((in->cb - in->ca), tmp0);
+    tmp1 = std::atan2((in->cb - in->ca), tmp0);
     out[0] = mod2pi(tmp1 - in->alpha);
-    out[1] = sqrt(p_sq);
+    out[1] = std::sqrt(p_sq);
     out[2] = mod2pi(in->beta - tmp1);
     return EDUBOK;
   }
   return EDUBNOPATH;
 }
 
-int dubins_RSR(DubinsIntermediateResults *in, double out[3]) {
-  double tmp0 = in->d - in->sa + in->sb;
-  double p_sq = 2 + in->d_sq - (2 * in->c_ab) + (2 * in->d * (in->sb - in->sa));
+template <typename Scalar>
+static int dubins_RSR(DubinsIntermediateResults<Scalar> *in, Scalar out[3]) {
+  Scalar tmp0 = in->d - in->sa + in->sb;
+  Scalar p_sq = 2 + in->d_sq - (2 * in->c_ab) + (2 * in->d * (in->sb - in->sa));
+  if (std::fabs(p_sq) < dubins_arc_epsilon<Scalar>()) {
+    // A single arc, the same as dubins_LSL
+    out[0] = mod2pi(in->alpha - in->beta);
+    out[1] = 0;
+    out[2] = 0;
+    return EDUBOK;
+  }
   if (p_sq >= 0) {
-    double tmp1 = atan2((in->ca - in->cb), tmp0);
+    Scalar tmp1 = std::atan2((in->ca - in->cb), tmp0);
     out[0] = mod2pi(in->alpha - tmp1);
-    out[1] = sqrt(p_sq);
+    out[1] = std::sqrt(p_sq);
     out[2] = mod2pi(tmp1 - in->beta);
     return EDUBOK;
   }
   return EDUBNOPATH;
 }
 
-int dubins_LSR(DubinsIntermediateResults *in, double out[3]) {
-  double p_sq =
+template <typename Scalar>
+static int dubins_LSR(DubinsIntermediateResults<Scalar> *in, Scalar out[3]) {
+  Scalar p_sq =
       -2 + (in->d_sq) + (2 * in->c_ab) + (2 * in->d * (in->sa + in->sb));
   if (p_sq >= 0) {
-    double p = sqrt(p_sq);
-    double tmp0 =
-        atan2((-in->ca - in->cb), (in->d + in->sa + in->sb)) - atan2(-2.0, p);
+    Scalar p = std::sqrt(p_sq);
+    Scalar tmp0 = std::atan2((-in->ca - in->cb), (in->d + in->sa + in->sb)) -
+                  std::atan2(static_cast<Scalar>(-2), p);
     out[0] = mod2pi(tmp0 - in->alpha);
     out[1] = p;
     out[2] = mod2pi(tmp0 - mod2pi(in->beta));
@@ -330,13 +389,14 @@ int dubins_LSR(DubinsIntermediateResults *in, double out[3]) {
   return EDUBNOPATH;
 }
 
-int dubins_RSL(DubinsIntermediateResults *in, double out[3]) {
-  double p_sq =
+template <typename Scalar>
+static int dubins_RSL(DubinsIntermediateResults<Scalar> *in, Scalar out[3]) {
+  Scalar p_sq =
       -2 + in->d_sq + (2 * in->c_ab) - (2 * in->d * (in->sa + in->sb));
   if (p_sq >= 0) {
-    double p = sqrt(p_sq);
-    double tmp0 =
-        atan2((in->ca + in->cb), (in->d - in->sa - in->sb)) - atan2(2.0, p);
+    Scalar p = std::sqrt(p_sq);
+    Scalar tmp0 = std::atan2((in->ca + in->cb), (in->d - in->sa - in->sb)) -
+                  std::atan2(static_cast<Scalar>(2), p);
     out[0] = mod2pi(in->alpha - tmp0);
     out[1] = p;
     out[2] = mod2pi(in->beta - tmp0);
@@ -345,13 +405,14 @@ int dubins_RSL(DubinsIntermediateResults *in, double out[3]) {
   return EDUBNOPATH;
 }
 
-int dubins_RLR(DubinsIntermediateResults *in, double out[3]) {
-  double tmp0 =
-      (6. - in->d_sq + 2 * in->c_ab + 2 * in->d * (in->sa - in->sb)) / 8.;
-  double phi = atan2(in->ca - in->cb, in->d - in->sa + in->sb);
-  if (fabs(tmp0) <= 1) {
-    double p = mod2pi((2 * M_PI) - acos(tmp0));
-    double t = mod2pi(in->alpha - phi + mod2pi(p / 2.));
+template <typename Scalar>
+static int dubins_RLR(DubinsIntermediateResults<Scalar> *in, Scalar out[3]) {
+  Scalar tmp0 =
+      (6 - in->d_sq + 2 * in->c_ab + 2 * in->d * (in->sa - in->sb)) / 8;
+  Scalar phi = std::atan2(in->ca - in->cb, in->d - in->sa + in->sb);
+  if (std::fabs(tmp0) <= 1) {
+    Scalar p = mod2pi(static_cast<Scalar>(2 * M_PI) - std::acos(tmp0));
+    Scalar t = mod2pi(in->alpha - phi + mod2pi(p / 2));
     out[0] = t;
     out[1] = p;
     out[2] = mod2pi(in->alpha - in->beta - t + mod2pi(p));
@@ -360,13 +421,14 @@ int dubins_RLR(DubinsIntermediateResults *in, double out[3]) {
   return EDUBNOPATH;
 }
 
-int dubins_LRL(DubinsIntermediateResults *in, double out[3]) {
-  double tmp0 =
-      (6. - in->d_sq + 2 * in->c_ab + 2 * in->d * (in->sb - in->sa)) / 8.;
-  double phi = atan2(in->ca - in->cb, in->d + in->sa - in->sb);
-  if (fabs(tmp0) <= 1) {
-    double p = mod2pi(2 * M_PI - acos(tmp0));
-    double t = mod2pi(-in->alpha - phi + p / 2.);
+template <typename Scalar>
+static int dubins_LRL(DubinsIntermediateResults<Scalar> *in, Scalar out[3]) {
+  Scalar tmp0 =
+      (6 - in->d_sq + 2 * in->c_ab + 2 * in->d * (in->sb - in->sa)) / 8;
+  Scalar phi = std::atan2(in->ca - in->cb, in->d + in->sa - in->sb);
+  if (std::fabs(tmp0) <= 1) {
+    Scalar p = mod2pi(static_cast<Scalar>(2 * M_PI) - std::acos(tmp0));
+    Scalar t = mod2pi(-in->alpha - phi + p / 2);
     out[0] = t;
     out[1] = p;
     out[2] = mod2pi(mod2pi(in->beta) - in->alpha - t + mod2pi(p));
@@ -375,8 +437,9 @@ int dubins_LRL(DubinsIntermediateResults *in, double out[3]) {
   return EDUBNOPATH;
 }
 
-int dubins_word(DubinsIntermediateResults *in, DubinsPathType pathType,
-                double out[3]) {
+template <typename Scalar>
+static int dubins_word(DubinsIntermediateResults<Scalar> *in,
+                       DubinsPathType pathType, Scalar out[3]) {
   int result;
   switch (pathType) {
   case LSL:
@@ -403,4 +466,26 @@ int dubins_word(DubinsIntermediateResults *in, DubinsPathType pathType,
   return result;
 }
 
+#define DUBINS_INSTANTIATE(Scalar)                                             \
+  template int dubins_shortest_path<Scalar>(DubinsPathT<Scalar> *, Scalar *,   \
+                                            Scalar *, Scalar);                 \
+  template int dubins_path<Scalar>(DubinsPathT<Scalar> *, Scalar *, Scalar *,  \
+                                   Scalar, DubinsPathType);                    \
+  template Scalar dubins_path_length<Scalar>(DubinsPathT<Scalar> *);           \
+  template Scalar dubins_segment_length<Scalar>(DubinsPathT<Scalar> *, int);   \
+  template Scalar dubins_segment_length_normalized<Scalar>(                    \
+      DubinsPathT<Scalar> *, int);                                             \
+  template DubinsPathType dubins_path_type<Scalar>(DubinsPathT<Scalar> *);     \
+  template int dubins_path_sample<Scalar>(DubinsPathT<Scalar> *, Scalar,       \
+                                          Scalar *);                           \
+  template int dubins_path_sample_many<Scalar>(                                \
+      DubinsPathT<Scalar> *, Scalar, DubinsPathSamplingCallbackT<Scalar>,      \
+      void *);                                                                 \
+  template int dubins_path_endpoint<Scalar>(DubinsPathT<Scalar> *, Scalar *);  \
+  template int dubins_extract_subpath<Scalar>(DubinsPathT<Scalar> *, Scalar,   \
+                                              DubinsPathT<Scalar> *);
+
+DUBINS_INSTANTIATE(double)
+DUBINS_INSTANTIATE(float)
+
 } // namespace whoop
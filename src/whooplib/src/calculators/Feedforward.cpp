@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Feedforward.cpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Motor Feedforward From Characterized kS, kV and kA        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/Feedforward.hpp"
+#include <algorithm>
+
+namespace whoop {
+
+MotorFeedforward::MotorFeedforward(double ks, double kv, double ka)
+    : ks(ks), kv(kv), ka(ka) {}
+
+bool MotorFeedforward::enabled() const { return kv > 0; }
+
+double MotorFeedforward::calculate(double velocity,
+                                   double acceleration) const {
+  double direction = velocity != 0 ? velocity : acceleration;
+  double static_voltage = 0;
+  if (direction > 0) {
+    static_voltage = ks;
+  } else if (direction < 0) {
+    static_voltage = -ks;
+  }
+  return static_voltage + kv * velocity + ka * acceleration;
+}
+
+double MotorFeedforward::max_velocity(double voltage) const {
+  if (!enabled()) {
+    return 0;
+  }
+  return std::max(voltage - ks, 0.0) / kv;
+}
+
+} // namespace whoop
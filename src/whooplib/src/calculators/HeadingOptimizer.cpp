@@ -0,0 +1,159 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       HeadingOptimizer.cpp                                      */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Picks Waypoint Headings That Minimize Dubins Path Length  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/HeadingOptimizer.hpp"
+#include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace whoop {
+
+double HeadingOptimizationResult::length_reduction() const {
+  if (original_length <= 0) {
+    return 0;
+  }
+  return (original_length - optimized_length) / original_length;
+}
+
+/**
+ * The heading PurePursuitConductor::generate_path gives a waypoint without
+ * one: looking at the next waypoint, or away from the previous for the last
+ */
+static double default_heading(const std::vector<std::vector<double>> &waypoints,
+                              size_t i) {
+  if (waypoints[i].size() == 3) {
+    return waypoints[i][2];
+  }
+  if (i == waypoints.size() - 1) {
+    return TwoDPose(waypoints[i - 1][0], waypoints[i - 1][1], 0)
+        .lookAt(waypoints[i][0], waypoints[i][1])
+        .yaw;
+  }
+  return TwoDPose(waypoints[i][0], waypoints[i][1], 0)
+      .lookAt(waypoints[i + 1][0], waypoints[i + 1][1])
+      .yaw;
+}
+
+/**
+ * The length of the Dubins path between two waypoints. The path into the last
+ * waypoint ends at the start of its landing strip, then drives straight
+ */
+static double edge_length(const std::vector<double> &from, double from_yaw,
+                          const std::vector<double> &to, double to_yaw,
+                          double turning_radius, double landing_strip) {
+  double q0[3] = {from[0], from[1], from_yaw};
+  double q1[3] = {to[0] - landing_strip * cos(to_yaw),
+                  to[1] - landing_strip * sin(to_yaw), to_yaw};
+  DubinsPath path;
+  if (dubins_shortest_path(&path, q0, q1, turning_radius) != EDUBOK) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return dubins_path_length(&path) + landing_strip;
+}
+
+HeadingOptimizationResult
+optimize_headings(const std::vector<std::vector<double>> &waypoints,
+                  double turning_radius, double landing_strip,
+                  int heading_bins, double time_budget) {
+  HeadingOptimizationResult result;
+  size_t count = waypoints.size();
+  double start_time = now_seconds();
+
+  // The headings without optimization, which are also the fallback
+  std::vector<double> original_headings(count);
+  for (size_t i = 0; i < count; i++) {
+    original_headings[i] = default_heading(waypoints, i);
+    result.waypoints.push_back(
+        TwoDPose(waypoints[i][0], waypoints[i][1], original_headings[i]));
+  }
+  if (count < 2) {
+    return result;
+  }
+  for (size_t i = 0; i + 1 < count; i++) {
+    result.original_length += edge_length(
+        waypoints[i], original_headings[i], waypoints[i + 1],
+        original_headings[i + 1], turning_radius,
+        i + 2 == count ? landing_strip : 0);
+  }
+  result.optimized_length = result.original_length;
+
+  // The candidate headings of each waypoint. The original heading is always
+  // first, so that ties keep the path that would have been driven anyway
+  heading_bins = std::max(1, heading_bins);
+  std::vector<std::vector<double>> candidates(count);
+  for (size_t i = 0; i < count; i++) {
+    candidates[i].push_back(original_headings[i]);
+    if (waypoints[i].size() != 3) {
+      for (int b = 0; b < heading_bins; b++) {
+        candidates[i].push_back(normalize_angle(2 * M_PI * b / heading_bins));
+      }
+    }
+  }
+
+  // cost[i][k] is the shortest length from the start to candidate k of
+  // waypoint i, and parent[i][k] the candidate of waypoint i - 1 it came from
+  const double infinity = std::numeric_limits<double>::infinity();
+  std::vector<std::vector<double>> cost(count);
+  std::vector<std::vector<int>> parent(count);
+  cost[0].assign(candidates[0].size(), 0);
+  parent[0].assign(candidates[0].size(), -1);
+
+  for (size_t i = 1; i < count; i++) {
+    double strip = i + 1 == count ? landing_strip : 0;
+    cost[i].assign(candidates[i].size(), infinity);
+    parent[i].assign(candidates[i].size(), -1);
+    for (size_t k = 0; k < candidates[i].size(); k++) {
+      for (size_t j = 0; j < candidates[i - 1].size(); j++) {
+        if (cost[i - 1][j] == infinity) {
+          continue;
+        }
+        double length = cost[i - 1][j] +
+                        edge_length(waypoints[i - 1], candidates[i - 1][j],
+                                    waypoints[i], candidates[i][k],
+                                    turning_radius, strip);
+        if (length < cost[i][k]) {
+          cost[i][k] = length;
+          parent[i][k] = j;
+        }
+      }
+
+      if (time_budget > 0 && now_seconds() - start_time > time_budget) {
+        result.timed_out = true;
+        result.planning_time = now_seconds() - start_time;
+        return result;
+      }
+    }
+  }
+
+  int best = 0;
+  for (size_t k = 1; k < candidates[count - 1].size(); k++) {
+    if (cost[count - 1][k] < cost[count - 1][best]) {
+      best = k;
+    }
+  }
+
+  // Only use the optimized headings if they are actually shorter
+  if (cost[count - 1][best] < result.original_length) {
+    result.optimized = true;
+    result.optimized_length = cost[count - 1][best];
+    for (size_t i = count - 1;; i--) {
+      result.waypoints[i].yaw = candidates[i][best];
+      if (i == 0) {
+        break;
+      }
+      best = parent[i][best];
+    }
+  }
+  result.planning_time = now_seconds() - start_time;
+  return result;
+}
+
+} // namespace whoop
@@ -0,0 +1,323 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       HybridAStar.cpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Obstacle-Aware Hybrid A* Planner Over Dubins Primitives   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/HybridAStar.hpp"
+#include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace whoop {
+
+// Penalty for changing the steering, as a fraction of the step length. Keeps
+// the search from weaving between left and right turns of equal length
+static const double STEER_CHANGE_PENALTY = 0.1;
+
+// Consecutive turns are merged into one waypoint up to this angle, so that
+// the shortest Dubins path between the waypoints is still the same arc
+static const double MAX_MERGED_TURN = M_PI_2;
+
+HybridAStar::HybridAStar(const OccupancyGrid &grid, double turning_radius,
+                         double robot_radius, double time_budget,
+                         int heading_bins, double step_length,
+                         int max_expansions)
+    : turning_radius(turning_radius), robot_radius(robot_radius),
+      heading_bins(std::max(1, heading_bins)), step_length(step_length),
+      time_budget(time_budget), max_expansions(max_expansions),
+      analytic_interval(5) {
+  if (this->step_length <= 0) {
+    // Long enough to always leave the cell, even diagonally
+    this->step_length = grid.resolution * 1.5 * M_SQRT2;
+  }
+  set_grid(grid);
+}
+
+void HybridAStar::set_grid(const OccupancyGrid &grid) {
+  // Motions are checked every half cell, so the extra half cell keeps a
+  // corner of an obstacle from slipping between two checks
+  inflated_grid = grid.inflated(robot_radius + grid.resolution * 0.5);
+}
+
+bool HybridAStar::in_collision(double x, double y) const {
+  return inflated_grid.is_occupied(x, y);
+}
+
+bool HybridAStar::pose_free(double x, double y) const {
+  return !inflated_grid.is_occupied(x, y);
+}
+
+bool HybridAStar::straight_free(double x0, double y0, double x1,
+                                double y1) const {
+  double distance = std::hypot(x1 - x0, y1 - y0);
+  int samples = static_cast<int>(
+      std::ceil(distance / (inflated_grid.resolution * 0.5)));
+  for (int i = 0; i <= samples; i++) {
+    double fraction = samples == 0 ? 0 : static_cast<double>(i) / samples;
+    if (!pose_free(x0 + (x1 - x0) * fraction, y0 + (y1 - y0) * fraction)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HybridAStar::dubins_free(double q0[3], double q1[3],
+                              double &length) const {
+  DubinsPath path;
+  if (dubins_shortest_path(&path, q0, q1, turning_radius) != EDUBOK) {
+    return false;
+  }
+  length = dubins_path_length(&path);
+  double spacing = inflated_grid.resolution * 0.5;
+  double q[3];
+  for (double t = 0; t < length; t += spacing) {
+    dubins_path_sample(&path, t, q);
+    if (!pose_free(q[0], q[1])) {
+      return false;
+    }
+  }
+  return pose_free(q1[0], q1[1]);
+}
+
+int HybridAStar::state_index(double x, double y, double yaw) const {
+  int column, row;
+  if (!inflated_grid.to_cell(x, y, column, row)) {
+    return -1;
+  }
+  double wrapped = std::fmod(yaw, 2 * M_PI);
+  if (wrapped < 0) {
+    wrapped += 2 * M_PI;
+  }
+  int bin = static_cast<int>(wrapped / (2 * M_PI) * heading_bins);
+  bin = std::min(bin, heading_bins - 1);
+  return (row * inflated_grid.columns + column) * heading_bins + bin;
+}
+
+void HybridAStar::compute_heuristic(double goal_x, double goal_y) {
+  // Dijkstra outwards from the goal over the free cells. This ignores the
+  // turning radius, but knows the way around the obstacles
+  int columns = inflated_grid.columns;
+  int rows = inflated_grid.rows;
+  heuristic.assign(static_cast<size_t>(columns) * rows,
+                   std::numeric_limits<float>::infinity());
+
+  int goal_column, goal_row;
+  if (!inflated_grid.to_cell(goal_x, goal_y, goal_column, goal_row)) {
+    return;
+  }
+
+  typedef std::pair<float, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  heuristic[goal_row * columns + goal_column] = 0;
+  open.push({0, goal_row * columns + goal_column});
+
+  const float resolution = static_cast<float>(inflated_grid.resolution);
+  const float diagonal = resolution * static_cast<float>(M_SQRT2);
+  while (!open.empty()) {
+    Entry entry = open.top();
+    open.pop();
+    if (entry.first > heuristic[entry.second]) {
+      continue;
+    }
+    int column = entry.second % columns;
+    int row = entry.second / columns;
+    for (int dr = -1; dr <= 1; dr++) {
+      for (int dc = -1; dc <= 1; dc++) {
+        if ((dc == 0 && dr == 0) ||
+            inflated_grid.cell_occupied(column + dc, row + dr)) {
+          continue;
+        }
+        int neighbor = (row + dr) * columns + column + dc;
+        float distance =
+            entry.first + ((dc != 0 && dr != 0) ? diagonal : resolution);
+        if (distance < heuristic[neighbor]) {
+          heuristic[neighbor] = distance;
+          open.push({distance, neighbor});
+        }
+      }
+    }
+  }
+}
+
+double HybridAStar::estimate(const Node &node, double q_goal[3]) {
+  int column, row;
+  inflated_grid.to_cell(node.x, node.y, column, row);
+  double obstacle_distance =
+      heuristic[static_cast<size_t>(row) * inflated_grid.columns + column];
+
+  // The Dubins length knows about the turning radius, but not the obstacles
+  double q[3] = {node.x, node.y, node.yaw};
+  DubinsPath path;
+  double turning_distance = 0;
+  if (dubins_shortest_path(&path, q, q_goal, turning_radius) == EDUBOK) {
+    turning_distance = dubins_path_length(&path);
+  }
+  return std::max(obstacle_distance, turning_distance);
+}
+
+HybridAStarResult HybridAStar::plan(const TwoDPose &start,
+                                    const TwoDPose &goal,
+                                    double landing_strip) {
+  HybridAStarResult result;
+  double start_time = now_seconds();
+
+  // PurePursuitPath drives straight into the goal from behind it
+  TwoDPose search_goal = goal * TwoDPose(0, -std::max(0.0, landing_strip), 0);
+  double q_goal[3] = {search_goal.x, search_goal.y, search_goal.yaw};
+
+  if (!pose_free(start.x, start.y) ||
+      !straight_free(search_goal.x, search_goal.y, goal.x, goal.y)) {
+    return result;
+  }
+
+  compute_heuristic(search_goal.x, search_goal.y);
+  nodes.clear();
+  closed.assign(static_cast<size_t>(inflated_grid.columns) *
+                    inflated_grid.rows * heading_bins,
+                false);
+
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  nodes.push_back({start.x, start.y, start.yaw, 0, -1, 0});
+  open.push({estimate(nodes[0], q_goal), 0});
+
+  const double arc_angle = step_length / turning_radius;
+  const double spacing = inflated_grid.resolution * 0.5;
+  const int samples =
+      std::max(1, static_cast<int>(std::ceil(step_length / spacing)));
+
+  while (!open.empty()) {
+    int current = open.top().second;
+    open.pop();
+
+    Node node = nodes[current];
+    int index = state_index(node.x, node.y, node.yaw);
+    if (index < 0 || closed[index]) {
+      continue;
+    }
+    closed[index] = true;
+
+    // Hard limits, checking the clock sparingly
+    if (result.expansions >= max_expansions ||
+        ((result.expansions & 31) == 0 &&
+         now_seconds() - start_time > time_budget)) {
+      result.timed_out = true;
+      break;
+    }
+
+    // Try to finish with a Dubins path straight to the goal
+    bool close = std::hypot(node.x - q_goal[0], node.y - q_goal[1]) <
+                 4 * turning_radius;
+    if (result.expansions % analytic_interval == 0 || close) {
+      double q[3] = {node.x, node.y, node.yaw};
+      double length;
+      if (dubins_free(q, q_goal, length)) {
+        build_waypoints(current, goal, search_goal, result);
+        result.success = true;
+        break;
+      }
+    }
+    result.expansions++;
+
+    // Expand right, straight and left
+    for (int steer = -1; steer <= 1; steer++) {
+      double yaw = node.yaw + steer * arc_angle;
+      bool free = true;
+      double x = node.x, y = node.y;
+      for (int i = 1; i <= samples && free; i++) {
+        double distance = step_length * i / samples;
+        if (steer == 0) {
+          x = node.x + distance * std::cos(node.yaw);
+          y = node.y + distance * std::sin(node.yaw);
+        } else {
+          double turn = steer * distance / turning_radius;
+          x = node.x + steer * turning_radius *
+                           (std::sin(node.yaw + turn) - std::sin(node.yaw));
+          y = node.y - steer * turning_radius *
+                           (std::cos(node.yaw + turn) - std::cos(node.yaw));
+        }
+        free = pose_free(x, y);
+      }
+      if (!free) {
+        continue;
+      }
+
+      int child_index = state_index(x, y, yaw);
+      if (child_index < 0 || closed[child_index]) {
+        continue;
+      }
+
+      double g = node.g + step_length;
+      if (current != 0 && steer != node.steer) {
+        g += step_length * STEER_CHANGE_PENALTY;
+      }
+      Node child = {x, y, normalize_angle(yaw), g, current, steer};
+      double h = estimate(child, q_goal);
+      if (std::isinf(h)) {
+        continue; // The goal cannot be reached from here
+      }
+      nodes.push_back(child);
+      open.push({g + h, static_cast<int>(nodes.size() - 1)});
+    }
+  }
+
+  result.planning_time = now_seconds() - start_time;
+  return result;
+}
+
+void HybridAStar::build_waypoints(int goal_node, const TwoDPose &goal,
+                                  const TwoDPose &search_goal,
+                                  HybridAStarResult &result) const {
+  std::vector<int> chain;
+  for (int i = goal_node; i >= 0; i = nodes[i].parent) {
+    chain.push_back(i);
+  }
+  std::reverse(chain.begin(), chain.end());
+
+  // Runs of the same motion become a single waypoint
+  result.waypoints = {TwoDPose(nodes[0].x, nodes[0].y, nodes[0].yaw)};
+  double run_angle = 0;
+  for (size_t j = 1; j < chain.size(); j++) {
+    const Node &node = nodes[chain[j]];
+    double turn = node.steer == 0 ? 0 : step_length / turning_radius;
+    bool same_run = j > 1 && node.steer == nodes[chain[j - 1]].steer &&
+                    run_angle + turn <= MAX_MERGED_TURN + 1e-9;
+    if (j > 1 && !same_run) {
+      const Node &previous = nodes[chain[j - 1]];
+      result.waypoints.push_back(
+          TwoDPose(previous.x, previous.y, previous.yaw));
+      run_angle = 0;
+    }
+    run_angle += turn;
+  }
+  if (chain.size() > 1) {
+    const Node &last = nodes[chain.back()];
+    result.waypoints.push_back(TwoDPose(last.x, last.y, last.yaw));
+  }
+  result.waypoints.push_back(goal);
+
+  // Length as the conductor will drive it, into the landing strip
+  result.length = std::hypot(goal.x - search_goal.x, goal.y - search_goal.y);
+  for (size_t i = 0; i + 1 < result.waypoints.size(); i++) {
+    const TwoDPose &a = result.waypoints[i];
+    bool last = i + 2 == result.waypoints.size();
+    const TwoDPose &b = last ? search_goal : result.waypoints[i + 1];
+    double q0[3] = {a.x, a.y, a.yaw};
+    double q1[3] = {b.x, b.y, b.yaw};
+    DubinsPath path;
+    if (dubins_shortest_path(&path, q0, q1, turning_radius) == EDUBOK) {
+      result.length += dubins_path_length(&path);
+    }
+  }
+}
+
+} // namespace whoop
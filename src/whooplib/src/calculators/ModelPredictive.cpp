@@ -0,0 +1,329 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       ModelPredictive.cpp                                       */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Constrained Model Predictive Trajectory Controller        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/ModelPredictive.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+// ADMM step sizes. SIGMA keeps the system positive definite, RHO_SCALE sets
+// the constraint penalty against the size of the cost, and ALPHA is the
+// over-relaxation
+static const double SIGMA = 1e-6;
+static const double RHO_SCALE = 0.1;
+static const double ALPHA = 1.6;
+
+ModelPredictiveController::ModelPredictiveController(int horizon,
+                                                     double time_budget)
+    : horizon(horizon), time_budget(time_budget) {}
+
+void ModelPredictiveController::reset() {
+  warm = false;
+  last_solve_time = 0;
+  max_solve_time = 0;
+  fallbacks = 0;
+}
+
+int ModelPredictiveController::build(const TwoDPose &pose,
+                                     const Trajectory &trajectory, double time,
+                                     double track_width, const MpcSide &left,
+                                     const MpcSide &right,
+                                     double left_velocity,
+                                     double right_velocity) {
+  int steps = horizon;
+  int variables = 2 * steps;
+  double h = step_time;
+  double half_track = track_width / 2;
+
+  TrajectoryState reference[MAX_HORIZON + 1];
+  for (int k = 0; k <= steps; k++) {
+    reference[k] = trajectory.sample(time + k * h);
+  }
+
+  // The error of the robot in the frame of the reference
+  double sin_yaw, cos_yaw;
+  control_sincos(reference[0].yaw, &sin_yaw, &cos_yaw);
+  double dx = pose.x - reference[0].x;
+  double dy = pose.y - reference[0].y;
+  free_error[0][0] = cos_yaw * dx + sin_yaw * dy;
+  free_error[0][1] = -sin_yaw * dx + cos_yaw * dy;
+  free_error[0][2] = control_normalize_angle(pose.yaw - reference[0].yaw);
+
+  // A change in the side velocities moves the error forward by their
+  // average, and turns it by their difference over the track width
+  double B[3][2] = {{h / 2, h / 2},
+                    {0, 0},
+                    {-h / track_width, h / track_width}};
+
+  // Rolls the linearized model forward
+  for (int k = 0; k < steps; k++) {
+    double w = reference[k].angular_velocity * h;
+    double v = reference[k].velocity * h;
+    double A[3][3] = {{1, w, 0}, {-w, 1, v}, {0, 0, 1}};
+
+    const double *e = free_error[k];
+    for (int r = 0; r < 3; r++) {
+      free_error[k + 1][r] = A[r][0] * e[0] + A[r][1] * e[1] + A[r][2] * e[2];
+    }
+    for (int j = 0; j < k; j++) {
+      for (int c = 0; c < 2; c++) {
+        double g0 = effect[k][j][0][c];
+        double g1 = effect[k][j][1][c];
+        double g2 = effect[k][j][2][c];
+        for (int r = 0; r < 3; r++) {
+          effect[k + 1][j][r][c] = A[r][0] * g0 + A[r][1] * g1 + A[r][2] * g2;
+        }
+      }
+    }
+    for (int r = 0; r < 3; r++) {
+      effect[k + 1][k][r][0] = B[r][0];
+      effect[k + 1][k][r][1] = B[r][1];
+    }
+  }
+
+  // The cost of the errors, as a QP in the change of each side velocity
+  // from the reference
+  for (int i = 0; i < variables; i++) {
+    q[i] = 0;
+    for (int j = 0; j < variables; j++) {
+      P[i][j] = 0;
+    }
+  }
+  double weights[3] = {position_weight, position_weight, yaw_weight};
+  for (int k = 1; k <= steps; k++) {
+    for (int i = 0; i < k; i++) {
+      for (int a = 0; a < 2; a++) {
+        // Q times column a of the effect of step i
+        double qg[3];
+        for (int r = 0; r < 3; r++) {
+          qg[r] = weights[r] * effect[k][i][r][a];
+        }
+        q[2 * i + a] += qg[0] * free_error[k][0] + qg[1] * free_error[k][1] +
+                        qg[2] * free_error[k][2];
+        for (int j = 0; j <= i; j++) {
+          for (int b = 0; b < 2; b++) {
+            double value = qg[0] * effect[k][j][0][b] +
+                           qg[1] * effect[k][j][1][b] +
+                           qg[2] * effect[k][j][2][b];
+            P[2 * i + a][2 * j + b] += value;
+            if (i != j) {
+              P[2 * j + b][2 * i + a] += value;
+            }
+          }
+        }
+      }
+    }
+  }
+  for (int i = 0; i < variables; i++) {
+    P[i][i] += velocity_weight;
+  }
+
+  // The same QP in the side velocities themselves, which the constraints
+  // are on
+  double side_reference[MAX_VARIABLES];
+  for (int k = 0; k < steps; k++) {
+    double offset = reference[k].angular_velocity * half_track;
+    side_reference[2 * k] = reference[k].velocity - offset;
+    side_reference[2 * k + 1] = reference[k].velocity + offset;
+  }
+  for (int i = 0; i < variables; i++) {
+    for (int j = 0; j < variables; j++) {
+      q[i] -= P[i][j] * side_reference[j];
+    }
+  }
+  if (!warm || warm_horizon != steps) {
+    for (int i = 0; i < variables; i++) {
+      x[i] = side_reference[i];
+    }
+  }
+
+  // The acceleration and voltage of each side at each step. The voltage row
+  // is divided through by its coefficient, so that the rows are all about
+  // the same size for ADMM
+  int rows = 0;
+  for (int k = 0; k < steps; k++) {
+    for (int s = 0; s < 2; s++) {
+      const MpcSide &side = s == 0 ? left : right;
+      int index = 2 * k + s;
+      int previous_index = k > 0 ? index - 2 : -1;
+
+      double change = side.max_acceleration * h;
+      constraints[rows++] = {index, previous_index, 1, -1, -change, change};
+
+      double kv = side.kv + side.ka / h;
+      double headroom = std::max(side.max_voltage - side.ks, 0.0) / kv;
+      constraints[rows++] = {index,   previous_index, 1, -side.ka / h / kv,
+                             -headroom, headroom};
+    }
+  }
+  for (int r = 0; r < rows; r++) {
+    Constraint &row = constraints[r];
+    if (row.previous_index < 0) {
+      double now = row.index == 0 ? left_velocity : right_velocity;
+      row.lower -= row.previous_coefficient * now;
+      row.upper -= row.previous_coefficient * now;
+      row.previous_coefficient = 0;
+    }
+  }
+
+  if (!warm || warm_horizon != steps) {
+    for (int r = 0; r < rows; r++) {
+      const Constraint &row = constraints[r];
+      z[r] = row.coefficient * x[row.index];
+      if (row.previous_index >= 0) {
+        z[r] += row.previous_coefficient * x[row.previous_index];
+      }
+      y[r] = 0;
+    }
+  }
+  warm = true;
+  warm_horizon = steps;
+  return rows;
+}
+
+bool ModelPredictiveController::solve(int variables, int rows,
+                                      double start_time) {
+  // The penalty on the constraints, scaled to the cost
+  double trace = 0;
+  for (int i = 0; i < variables; i++) {
+    trace += P[i][i];
+  }
+  double rho = std::max(RHO_SCALE * trace / variables, 1e-6);
+
+  // P + sigma I + rho A'A, factored once for every iteration
+  for (int i = 0; i < variables; i++) {
+    for (int j = 0; j <= i; j++) {
+      L[i][j] = P[i][j];
+    }
+    L[i][i] += SIGMA;
+  }
+  for (int r = 0; r < rows; r++) {
+    const Constraint &row = constraints[r];
+    L[row.index][row.index] += rho * row.coefficient * row.coefficient;
+    if (row.previous_index >= 0) {
+      L[row.previous_index][row.previous_index] +=
+          rho * row.previous_coefficient * row.previous_coefficient;
+      // previous_index < index, so this is below the diagonal
+      L[row.index][row.previous_index] +=
+          rho * row.coefficient * row.previous_coefficient;
+    }
+  }
+  for (int j = 0; j < variables; j++) {
+    double diagonal = L[j][j];
+    for (int k = 0; k < j; k++) {
+      diagonal -= L[j][k] * L[j][k];
+    }
+    if (diagonal <= 0) {
+      return false;
+    }
+    L[j][j] = std::sqrt(diagonal);
+    for (int i = j + 1; i < variables; i++) {
+      double value = L[i][j];
+      for (int k = 0; k < j; k++) {
+        value -= L[i][k] * L[j][k];
+      }
+      L[i][j] = value / L[j][j];
+    }
+  }
+
+  double rhs[MAX_VARIABLES];
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    // x~ = (P + sigma I + rho A'A)^-1 (sigma x - q + A'(rho z - y))
+    for (int i = 0; i < variables; i++) {
+      rhs[i] = SIGMA * x[i] - q[i];
+    }
+    for (int r = 0; r < rows; r++) {
+      const Constraint &row = constraints[r];
+      double dual = rho * z[r] - y[r];
+      rhs[row.index] += row.coefficient * dual;
+      if (row.previous_index >= 0) {
+        rhs[row.previous_index] += row.previous_coefficient * dual;
+      }
+    }
+    for (int i = 0; i < variables; i++) {
+      for (int k = 0; k < i; k++) {
+        rhs[i] -= L[i][k] * rhs[k];
+      }
+      rhs[i] /= L[i][i];
+    }
+    for (int i = variables - 1; i >= 0; i--) {
+      for (int k = i + 1; k < variables; k++) {
+        rhs[i] -= L[k][i] * rhs[k];
+      }
+      rhs[i] /= L[i][i];
+    }
+
+    // Relaxed, then projected onto the bounds
+    for (int r = 0; r < rows; r++) {
+      const Constraint &row = constraints[r];
+      double ax = row.coefficient * rhs[row.index];
+      if (row.previous_index >= 0) {
+        ax += row.previous_coefficient * rhs[row.previous_index];
+      }
+      double relaxed = ALPHA * ax + (1 - ALPHA) * z[r];
+      double projected = clamp(relaxed + y[r] / rho, row.lower, row.upper);
+      y[r] += rho * (relaxed - projected);
+      z[r] = projected;
+    }
+    for (int i = 0; i < variables; i++) {
+      x[i] = ALPHA * rhs[i] + (1 - ALPHA) * x[i];
+    }
+
+    if (now_seconds() - start_time > time_budget) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ModelPredictiveController::calculate(
+    const TwoDPose &pose, const Trajectory &trajectory, double time,
+    double track_width, const MpcSide &left, const MpcSide &right,
+    double left_velocity, double right_velocity, double *left_target,
+    double *right_target) {
+  double start_time = now_seconds();
+  horizon = std::max(1, std::min(horizon, MAX_HORIZON));
+
+  bool solved = false;
+  if (track_width > 0 && left.kv > 0 && right.kv > 0) {
+    int rows = build(pose, trajectory, time, track_width, left, right,
+                     left_velocity, right_velocity);
+    solved = solve(2 * horizon, rows, start_time);
+  }
+
+  last_solve_time = now_seconds() - start_time;
+  max_solve_time = std::max(max_solve_time, last_solve_time);
+  if (!solved) {
+    fallbacks++;
+    return false;
+  }
+
+  // ADMM only meets the constraints in the limit, so the first step is held
+  // to them exactly. Its rows only bound that side
+  double targets[2] = {x[0], x[1]};
+  for (int s = 0; s < 2; s++) {
+    const Constraint &acceleration = constraints[2 * s];
+    const Constraint &voltage = constraints[2 * s + 1];
+    double lower = std::max(acceleration.lower, voltage.lower);
+    double upper = std::min(acceleration.upper, voltage.upper);
+    if (lower > upper) { // The voltage wins when both cannot be met
+      lower = voltage.lower;
+      upper = voltage.upper;
+    }
+    targets[s] = clamp(targets[s], lower, upper);
+  }
+  *left_target = targets[0];
+  *right_target = targets[1];
+  return true;
+}
+
+} // namespace whoop
@@ -0,0 +1,150 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       OccupancyGrid.cpp                                         */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Compact Bit-Packed Occupancy Grid of the Field            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/OccupancyGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+OccupancyGrid::OccupancyGrid(double width, double height, double resolution,
+                             double origin_x, double origin_y)
+    : width(width), height(height), resolution(resolution),
+      origin_x(origin_x), origin_y(origin_y) {
+  columns = std::max(1, static_cast<int>(std::ceil(width / resolution)));
+  rows = std::max(1, static_cast<int>(std::ceil(height / resolution)));
+  cells.assign((static_cast<size_t>(columns) * rows + 31) / 32, 0);
+}
+
+void OccupancyGrid::clear() { std::fill(cells.begin(), cells.end(), 0); }
+
+bool OccupancyGrid::in_bounds(int column, int row) const {
+  return column >= 0 && column < columns && row >= 0 && row < rows;
+}
+
+bool OccupancyGrid::to_cell(double x, double y, int &column,
+                            int &row) const {
+  column = static_cast<int>(std::floor((x - origin_x) / resolution));
+  row = static_cast<int>(std::floor((y - origin_y) / resolution));
+  return in_bounds(column, row);
+}
+
+void OccupancyGrid::set_cell(int column, int row, bool occupied) {
+  if (!in_bounds(column, row)) {
+    return;
+  }
+  size_t index = static_cast<size_t>(row) * columns + column;
+  if (occupied) {
+    cells[index >> 5] |= (1u << (index & 31));
+  } else {
+    cells[index >> 5] &= ~(1u << (index & 31));
+  }
+}
+
+bool OccupancyGrid::cell_occupied(int column, int row) const {
+  if (!in_bounds(column, row)) {
+    return true;
+  }
+  size_t index = static_cast<size_t>(row) * columns + column;
+  return (cells[index >> 5] >> (index & 31)) & 1u;
+}
+
+bool OccupancyGrid::is_occupied(double x, double y) const {
+  int column, row;
+  to_cell(x, y, column, row);
+  return cell_occupied(column, row);
+}
+
+void OccupancyGrid::add_rectangle(double x0, double y0, double x1, double y1,
+                                  bool occupied) {
+  int c0, r0, c1, r1;
+  to_cell(std::min(x0, x1), std::min(y0, y1), c0, r0);
+  to_cell(std::max(x0, x1), std::max(y0, y1), c1, r1);
+  for (int row = std::max(0, r0); row <= std::min(rows - 1, r1); row++) {
+    double cy = origin_y + (row + 0.5) * resolution;
+    if (cy < std::min(y0, y1) || cy > std::max(y0, y1)) {
+      continue;
+    }
+    for (int column = std::max(0, c0); column <= std::min(columns - 1, c1);
+         column++) {
+      double cx = origin_x + (column + 0.5) * resolution;
+      if (cx >= std::min(x0, x1) && cx <= std::max(x0, x1)) {
+        set_cell(column, row, occupied);
+      }
+    }
+  }
+}
+
+void OccupancyGrid::add_circle(double x, double y, double radius,
+                               bool occupied) {
+  int c0, r0, c1, r1;
+  to_cell(x - radius, y - radius, c0, r0);
+  to_cell(x + radius, y + radius, c1, r1);
+  for (int row = std::max(0, r0); row <= std::min(rows - 1, r1); row++) {
+    double dy = origin_y + (row + 0.5) * resolution - y;
+    for (int column = std::max(0, c0); column <= std::min(columns - 1, c1);
+         column++) {
+      double dx = origin_x + (column + 0.5) * resolution - x;
+      if (dx * dx + dy * dy <= radius * radius) {
+        set_cell(column, row, occupied);
+      }
+    }
+  }
+}
+
+OccupancyGrid OccupancyGrid::inflated(double radius) const {
+  OccupancyGrid result(width, height, resolution, origin_x, origin_y);
+  if (radius <= 0) {
+    result.cells = cells;
+    return result;
+  }
+
+  // Offsets of every cell within the radius, so each obstacle cell can be
+  // stamped without recomputing the distances
+  int reach = static_cast<int>(std::ceil(radius / resolution));
+  std::vector<std::pair<int, int>> disc;
+  for (int dr = -reach; dr <= reach; dr++) {
+    for (int dc = -reach; dc <= reach; dc++) {
+      if ((dc * dc + dr * dr) * resolution * resolution <= radius * radius) {
+        disc.push_back({dc, dr});
+      }
+    }
+  }
+
+  for (int row = 0; row < rows; row++) {
+    for (int column = 0; column < columns; column++) {
+      if (!cell_occupied(column, row)) {
+        continue;
+      }
+      for (const auto &offset : disc) {
+        result.set_cell(column + offset.first, row + offset.second);
+      }
+    }
+  }
+
+  // The edges of the grid act as walls
+  for (int row = 0; row < rows; row++) {
+    double cy = (row + 0.5) * resolution;
+    for (int column = 0; column < columns; column++) {
+      double cx = (column + 0.5) * resolution;
+      if (cx < radius || cy < radius || width - cx < radius ||
+          height - cy < radius) {
+        result.set_cell(column, row);
+      }
+    }
+  }
+
+  return result;
+}
+
+size_t OccupancyGrid::memory_usage() const {
+  return cells.size() * sizeof(uint32_t);
+}
+
+} // namespace whoop
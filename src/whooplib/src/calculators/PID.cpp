@@ -24,35 +24,44 @@ namespace whoop {
  * @param starti Maximum error to start integrating
  */
 
-PID::PID(double error, double kp, double ki, double kd, double ka, double starti,
-         double max_integral_power)
+template <typename Scalar>
+PIDT<Scalar>::PIDT(Scalar error, Scalar kp, Scalar ki, Scalar kd, Scalar ka,
+                   Scalar starti, Scalar max_integral_power)
     : error(error), kp(kp), ki(ki), kd(kd), ka(ka), starti(starti),
       max_integral_power(max_integral_power) {
   max_integral_power_scaled = max_integral_power / ki;
 }
 
-PID::PID(double error, double kp, double ki, double kd, double ka, double starti,
-         double max_integral_power, double settle_error, double settle_time,
-         double timeout)
+template <typename Scalar>
+PIDT<Scalar>::PIDT(Scalar error, Scalar kp, Scalar ki, Scalar kd, Scalar ka,
+                   Scalar starti, Scalar max_integral_power,
+                   Scalar settle_error, Scalar settle_time, Scalar timeout)
     : error(error), kp(kp), ki(ki), kd(kd), ka(ka), starti(starti),
       settle_error(settle_error), settle_time(settle_time), timeout(timeout),
       max_integral_power(max_integral_power) {
   max_integral_power_scaled = max_integral_power / ki;
 }
 
-double PID::step(double error) {
+template <typename Scalar> Scalar PIDT<Scalar>::step(Scalar error) {
+  return step(error, update_period / 1000);
+}
+
+template <typename Scalar>
+Scalar PIDT<Scalar>::step(Scalar error, Scalar dt) {
+  // How many update periods the step took, which is 1 at 10ms
+  Scalar periods = dt * 1000 / update_period;
 
-  double derivative = error - previous_error;
-  double error_abs = fabs(error);
+  Scalar derivative = (error - previous_error) / periods;
+  Scalar error_abs = std::fabs(error);
 
   if (reject_first_accumulation) {
     reject_first_accumulation = false;
   } else {
     if (error_abs < starti) {
-      accumulated_error += error;
+      accumulated_error += error * periods;
 
       // Anti-Windup 
-      accumulated_error -= derivative * (1 - error_abs / starti) * ka;
+      accumulated_error -= derivative * periods * (1 - error_abs / starti) * ka;
     } else {
       accumulated_error = 0;
     }
@@ -64,7 +73,7 @@ double PID::step(double error) {
   //   accumulated_error = 0;
   // }
 
-  double max_integral_power_scaled = max_integral_power / ki;
+  Scalar max_integral_power_scaled = max_integral_power / ki;
   if (accumulated_error > max_integral_power_scaled)
     accumulated_error = max_integral_power_scaled;
   if (accumulated_error < -max_integral_power_scaled)
@@ -75,17 +84,17 @@ double PID::step(double error) {
   previous_error = error;
 
   if (error_abs < settle_error) {
-    time_spent_settled += 10;
+    time_spent_settled += dt * 1000;
   } else {
     time_spent_settled = 0;
   }
 
-  time_spent_running += 10;
+  time_spent_running += dt * 1000;
 
   return output;
 }
 
-bool PID::is_settled() {
+template <typename Scalar> bool PIDT<Scalar>::is_settled() {
   if (timeout != 0 && time_spent_running > timeout * 1000) {
     return (true);
   } // If timeout does equal 0, the move will never actually time out. Setting
@@ -97,7 +106,7 @@ bool PID::is_settled() {
   return (false);
 }
 
-bool PID::settling() {
+template <typename Scalar> bool PIDT<Scalar>::settling() {
   if (is_settled()) {
     return true;
   }
@@ -107,9 +116,27 @@ bool PID::settling() {
   return false;
 }
 
-void PID::zeroize_accumulated() {
+template <typename Scalar> void PIDT<Scalar>::zeroize_accumulated() {
   accumulated_error = 0;
   reject_first_accumulation = true;
 }
 
+template <typename Scalar>
+void PIDT<Scalar>::seed(Scalar error, Scalar output) {
+  previous_error = error;
+  accumulated_error = 0;
+  if (ki != 0 && std::fabs(error) < starti) {
+    Scalar max_integral_power_scaled = max_integral_power / ki;
+    accumulated_error = (output - kp * error) / ki;
+    if (accumulated_error > max_integral_power_scaled)
+      accumulated_error = max_integral_power_scaled;
+    if (accumulated_error < -max_integral_power_scaled)
+      accumulated_error = -max_integral_power_scaled;
+  }
+  this->output = output;
+}
+
+template class PIDT<double>;
+template class PIDT<float>;
+
 } // namespace whoop
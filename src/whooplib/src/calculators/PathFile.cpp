@@ -0,0 +1,217 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PathFile.cpp                                              */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Versioned Binary File Format for Pure Pursuit Paths       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/PathFile.hpp"
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace whoop {
+
+// The records are copied as-is, so their layout is part of the file format
+static_assert(sizeof(PathFileHeader) == 176, "Path file header changed");
+static_assert(sizeof(PathFilePose) == 24, "Path file pose changed");
+static_assert(sizeof(barebonesPose) == 24, "barebonesPose changed");
+static_assert(sizeof(pursuitCheckpoint) == 16, "pursuitCheckpoint changed");
+static_assert(sizeof(pursuitLeg) == 32, "pursuitLeg changed");
+static_assert(sizeof(PathPrimitive) == 64, "PathPrimitive changed");
+static_assert(std::is_trivially_copyable<barebonesPose>::value &&
+                  std::is_trivially_copyable<pursuitCheckpoint>::value &&
+                  std::is_trivially_copyable<pursuitLeg>::value &&
+                  std::is_trivially_copyable<PathPrimitive>::value,
+              "Path file records must be trivially copyable");
+
+static PathFilePose to_file_pose(const TwoDPose &pose) {
+  return {pose.x, pose.y, pose.yaw};
+}
+
+static TwoDPose from_file_pose(const PathFilePose &pose) {
+  return TwoDPose(pose.x, pose.y, pose.yaw);
+}
+
+template <typename T>
+static void append_array(std::vector<uint8_t> &bytes, const T *items,
+                         size_t count) {
+  size_t offset = bytes.size();
+  bytes.resize(offset + count * sizeof(T));
+  if (count > 0) {
+    std::memcpy(bytes.data() + offset, items, count * sizeof(T));
+  }
+}
+
+template <typename T>
+static const uint8_t *read_array(const uint8_t *cursor, std::vector<T> &items,
+                                 size_t count) {
+  items.resize(count);
+  if (count > 0) {
+    std::memcpy(items.data(), cursor, count * sizeof(T));
+  }
+  return cursor + count * sizeof(T);
+}
+
+/**
+ * @returns true if the checkpoints and legs of a sampled path only index its
+ * pursuit points. Those of an analytic path are by arc length instead, and
+ * the indexes are not used
+ */
+static bool valid_indexes(const PathFileHeader &header,
+                          const std::vector<pursuitCheckpoint> &checkpoints,
+                          const std::vector<pursuitLeg> &legs) {
+  if (header.path_representation != pathrepresentation::path_sampled) {
+    return true;
+  }
+  for (const pursuitCheckpoint &checkpoint : checkpoints) {
+    if (checkpoint.i >= header.num_points) {
+      return false;
+    }
+  }
+  for (const pursuitLeg &leg : legs) {
+    if (leg.start_i > leg.end_i || leg.end_i >= header.num_points) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<uint8_t> serialize_path(const PurePursuitPath &path) {
+  PathFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = PATH_FILE_MAGIC;
+  header.version = PATH_FILE_VERSION;
+  header.header_size = sizeof(PathFileHeader);
+  header.path_representation = static_cast<uint8_t>(path.path_representation);
+  header.path_planner = static_cast<uint8_t>(path.path_planner);
+  header.path_valid = path.path_valid ? 1 : 0;
+  header.num_waypoints = path.waypoints.size();
+  header.num_points = path.pursuit_points.size();
+  header.num_checkpoints = path.pursuit_checkpoints.size();
+  header.num_legs = path.pursuit_legs.size();
+  header.num_primitives = path.analytic_path.primitives.size();
+  header.num_stations = path.velocity_profile.stations.size();
+
+  header.turning_radius = path.turning_radius;
+  header.lookahead_distance = path.lookahead_distance;
+  header.num_segments = path.num_segments;
+  header.landing_strip = path.landing_strip;
+  header.push_back_distance = path.push_back_distance;
+  header.smoothing_length = path.smoothing_length;
+  header.step_size = path.step_size;
+  header.t_max = path.t_max;
+
+  header.start = to_file_pose(path.start);
+  header.end = to_file_pose(path.end);
+  header.end_translated_back = to_file_pose(path.end_translated_back);
+
+  std::vector<PathFilePose> waypoints;
+  waypoints.reserve(path.waypoints.size());
+  for (const TwoDPose &waypoint : path.waypoints) {
+    waypoints.push_back(to_file_pose(waypoint));
+  }
+
+  std::vector<uint8_t> bytes;
+  bytes.reserve(sizeof(PathFileHeader) +
+                waypoints.size() * sizeof(PathFilePose) +
+                header.num_points * sizeof(barebonesPose) +
+                header.num_checkpoints * sizeof(pursuitCheckpoint) +
+                header.num_legs * sizeof(pursuitLeg) +
+                header.num_primitives * sizeof(PathPrimitive) +
+                header.num_stations * 2 * sizeof(double));
+  append_array(bytes, &header, 1);
+  append_array(bytes, waypoints.data(), waypoints.size());
+  append_array(bytes, path.pursuit_points.data(), header.num_points);
+  append_array(bytes, path.pursuit_checkpoints.data(), header.num_checkpoints);
+  append_array(bytes, path.pursuit_legs.data(), header.num_legs);
+  append_array(bytes, path.analytic_path.primitives.data(),
+               header.num_primitives);
+  append_array(bytes, path.velocity_profile.stations.data(),
+               header.num_stations);
+  append_array(bytes, path.velocity_profile.velocities.data(),
+               header.num_stations);
+  return bytes;
+}
+
+bool deserialize_path(const uint8_t *data, size_t size,
+                      PurePursuitPath &path) {
+  if (data == nullptr || size < sizeof(PathFileHeader)) {
+    return false;
+  }
+
+  PathFileHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != PATH_FILE_MAGIC ||
+      header.version != PATH_FILE_VERSION ||
+      header.header_size != sizeof(PathFileHeader)) {
+    return false;
+  }
+
+  size_t expected = sizeof(PathFileHeader) +
+                    header.num_waypoints * sizeof(PathFilePose) +
+                    header.num_points * sizeof(barebonesPose) +
+                    header.num_checkpoints * sizeof(pursuitCheckpoint) +
+                    header.num_legs * sizeof(pursuitLeg) +
+                    header.num_primitives * sizeof(PathPrimitive) +
+                    header.num_stations * 2 * sizeof(double);
+  if (size != expected ||
+      header.path_representation > pathrepresentation::path_analytic ||
+      header.path_planner > pathplanner::planner_reeds_shepp) {
+    return false;
+  }
+
+  // The arrays are checked before any of them is loaded into the path
+  const uint8_t *cursor = data + sizeof(PathFileHeader);
+  std::vector<PathFilePose> waypoints;
+  std::vector<barebonesPose> points;
+  std::vector<pursuitCheckpoint> checkpoints;
+  std::vector<pursuitLeg> legs;
+  cursor = read_array(cursor, waypoints, header.num_waypoints);
+  cursor = read_array(cursor, points, header.num_points);
+  cursor = read_array(cursor, checkpoints, header.num_checkpoints);
+  cursor = read_array(cursor, legs, header.num_legs);
+  if (!valid_indexes(header, checkpoints, legs)) {
+    return false;
+  }
+
+  path.path_representation =
+      static_cast<pathrepresentation>(header.path_representation);
+  path.path_planner = static_cast<pathplanner>(header.path_planner);
+  path.path_valid = header.path_valid != 0;
+
+  path.turning_radius = header.turning_radius;
+  path.lookahead_distance = header.lookahead_distance;
+  path.num_segments = header.num_segments;
+  path.landing_strip = header.landing_strip;
+  path.push_back_distance = header.push_back_distance;
+  path.smoothing_length = header.smoothing_length;
+  path.step_size = header.step_size;
+  path.t_max = header.t_max;
+
+  path.start = from_file_pose(header.start);
+  path.end = from_file_pose(header.end);
+  path.end_translated_back = from_file_pose(header.end_translated_back);
+
+  path.waypoints.clear();
+  path.waypoints.reserve(waypoints.size());
+  for (const PathFilePose &pose : waypoints) {
+    path.waypoints.push_back(from_file_pose(pose));
+  }
+  path.pursuit_points = std::move(points);
+  path.pursuit_checkpoints = std::move(checkpoints);
+  path.pursuit_legs = std::move(legs);
+  cursor = read_array(cursor, path.analytic_path.primitives,
+                      header.num_primitives);
+  cursor = read_array(cursor, path.velocity_profile.stations,
+                      header.num_stations);
+  read_array(cursor, path.velocity_profile.velocities, header.num_stations);
+
+  // The path may have been saved part of the way through being driven
+  path.reset_progress();
+  return true;
+}
+
+} // namespace whoop
@@ -0,0 +1,461 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PathFollower.cpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Path Followers of the Pure Pursuit Conductor              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/PathFollower.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+void pursuit_side_powers(double forward_power, double steering_power,
+                         bool point_turn, bool reverse_drive,
+                         double *left_power, double *right_power) {
+  if (point_turn) {
+    double forward = reverse_drive ? -forward_power : forward_power;
+    *left_power = forward - steering_power / 1.5;
+    *right_power = forward + steering_power / 1.5;
+  } else if (reverse_drive) {
+    *left_power = -forward_power + std::max(-steering_power, 0.0);
+    *right_power = -forward_power + std::max(steering_power, 0.0);
+  } else {
+    *left_power = forward_power + std::min(-steering_power, 0.0);
+    *right_power = forward_power + std::min(steering_power, 0.0);
+  }
+}
+
+void pursuit_powers_of_sides(double left_power, double right_power,
+                             bool point_turn, bool reverse_drive,
+                             double *forward_power, double *steering_power) {
+  if (point_turn) {
+    double forward = (left_power + right_power) / 2;
+    *forward_power = reverse_drive ? -forward : forward;
+    *steering_power = 1.5 * (right_power - left_power) / 2;
+  } else {
+    // Only the inner side of a swing turn is slowed by the turn
+    *forward_power = reverse_drive ? -std::min(left_power, right_power)
+                                   : std::max(left_power, right_power);
+    *steering_power = right_power - left_power;
+  }
+}
+
+void PurePursuitFollower::reset() {
+  wipe_turn_once = false;
+  profile_velocity_command = 0;
+  reference_remaining = -1;
+}
+
+double PurePursuitFollower::step_feedforward(const PursuitEstimate &estimate,
+                                             double dt, double *turn_power) {
+  PursuitParams *params = conductor->default_pursuit_parameters;
+  PurePursuitPath &pursuit_path = conductor->pursuit_path;
+
+  // Each leg of the path starts from rest at its cusp
+  if (reference_remaining < 0 || estimate.direction != reference_direction) {
+    reference_remaining = std::max(estimate.distance, 0.0);
+    reference_direction = estimate.direction;
+    profile_velocity_command = 0;
+  }
+
+  // The drivetrain swaps the sides when driving backwards, so the constants
+  // are swapped to stay with their motors
+  bool swap_sides = conductor->reversed != (estimate.direction < 0);
+  const MotorFeedforward &left = swap_sides ? conductor->right_feedforward
+                                            : conductor->left_feedforward;
+  const MotorFeedforward &right = swap_sides ? conductor->left_feedforward
+                                             : conductor->right_feedforward;
+
+  // The turn comes from the curvature of the path, and the turning PID
+  // corrects the steering angle that is left over. The motors take about
+  // ka / kv seconds to respond, so the curvature is looked up that far ahead
+  double response_time = (left.ka / left.kv + right.ka / right.kv) / 2;
+  double curvature = pursuit_path.path_curvature(
+      estimate.distance - profile_velocity_command * response_time);
+  double half_track = params->track_width / 2;
+
+  // The target velocity can stop by the end of the reference, and the outer
+  // side of a turn stays within the max voltage
+  double max_voltage = params->forward_max_voltage;
+  double target = std::min(
+      std::sqrt(2 * params->max_deceleration * reference_remaining),
+      std::min(left.max_velocity(max_voltage),
+               right.max_velocity(max_voltage)) /
+          (1 + std::abs(curvature) * half_track));
+  if (!pursuit_path.velocity_profile.empty()) {
+    target =
+        std::min(target, pursuit_path.profile_velocity(reference_remaining));
+  }
+
+  // The reference eases toward the target at the acceleration limits, so that
+  // a sharper turn ahead slows it rather than drops it in a step
+  double velocity =
+      clamp(target, profile_velocity_command - params->max_deceleration * dt,
+            profile_velocity_command + params->max_acceleration * dt);
+  double acceleration = (velocity - profile_velocity_command) / dt;
+  profile_velocity_command = velocity;
+
+  // The reference never gets more than the look ahead distance ahead of the
+  // robot, so that it waits when the robot is held back
+  reference_remaining = std::max(reference_remaining - velocity * dt, 0.0);
+  reference_remaining = std::max(
+      reference_remaining, estimate.distance - params->lookahead_distance);
+
+  // Splitting the velocity between the sides along the arc
+  double left_scale = 1 - curvature * half_track;
+  double right_scale = 1 + curvature * half_track;
+  double left_voltage =
+      left.calculate(velocity * left_scale, acceleration * left_scale);
+  double right_voltage =
+      right.calculate(velocity * right_scale, acceleration * right_scale);
+
+  // WhoopDrivetrain gives the forward voltage to the outer side of a swing
+  // turn, and subtracts the turning voltage from the inner side
+  *turn_power = right_voltage - left_voltage;
+  return std::max(left_voltage, right_voltage);
+}
+
+PursuitResult PurePursuitFollower::steer(const TwoDPose &current_pose,
+                                         double dt) {
+  PurePursuitConductor &c = *conductor;
+  PursuitParams *params = c.default_pursuit_parameters;
+
+  PursuitEstimate estimate;
+  if (c.is_turn) { // If command is to turn
+    estimate = PursuitEstimate(
+        true, control_normalize_angle(c.turn_pose.yaw - current_pose.yaw), 0,
+        true, 0, true);
+    estimate.last_steering = estimate.steering_angle;
+  } else {
+    estimate = c.pursuit_path.calculate_pursuit_estimate(
+        current_pose, true, c.forward_pid.settle_error);
+  }
+
+  if (!estimate.is_valid) { // If error or something, return is_valid as false
+    return PursuitResult(false, 0, 0, 0, 0, false);
+  }
+
+  // A chained motion leaves the motors as they are for the next motion
+  if (c.chain_exited(current_pose, estimate, dt)) {
+    PursuitResult result(true, estimate.steering_angle, estimate.distance, 0,
+                         0, true, estimate.suggest_point_turn,
+                         estimate.direction);
+    result.chained = true;
+    return result;
+  }
+  c.apply_hand_off(estimate);
+
+  double forward_power = 0;
+  double turn_feedforward = 0;
+  if (!c.is_turn && c.feedforward_enabled()) {
+    // The forward PID still decides when the path is settled, and the
+    // tracking PID corrects the distance behind the reference. The slew is
+    // left out, as the reference is already acceleration-limited
+    c.forward_pid.step(estimate.distance, dt);
+    forward_power = step_feedforward(estimate, dt, &turn_feedforward);
+    forward_power +=
+        c.tracking_pid.step(estimate.distance - reference_remaining, dt);
+  } else {
+    forward_power =
+        c.forward_slew.step(c.forward_pid.step(estimate.distance, dt), dt);
+  }
+
+  // Cap the forward power to the velocity profile, if there is one
+  if (!c.is_turn && !c.feedforward_enabled() &&
+      !c.pursuit_path.velocity_profile.empty()) {
+    profile_velocity_command =
+        std::min(c.pursuit_path.profile_velocity(estimate.distance),
+                 profile_velocity_command + params->max_acceleration * dt);
+    double max_power = profile_velocity_command / params->max_velocity *
+                       params->forward_max_voltage;
+    forward_power = clamp(forward_power, -max_power, max_power);
+  }
+  if (c.forward_pid.settling()) {
+    // A turn slews down the forward power that a chained motion handed off
+    if (!c.is_turn) {
+      forward_power = 0;
+    }
+    turn_feedforward = 0;
+    c.forward_pid.zeroize_accumulated();
+    estimate.steering_angle = estimate.last_steering;
+    estimate.suggest_point_turn = true;
+    if (!wipe_turn_once) {
+      wipe_turn_once = true;
+      c.turn_pid.zeroize_accumulated();
+    }
+  } else if (wipe_turn_once) {
+    wipe_turn_once = false;
+  }
+
+  double turn_power =
+      c.turn_slew.step(c.turn_pid.step(estimate.steering_angle, dt), dt) +
+      turn_feedforward;
+  if (c.turn_pid.settling()) {
+    turn_power = 0;
+    c.turn_pid.zeroize_accumulated();
+  }
+
+  return PursuitResult(
+      true, estimate.steering_angle, estimate.distance,
+      clamp(forward_power, -params->forward_max_voltage,
+            params->forward_max_voltage),
+      clamp(turn_power, -params->turning_max_voltage,
+            params->turning_max_voltage),
+      false, estimate.suggest_point_turn, estimate.direction);
+}
+
+void PurePursuitFollower::settle(PursuitResult *result) {
+  PurePursuitConductor &c = *conductor;
+
+  // Cusps are driven through, so only the end of the last leg completes
+  if ((c.forward_pid.is_settled()) && c.turn_pid.is_settled() &&
+      (c.is_turn || c.pursuit_path.on_final_leg())) {
+    result->is_completed = true;
+  } else if (c.turn_pid.settling() && !c.forward_pid.settling()) {
+    c.turn_pid.time_spent_settled = 0;
+  }
+}
+
+PursuitResult PurePursuitFollower::step(const TwoDPose &current_pose,
+                                        double dt) {
+  PursuitResult result = steer(current_pose, dt);
+  if (result.is_valid && !result.chained) {
+    settle(&result);
+  }
+  return result;
+}
+
+void TrajectoryFollower::reset() {
+  trajectory.clear();
+  trajectory_time = -1;
+}
+
+void TrajectoryFollower::start_trajectory() {
+  PursuitParams *params = conductor->default_pursuit_parameters;
+  const MotorFeedforward &left_feedforward = conductor->left_feedforward;
+  const MotorFeedforward &right_feedforward = conductor->right_feedforward;
+  trajectory_time = 0;
+  last_left_reference = 0;
+  last_right_reference = 0;
+  last_left_velocity = 0;
+  last_right_velocity = 0;
+
+  // The trajectory is planned with 90% of forward_max_voltage, which leaves
+  // the rest for RAMSETE or MPC to correct with
+  double voltage = 0.9 * params->forward_max_voltage;
+  double max_velocity = 0.9 * params->max_velocity;
+  double max_acceleration = params->max_acceleration;
+  double free_velocity = 0;
+  if (conductor->feedforward_enabled()) {
+    free_velocity = std::min(left_feedforward.max_velocity(voltage),
+                             right_feedforward.max_velocity(voltage));
+    if (max_velocity <= 0 || free_velocity < max_velocity) {
+      max_velocity = free_velocity;
+    }
+    // From rest, a side accelerates at (voltage - ks) / ka at most
+    for (const MotorFeedforward *side :
+         {&left_feedforward, &right_feedforward}) {
+      if (side->ka > 0) {
+        max_acceleration =
+            std::min(max_acceleration, (voltage - side->ks) / side->ka);
+      }
+    }
+  }
+
+  // Without a way to turn velocities into voltages, the path is followed
+  // with pure pursuit instead
+  if (max_velocity <= 0) {
+    trajectory.clear();
+    return;
+  }
+  conductor->pursuit_path.generate_trajectory(
+      trajectory, max_velocity, max_acceleration, params->max_deceleration,
+      params->max_lateral_acceleration, params->track_width, free_velocity);
+}
+
+double TrajectoryFollower::side_voltage(const MotorFeedforward &side,
+                                        double velocity,
+                                        double acceleration) const {
+  if (conductor->feedforward_enabled()) {
+    return side.calculate(velocity, acceleration);
+  }
+  // The same proportion as the velocity profile cap
+  PursuitParams *params = conductor->default_pursuit_parameters;
+  return velocity / params->max_velocity * params->forward_max_voltage;
+}
+
+void TrajectoryFollower::step_trajectory(const TwoDPose &current_pose,
+                                         double dt, PursuitResult *result) {
+  PursuitParams *params = conductor->default_pursuit_parameters;
+  double half_track = params->track_width / 2;
+
+  double time = trajectory_time;
+  TrajectoryState reference = trajectory.sample(time);
+  trajectory_time += dt;
+
+  // The acceleration of each side is taken from the reference alone, so
+  // that noise in the pose is not amplified by ka
+  double left_reference =
+      reference.velocity - reference.angular_velocity * half_track;
+  double right_reference =
+      reference.velocity + reference.angular_velocity * half_track;
+  double left_acceleration = (left_reference - last_left_reference) / dt;
+  double right_acceleration = (right_reference - last_right_reference) / dt;
+  last_left_reference = left_reference;
+  last_right_reference = right_reference;
+
+  // The pose faces backwards when the whole move is in reverse, which puts
+  // each side's motors on the other side
+  bool reversed = conductor->reversed;
+  const MotorFeedforward &left = reversed ? conductor->right_feedforward
+                                          : conductor->left_feedforward;
+  const MotorFeedforward &right = reversed ? conductor->left_feedforward
+                                           : conductor->right_feedforward;
+
+  // The velocity of each side, measured from the change in pose since the
+  // last step (or the last targets, before there is one)
+  bool measured = time > 0;
+  double measured_left = last_left_velocity;
+  double measured_right = last_right_velocity;
+  if (measured) {
+    double sin_yaw, cos_yaw;
+    control_sincos(current_pose.yaw, &sin_yaw, &cos_yaw);
+    double measured_velocity = ((current_pose.x - last_pose.x) * cos_yaw +
+                                (current_pose.y - last_pose.y) * sin_yaw) /
+                               dt;
+    double measured_angular_velocity =
+        control_normalize_angle(current_pose.yaw - last_pose.yaw) / dt;
+    measured_left = measured_velocity - measured_angular_velocity * half_track;
+    measured_right =
+        measured_velocity + measured_angular_velocity * half_track;
+  }
+  last_pose = current_pose;
+
+  double left_velocity, right_velocity;
+  if (!side_velocities(current_pose, reference, time, left, right,
+                       measured_left, measured_right, &left_velocity,
+                       &right_velocity, result)) {
+    return;
+  }
+  last_left_velocity = left_velocity;
+  last_right_velocity = right_velocity;
+
+  double left_power = side_voltage(left, left_velocity, left_acceleration);
+  double right_power =
+      side_voltage(right, right_velocity, right_acceleration);
+
+  // Corrects each side by how far it is from its target velocity
+  if (measured) {
+    left_power += wheel_velocity_kp * (left_velocity - measured_left);
+    right_power += wheel_velocity_kp * (right_velocity - measured_right);
+  }
+
+  // Both sides are scaled down together, to keep the curvature
+  double largest = std::max(std::abs(left_power), std::abs(right_power));
+  if (largest > params->forward_max_voltage) {
+    left_power *= params->forward_max_voltage / largest;
+    right_power *= params->forward_max_voltage / largest;
+  }
+
+  result->is_completed = false;
+  result->has_side_powers = true;
+  result->left_power = left_power;
+  result->right_power = right_power;
+  result->left_velocity = left_velocity;
+  result->right_velocity = right_velocity;
+  result->forward_power = (left_power + right_power) / 2;
+  result->steering_power = (right_power - left_power) / 2;
+}
+
+PursuitResult TrajectoryFollower::step(const TwoDPose &current_pose,
+                                       double dt) {
+  // The PIDs are stepped either way, so that they take over smoothly
+  PursuitResult result = conductor->pure_pursuit.steer(current_pose, dt);
+  if (!result.is_valid || result.chained) {
+    return result;
+  }
+
+  // The trajectory is driven until it is over, and then pure pursuit
+  // settles the robot at the end
+  if (!conductor->is_turn) {
+    if (trajectory_time < 0) {
+      start_trajectory();
+    }
+    if (!trajectory.empty() && trajectory_time <= trajectory.duration()) {
+      step_trajectory(current_pose, dt, &result);
+      return result;
+    }
+  }
+  conductor->pure_pursuit.settle(&result);
+  return result;
+}
+
+void RamseteFollower::reset() {
+  TrajectoryFollower::reset();
+  const RamseteParams &params = conductor->default_pursuit_parameters->ramsete;
+  ramsete = RamseteController(params.b, params.zeta);
+  wheel_velocity_kp = params.wheel_velocity_kp;
+}
+
+bool RamseteFollower::side_velocities(
+    const TwoDPose &current_pose, const TrajectoryState &reference,
+    double /*time*/, const MotorFeedforward & /*left*/,
+    const MotorFeedforward & /*right*/, double /*measured_left*/,
+    double /*measured_right*/, double *left_velocity, double *right_velocity,
+    PursuitResult * /*result*/) {
+  double half_track = conductor->default_pursuit_parameters->track_width / 2;
+  double velocity, angular_velocity;
+  ramsete.calculate(current_pose, reference, &velocity, &angular_velocity);
+  *left_velocity = velocity - angular_velocity * half_track;
+  *right_velocity = velocity + angular_velocity * half_track;
+  return true;
+}
+
+void MpcFollower::reset() {
+  TrajectoryFollower::reset();
+  const MpcParams &params = conductor->default_pursuit_parameters->mpc;
+  mpc.horizon = params.horizon;
+  mpc.time_budget = params.time_budget;
+  mpc.reset();
+  wheel_velocity_kp = params.wheel_velocity_kp;
+}
+
+bool MpcFollower::side_velocities(
+    const TwoDPose &current_pose, const TrajectoryState & /*reference*/,
+    double time, const MotorFeedforward &left, const MotorFeedforward &right,
+    double measured_left, double measured_right, double *left_velocity,
+    double *right_velocity, PursuitResult *result) {
+  PursuitParams *params = conductor->default_pursuit_parameters;
+
+  // Without feedforward, the voltage is in proportion to max_velocity, as
+  // in side_voltage
+  double max_voltage = params->forward_max_voltage;
+  MpcSide left_side(left.ks, left.kv, left.ka, max_voltage,
+                    params->max_acceleration);
+  MpcSide right_side(right.ks, right.kv, right.ka, max_voltage,
+                     params->max_acceleration);
+  if (!conductor->feedforward_enabled() && params->max_velocity > 0) {
+    left_side = MpcSide(0, max_voltage / params->max_velocity, 0, max_voltage,
+                        params->max_acceleration);
+    right_side = left_side;
+  }
+  bool solved = mpc.calculate(current_pose, trajectory, time,
+                              params->track_width, left_side, right_side,
+                              measured_left, measured_right, left_velocity,
+                              right_velocity);
+  result->solve_time = mpc.last_solve_time;
+  if (!solved) {
+    result->fell_back = true;
+    return false;
+  }
+  return true;
+}
+
+} // namespace whoop
@@ -0,0 +1,210 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PoseEKF.cpp                                               */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Extended Kalman Filter of a Pose in the Plane             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/PoseEKF.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace whoop {
+
+// Frames less confident than this are trusted as if they were this confident,
+// so the noise stays finite
+static const double MIN_CONFIDENCE = 0.05;
+
+/**
+ * Inverts a 3x3 matrix
+ * @returns false if it is singular
+ */
+static bool invert_3x3(const double m[3][3], double inverse[3][3]) {
+  double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+  double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+  double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+  double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+  if (std::abs(det) < 1e-18) {
+    return false;
+  }
+  double inv_det = 1.0 / det;
+  inverse[0][0] = c00 * inv_det;
+  inverse[1][0] = c01 * inv_det;
+  inverse[2][0] = c02 * inv_det;
+  inverse[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det;
+  inverse[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det;
+  inverse[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det;
+  inverse[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+  inverse[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+  inverse[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+  return true;
+}
+
+PoseEKF::PoseEKF() { reset(TwoDPose(0, 0, 0)); }
+
+void PoseEKF::reset(const TwoDPose &pose, double position_std,
+                    double yaw_std) {
+  state[0] = pose.x;
+  state[1] = pose.y;
+  state[2] = pose.yaw;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      covariance[i][j] = 0;
+    }
+  }
+  covariance[0][0] = covariance[1][1] = position_std * position_std;
+  covariance[2][2] = yaw_std * yaw_std;
+  rejections_in_a_row = 0;
+}
+
+void PoseEKF::predict(double dx, double dy, double dyaw, double odom_yaw,
+                      double dt) {
+  // The step, turned from the frame of the odometry into that of the estimate
+  double rotation = state[2] - odom_yaw;
+  double c = std::cos(rotation);
+  double s = std::sin(rotation);
+  double world_dx = c * dx - s * dy;
+  double world_dy = s * dx + c * dy;
+
+  state[0] += world_dx;
+  state[1] += world_dy;
+  state[2] = normalize_angle(state[2] + dyaw);
+
+  // P = F P F^T, where F = [1 0 -world_dy; 0 1 world_dx; 0 0 1] is how the
+  // step moves with the yaw of the estimate
+  double fp[3][3];
+  for (int j = 0; j < 3; j++) {
+    fp[0][j] = covariance[0][j] - world_dy * covariance[2][j];
+    fp[1][j] = covariance[1][j] + world_dx * covariance[2][j];
+    fp[2][j] = covariance[2][j];
+  }
+  for (int i = 0; i < 3; i++) {
+    covariance[i][0] = fp[i][0] - world_dy * fp[i][2];
+    covariance[i][1] = fp[i][1] + world_dx * fp[i][2];
+    covariance[i][2] = fp[i][2];
+  }
+
+  // The odometry is a random walk over the distance and the turn
+  double translation_variance =
+      odom_translation_noise * odom_translation_noise * std::hypot(dx, dy);
+  covariance[0][0] += translation_variance;
+  covariance[1][1] += translation_variance;
+  covariance[2][2] += odom_rotation_noise * odom_rotation_noise *
+                          std::abs(dyaw) +
+                      yaw_drift_noise * yaw_drift_noise * std::max(dt, 0.0);
+}
+
+bool PoseEKF::update(double x, double y, double yaw, double confidence) {
+  double trust = std::max(confidence, MIN_CONFIDENCE);
+  double position_variance =
+      vision_position_noise * vision_position_noise / (trust * trust);
+  double yaw_variance = vision_yaw_noise * vision_yaw_noise / (trust * trust);
+  double noise[3] = {position_variance, position_variance, yaw_variance};
+
+  double innovation[3] = {x - state[0], y - state[1],
+                          normalize_angle(yaw - state[2])};
+
+  // S = P + R, and its inverse
+  double s[3][3], s_inverse[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      s[i][j] = covariance[i][j] + (i == j ? noise[i] : 0);
+    }
+  }
+  if (!invert_3x3(s, s_inverse)) {
+    return false;
+  }
+
+  // Mahalanobis distance squared of the innovation
+  last_distance = 0;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      last_distance += innovation[i] * s_inverse[i][j] * innovation[j];
+    }
+  }
+  if (last_distance > gate_threshold &&
+      rejections_in_a_row < max_rejections) {
+    rejections_in_a_row++;
+    rejected++;
+    return false;
+  }
+  rejections_in_a_row = 0;
+  accepted++;
+
+  // K = P S^-1
+  double gain[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      gain[i][j] = 0;
+      for (int k = 0; k < 3; k++) {
+        gain[i][j] += covariance[i][k] * s_inverse[k][j];
+      }
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      state[i] += gain[i][j] * innovation[j];
+    }
+  }
+  state[2] = normalize_angle(state[2]);
+
+  // Joseph form, P = (I - K) P (I - K)^T + K R K^T, which stays symmetric
+  double a[3][3], ap[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      a[i][j] = (i == j ? 1 : 0) - gain[i][j];
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      ap[i][j] = 0;
+      for (int k = 0; k < 3; k++) {
+        ap[i][j] += a[i][k] * covariance[k][j];
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      double value = 0;
+      for (int k = 0; k < 3; k++) {
+        value += ap[i][k] * a[j][k] + gain[i][k] * noise[k] * gain[j][k];
+      }
+      covariance[i][j] = value;
+    }
+  }
+  return true;
+}
+
+PoseEKF::Estimate PoseEKF::get_estimate() const {
+  Estimate estimate;
+  std::memcpy(estimate.state, state, sizeof(state));
+  std::memcpy(estimate.covariance, covariance, sizeof(covariance));
+  return estimate;
+}
+
+void PoseEKF::set_estimate(const Estimate &estimate) {
+  std::memcpy(state, estimate.state, sizeof(state));
+  std::memcpy(covariance, estimate.covariance, sizeof(covariance));
+}
+
+TwoDPose PoseEKF::get_pose() const {
+  return TwoDPose(state[0], state[1], state[2]);
+}
+
+double PoseEKF::get_position_std() const {
+  // The larger eigenvalue of the position block
+  double mean = (covariance[0][0] + covariance[1][1]) / 2;
+  double half_difference = (covariance[0][0] - covariance[1][1]) / 2;
+  return std::sqrt(mean + std::hypot(half_difference, covariance[0][1]));
+}
+
+double PoseEKF::get_yaw_std() const { return std::sqrt(covariance[2][2]); }
+
+double PoseEKF::get_last_distance() const { return last_distance; }
+
+} // namespace whoop
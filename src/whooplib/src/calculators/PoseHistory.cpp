@@ -0,0 +1,65 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       PoseHistory.cpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Timestamped History of Wheel Odometry Steps               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/PoseHistory.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <cmath>
+
+namespace whoop {
+
+TwoDPose OdomStep::apply(const TwoDPose &pose) const {
+  double rotation = pose.yaw - odom_yaw;
+  double c = std::cos(rotation);
+  double s = std::sin(rotation);
+  return TwoDPose(pose.x + c * dx - s * dy, pose.y + s * dx + c * dy,
+                  normalize_angle(pose.yaw + dyaw));
+}
+
+void PoseHistory::clear() {
+  oldest = 0;
+  count = 0;
+}
+
+void PoseHistory::push(const OdomStep &step) {
+  if (count < SIZE) {
+    steps[(oldest + count) % SIZE] = step;
+    count++;
+  } else {
+    steps[oldest] = step;
+    oldest = (oldest + 1) % SIZE;
+  }
+}
+
+int PoseHistory::size() const { return count; }
+
+OdomStep &PoseHistory::operator[](int i) { return steps[(oldest + i) % SIZE]; }
+
+const OdomStep &PoseHistory::operator[](int i) const {
+  return steps[(oldest + i) % SIZE];
+}
+
+int PoseHistory::find(double time) const {
+  // Frames are usually a few steps old, so search from the newest
+  for (int i = count - 1; i >= 0; i--) {
+    if ((*this)[i].time <= time) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+TwoDPose PoseHistory::replay(const TwoDPose &pose, int i) const {
+  TwoDPose result = pose;
+  for (int j = i + 1; j < count; j++) {
+    result = (*this)[j].apply(result);
+  }
+  return result;
+}
+
+} // namespace whoop
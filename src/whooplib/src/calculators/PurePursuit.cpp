@@ -9,6 +9,7 @@
 
 #include "whooplib/include/calculators/PurePursuit.hpp"
 #include "whooplib/include/calculators/Dubins.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
 #include "whooplib/include/toolbox.hpp"
 #include "whooplib/includer.hpp"
 #include <iostream>
@@ -55,32 +56,73 @@ void PurePursuitPath::initializeWaypoints(std::vector<TwoDPose> waypoints) {
 PurePursuitPath::PurePursuitPath(std::vector<TwoDPose> waypoints,
                                  double turning_radius,
                                  double lookahead_distance, double num_segments,
-                                 double landing_strip)
+                                 double landing_strip,
+                                 pathrepresentation path_representation,
+                                 pathplanner path_planner,
+                                 double smoothing_length)
     : turning_radius(turning_radius), lookahead_distance(lookahead_distance),
-      num_segments(num_segments), landing_strip(landing_strip) {
+      num_segments(num_segments), landing_strip(landing_strip),
+      path_representation(path_representation), path_planner(path_planner),
+      smoothing_length(smoothing_length) {
   initializeWaypoints(waypoints);
   computeDubinsPath();
+  smoothPath();
+  reset_progress();
 }
 
 PurePursuitPath::PurePursuitPath(const TwoDPose start, const TwoDPose end,
                                  double turning_radius,
                                  double lookahead_distance, double num_segments,
-                                 double landing_strip)
+                                 double landing_strip,
+                                 pathrepresentation path_representation,
+                                 pathplanner path_planner,
+                                 double smoothing_length)
     : turning_radius(turning_radius), lookahead_distance(lookahead_distance),
-      num_segments(num_segments), landing_strip(landing_strip) {
+      num_segments(num_segments), landing_strip(landing_strip),
+      path_representation(path_representation), path_planner(path_planner),
+      smoothing_length(smoothing_length) {
   initializeWaypoints({start, end});
   computeDubinsPath();
+  smoothPath();
+  reset_progress();
 }
 
 static int create_points_bridge(double q[3], double t, void *user_data) {
   return static_cast<PurePursuitPath *>(user_data)->create_points(q, t);
 }
 
+void PurePursuitPath::extend_leg(uint32_t i, double s, int direction) {
+  if (pursuit_legs.empty() || pursuit_legs.back().direction != direction) {
+    // A new leg starts at the cusp where the previous leg ends
+    pursuitLeg leg(0, i, 0, s, direction);
+    if (!pursuit_legs.empty()) {
+      leg.start_i = pursuit_legs.back().end_i;
+      leg.start_s = pursuit_legs.back().end_s;
+    }
+    pursuit_legs.push_back(leg);
+  } else {
+    pursuit_legs.back().end_i = i;
+    pursuit_legs.back().end_s = s;
+  }
+}
+
 // Pretty much generates the path to drive through
 void PurePursuitPath::computeDubinsPath() {
   // Wipe pursuit points
   pursuit_points = {};
   pursuit_checkpoints = {};
+  pursuit_legs = {};
+  current_leg = 0;
+  analytic_path.clear();
+
+  // Smoothing works on the primitives, so they are kept in either case
+  bool analytic = path_representation == pathrepresentation::path_analytic ||
+                  smoothing_length > 0;
+  bool reeds_shepp = path_planner == pathplanner::planner_reeds_shepp;
+
+  // The landing strip drives into the end, from behind it by default
+  TwoDPose strip_start = end_translated_back;
+  int strip_direction = 1;
 
   path_valid = true;
 
@@ -98,21 +140,79 @@ void PurePursuitPath::computeDubinsPath() {
     q1[2] = waypoints[i + 1].yaw;
 
     // Create shortest path and remember the status of the result
-    int creation_result = dubins_shortest_path(&path, q0, q1, turning_radius);
+    int creation_result;
+    double segment_length = 0;
+    size_t first_point = 0; // First pursuit point of the sub-section
+    if (reeds_shepp) {
+      creation_result =
+          reeds_shepp_shortest_path(&rs_path, q0, q1, turning_radius);
+
+      // Reeds-Shepp may be shorter backing into the end, in which case the
+      // landing strip starts in front of the end instead
+      if (creation_result == EDUBOK && i == waypoints.size() - 2 &&
+          push_back_distance > 0) {
+        TwoDPose end_translated_forward =
+            end * TwoDPose(0, push_back_distance, 0);
+        double q_forward[3] = {end_translated_forward.x,
+                               end_translated_forward.y,
+                               end_translated_forward.yaw};
+        ReedsSheppPath reverse_path;
+        if (reeds_shepp_shortest_path(&reverse_path, q0, q_forward,
+                                      turning_radius) == EDUBOK &&
+            reeds_shepp_path_length(&reverse_path) <
+                reeds_shepp_path_length(&rs_path)) {
+          rs_path = reverse_path;
+          strip_start = end_translated_forward;
+          strip_direction = -1;
+        }
+      }
+
+      if (creation_result == EDUBOK) {
+        segment_length = reeds_shepp_path_length(&rs_path);
+      }
+    } else {
+      creation_result = dubins_shortest_path(&path, q0, q1, turning_radius);
+      if (creation_result == EDUBOK) {
+        segment_length = dubins_path_length(&path);
+      }
+    }
 
     if (creation_result == EDUBOK) { // If no error
+      sample_offset = t_max;
       if (i == 0) { // If first path (NOTE the first path determines step_size)
-        t_max = dubins_path_length(&path);
+        sample_offset = 0;
+        t_max = segment_length;
         step_size = t_max / num_segments;
       } else { // Add on to path size
-        t_max += dubins_path_length(&path);
+        t_max += segment_length;
       }
 
-      // Generate the sample
-      if (dubins_path_sample_many(&path, step_size, create_points_bridge,
-                                  this) != EDUBOK) {
-        path_valid = false;
-        return;
+      if (analytic) { // Keep the primitives, no sampling required
+        size_t first = analytic_path.primitives.size();
+        if (reeds_shepp) {
+          analytic_path.append_reeds_shepp(&rs_path);
+        } else {
+          analytic_path.append_dubins(&path);
+        }
+        for (size_t j = first; j < analytic_path.primitives.size(); j++) {
+          const PathPrimitive &primitive = analytic_path.primitives[j];
+          extend_leg(0, primitive.s_start + primitive.length,
+                     primitive.direction);
+        }
+      } else {
+        first_point = pursuit_points.size();
+        int sample_result;
+        if (reeds_shepp) {
+          sample_result = reeds_shepp_path_sample_many(
+              &rs_path, step_size, create_points_bridge, this);
+        } else {
+          sample_result = dubins_path_sample_many(
+              &path, step_size, create_points_bridge, this);
+        }
+        if (sample_result != EDUBOK) { // Generate sample
+          path_valid = false;
+          return;
+        }
       }
     } else {
       std::cout << "Creation result error: " << creation_result << std::endl;
@@ -120,22 +220,45 @@ void PurePursuitPath::computeDubinsPath() {
       return;
     }
 
-    // Create a checkpoint at the halfway mark and append the checkpoint
-    pursuitCheckpoint halfway_checkpoint(pursuit_points.size() - 1 -
-                                         floatToInt(num_segments / 2));
+    if (analytic) {
+      // Create a checkpoint at the halfway mark and at the end of the
+      // sub-section, by arc length
+      double end_s = analytic_path.length();
+      pursuit_checkpoints.push_back(
+          pursuitCheckpoint(0, false, end_s - segment_length / 2));
+      pursuit_checkpoints.push_back(pursuitCheckpoint(0, false, end_s));
+      continue;
+    }
+
+    // Create a checkpoint at the halfway mark of the sub-section's points, so
+    // the checkpoints stay in order however long the sub-section is
+    size_t last_point = pursuit_points.size() - 1;
+    pursuitCheckpoint halfway_checkpoint((first_point + last_point) / 2, false,
+                                         t_max - segment_length / 2);
     pursuit_checkpoints.push_back(halfway_checkpoint);
 
     // Create a checkpoint at the end and append the checkpoint
-    pursuitCheckpoint checkpoint(pursuit_points.size() - 1);
+    pursuitCheckpoint checkpoint(last_point, false, t_max);
     pursuit_checkpoints.push_back(checkpoint);
   }
 
   if (push_back_distance > 0) { // If the length of the landing strip
     // Create extrapolated forward steps that respect the pushed-back distance
-    double dx = end.x - end_translated_back.x;
-    double dy = end.y - end_translated_back.y;
+    double dx = end.x - strip_start.x;
+    double dy = end.y - strip_start.y;
     double distance = sqrt(dx * dx + dy * dy);
     t_max += distance;
+
+    if (analytic) { // The landing strip is a single line primitive
+      analytic_path.append_line(strip_start.x, strip_start.y, end.x, end.y,
+                                strip_direction);
+      extend_leg(0, analytic_path.length(), strip_direction);
+      pursuit_checkpoints.push_back(
+          pursuitCheckpoint(0, false, analytic_path.length()));
+      pursuit_checkpoints[pursuit_checkpoints.size() - 1].is_last = true;
+      return;
+    }
+
     int n = static_cast<int>(distance /
                              step_size); // Calculate the number of full steps
     double fraction_step = step_size / distance;
@@ -143,48 +266,384 @@ void PurePursuitPath::computeDubinsPath() {
     for (int i = 1; i < n; ++i) {
       double fraction = i * fraction_step;
       barebonesPose intermediate;
-      intermediate.x = end_translated_back.x + fraction * dx;
-      intermediate.y = end_translated_back.y + fraction * dy;
+      intermediate.x = strip_start.x + fraction * dx;
+      intermediate.y = strip_start.y + fraction * dy;
+      intermediate.yaw = end.yaw; // The strip is straight into the end
       pursuit_points.push_back(intermediate);
     }
+    extend_leg(static_cast<uint32_t>(pursuit_points.size() - 1), t_max,
+               strip_direction);
 
     // Create a checkpoint at the end and append the checkpoint
-    pursuitCheckpoint checkpoint(pursuit_points.size() - 1);
+    pursuitCheckpoint checkpoint(pursuit_points.size() - 1, false, t_max);
     pursuit_checkpoints.push_back(checkpoint);
   }
   pursuit_checkpoints[pursuit_checkpoints.size() - 1].is_last = true;
 }
 
+void PurePursuitPath::smoothPath() {
+  if (!path_valid || smoothing_length <= 0) {
+    return;
+  }
+
+  // The arc length is kept, so checkpoints and legs stay where they were
+  analytic_path.smooth(smoothing_length);
+
+  if (path_representation == pathrepresentation::path_analytic) {
+    return;
+  }
+
+  // Resample the smoothed primitives into pursuit points
+  pursuit_points = {};
+  double q[3];
+  size_t last = static_cast<size_t>(t_max / step_size);
+  for (size_t i = 0; i <= last; i++) {
+    analytic_path.sample(i * step_size, q);
+    pursuit_points.push_back(barebonesPose(q[0], q[1], q[2]));
+  }
+  analytic_path.clear();
+
+  double last_i = static_cast<double>(last);
+  for (size_t i = 0; i < pursuit_checkpoints.size(); i++) {
+    pursuit_checkpoints[i].i = static_cast<uint32_t>(
+        std::min(std::round(pursuit_checkpoints[i].s / step_size), last_i));
+  }
+  for (size_t i = 0; i < pursuit_legs.size(); i++) {
+    pursuit_legs[i].start_i = static_cast<uint32_t>(
+        std::min(std::round(pursuit_legs[i].start_s / step_size), last_i));
+    pursuit_legs[i].end_i = static_cast<uint32_t>(
+        std::min(std::round(pursuit_legs[i].end_s / step_size), last_i));
+  }
+  if (!pursuit_legs.empty()) {
+    pursuit_legs.back().end_i = static_cast<uint32_t>(last);
+  }
+}
+
 int PurePursuitPath::create_points(double q[3], double x) {
   barebonesPose p(q[0], q[1], q[2]);
   pursuit_points.push_back(p);
+
+  int direction = 1;
+  if (path_planner == pathplanner::planner_reeds_shepp) {
+    direction = reeds_shepp_direction_at(&rs_path, x);
+  }
+  extend_leg(static_cast<uint32_t>(pursuit_points.size() - 1),
+             sample_offset + x, direction);
   return 0;
 }
 
+void PurePursuitPath::load_primitives(const PathPrimitive *primitives,
+                                      size_t num_primitives,
+                                      const double *checkpoints,
+                                      size_t num_checkpoints) {
+  pursuit_points = {};
+  pursuit_checkpoints = {};
+  pursuit_legs = {};
+  current_leg = 0;
+  velocity_profile.clear();
+  path_representation = pathrepresentation::path_analytic;
+  smoothing_length = 0;
+
+  analytic_path.primitives.assign(primitives, primitives + num_primitives);
+  for (size_t i = 0; i < num_primitives; i++) {
+    extend_leg(0, primitives[i].s_start + primitives[i].length,
+               primitives[i].direction);
+  }
+  for (size_t i = 0; i < num_checkpoints; i++) {
+    pursuit_checkpoints.push_back(
+        pursuitCheckpoint(0, false, checkpoints[i]));
+  }
+
+  path_valid = num_primitives > 0 && num_checkpoints > 0;
+  if (!path_valid) {
+    return;
+  }
+  pursuit_checkpoints[pursuit_checkpoints.size() - 1].is_last = true;
+
+  t_max = analytic_path.length();
+  step_size = t_max / num_segments;
+
+  double q[3];
+  analytic_path.sample(0, q);
+  start = TwoDPose(q[0], q[1], q[2]);
+  analytic_path.sample(t_max, q);
+  end = TwoDPose(q[0], q[1], q[2]);
+  end_translated_back = end;
+  reset_progress();
+}
+
+double PurePursuitPath::sampled_curvature(size_t i) const {
+  if (i == 0 || i + 1 >= pursuit_points.size()) {
+    return 0;
+  }
+  const barebonesPose &p0 = pursuit_points[i - 1];
+  const barebonesPose &p1 = pursuit_points[i];
+  const barebonesPose &p2 = pursuit_points[i + 1];
+  double a = std::hypot(p1.x - p0.x, p1.y - p0.y);
+  double b = std::hypot(p2.x - p1.x, p2.y - p1.y);
+  double c = std::hypot(p2.x - p0.x, p2.y - p0.y);
+  double cross = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+  if (a * b * c > 0) {
+    return 2 * cross / (a * b * c);
+  }
+  return 0;
+}
+
+void PurePursuitPath::profile_stations(std::vector<double> *stations,
+                                       std::vector<double> *curvatures,
+                                       std::vector<double> *stops) const {
+  if (path_representation == pathrepresentation::path_analytic) {
+    // Curvature is exact per primitive, so sample it every step_size
+    for (double s = 0; s < t_max; s += step_size) {
+      stations->push_back(s);
+      curvatures->push_back(analytic_path.curvature_at(s));
+    }
+    stations->push_back(t_max);
+    curvatures->push_back(analytic_path.curvature_at(t_max));
+  } else {
+    // Estimate curvature from the circle through each three consecutive
+    // points (k = 4 * area / (a * b * c)). Stations follow the same
+    // "index * step_size" convention as calculate_pursuit_estimate.
+    size_t size = pursuit_points.size();
+    for (size_t i = 0; i < size; i++) {
+      stations->push_back(i * step_size);
+      curvatures->push_back(sampled_curvature(i));
+    }
+
+    // The circle means nothing where the path doubles back on itself
+    for (size_t i = 0; i + 1 < pursuit_legs.size(); i++) {
+      size_t cusp = static_cast<size_t>(pursuit_legs[i].end_i);
+      for (size_t j = cusp > 0 ? cusp - 1 : 0; j <= cusp + 1 && j < size;
+           j++) {
+        (*curvatures)[j] = 0;
+      }
+    }
+  }
+
+  // Stop at each cusp, where the robot changes direction
+  for (size_t i = 0; i + 1 < pursuit_legs.size(); i++) {
+    if (path_representation == pathrepresentation::path_analytic) {
+      stops->push_back(pursuit_legs[i].end_s);
+    } else {
+      stops->push_back(pursuit_legs[i].end_i * step_size);
+    }
+  }
+}
+
+void PurePursuitPath::generate_velocity_profile(double max_velocity,
+                                                double max_acceleration,
+                                                double max_deceleration,
+                                                double max_lateral_acceleration,
+                                                double start_velocity) {
+  velocity_profile.clear();
+  if (!path_valid || step_size <= 0) {
+    return;
+  }
+
+  std::vector<double> stations;
+  std::vector<double> curvatures;
+  std::vector<double> stops;
+  profile_stations(&stations, &curvatures, &stops);
+
+  velocity_profile.generate(stations, curvatures, max_velocity,
+                            max_acceleration, max_deceleration,
+                            max_lateral_acceleration, start_velocity, 0, stops);
+}
+
+void PurePursuitPath::generate_trajectory(
+    Trajectory &trajectory, double max_velocity, double max_acceleration,
+    double max_deceleration, double max_lateral_acceleration,
+    double track_width, double free_velocity) const {
+  trajectory.clear();
+  if (!path_valid || step_size <= 0) {
+    return;
+  }
+
+  std::vector<double> stations;
+  std::vector<double> curvatures;
+  std::vector<double> stops;
+  profile_stations(&stations, &curvatures, &stops);
+
+  // Sampled paths may stop short of the end, which the trajectory needs to
+  // reach
+  bool analytic = path_representation == pathrepresentation::path_analytic;
+  size_t num_points = stations.size();
+  if (!analytic && !stations.empty() && stations.back() < t_max) {
+    stations.push_back(t_max);
+    curvatures.push_back(0);
+  }
+
+  VelocityProfile profile;
+  profile.generate(stations, curvatures, max_velocity, max_acceleration,
+                   max_deceleration, max_lateral_acceleration, 0, 0, stops,
+                   track_width);
+  profile.limit_motor_acceleration(max_acceleration, free_velocity);
+
+  std::vector<TwoDPose> poses;
+  std::vector<double> velocities;
+  size_t leg = 0;
+  for (size_t i = 0; i < stations.size(); i++) {
+    // The leg of the station, which sets the sign of its velocity. The
+    // profile is 0 at the cusps between legs
+    while (leg + 1 < pursuit_legs.size() &&
+           stations[i] > (analytic ? pursuit_legs[leg].end_s
+                                   : pursuit_legs[leg].end_i * step_size)) {
+      leg++;
+    }
+    int direction = pursuit_legs.empty() ? 1 : pursuit_legs[leg].direction;
+
+    if (analytic) {
+      double q[3];
+      analytic_path.sample(stations[i], q);
+      poses.push_back(TwoDPose(q[0], q[1], q[2]));
+    } else if (i < num_points) {
+      const barebonesPose &point = pursuit_points[i];
+      poses.push_back(TwoDPose(point.x, point.y, point.yaw));
+    } else {
+      poses.push_back(end);
+    }
+    velocities.push_back(direction * profile.velocities[i]);
+  }
+
+  trajectory.generate(poses, stations, velocities, max_acceleration);
+}
+
+double PurePursuitPath::profile_velocity(double distance) {
+  if (velocity_profile.empty()) {
+    return 0;
+  }
+
+  // Distance is measured to the end of the current leg
+  double leg_end = velocity_profile.length();
+  if (!pursuit_legs.empty()) {
+    if (path_representation == pathrepresentation::path_analytic) {
+      leg_end = pursuit_legs[current_leg].end_s;
+    } else {
+      leg_end = pursuit_legs[current_leg].end_i * step_size;
+    }
+  }
+
+  // Distance is negative when past the end, so mirror it about the end
+  return velocity_profile.velocity_at(leg_end - std::abs(distance));
+}
+
+double PurePursuitPath::path_curvature(double distance) {
+  if (!path_valid || step_size <= 0) {
+    return 0;
+  }
+  bool analytic = path_representation == pathrepresentation::path_analytic;
+
+  // Distance is measured to the end of the current leg, as in
+  // profile_velocity
+  double leg_end =
+      analytic ? t_max : (pursuit_points.size() - 1) * step_size;
+  if (!pursuit_legs.empty()) {
+    leg_end = analytic ? pursuit_legs[current_leg].end_s
+                       : pursuit_legs[current_leg].end_i * step_size;
+  }
+  double s = clamp(leg_end - std::abs(distance), 0.0, leg_end);
+
+  if (analytic) {
+    return analytic_path.curvature_at(s);
+  }
+  return sampled_curvature(static_cast<size_t>(s / step_size + 0.5));
+}
+
+TwoDPose PurePursuitPath::end_pose() const { return end; }
+
+size_t PurePursuitPath::checkpoints_passed() const { return next_checkpoint; }
+
+void PurePursuitPath::reset_progress() {
+  checkpoint_arrival_times.assign(pursuit_checkpoints.size(), -1);
+  next_checkpoint = 0;
+  current_leg = 0;
+  progress_start_time = -1;
+}
+
+void PurePursuitPath::pass_checkpoints(double closest_s, size_t closest_i) {
+  // A checkpoint is passed once the closest point of the path is within the
+  // look ahead distance of it, or beyond it
+  bool analytic = path_representation == pathrepresentation::path_analytic;
+  while (next_checkpoint < pursuit_checkpoints.size()) {
+    const pursuitCheckpoint &checkpoint = pursuit_checkpoints[next_checkpoint];
+    double ahead = analytic ? checkpoint.s - closest_s
+                            : (static_cast<double>(checkpoint.i) -
+                               static_cast<double>(closest_i)) *
+                                  step_size;
+    if (ahead >= lookahead_distance) {
+      break;
+    }
+    checkpoint_arrival_times[next_checkpoint] = now_seconds() -
+                                                 progress_start_time;
+    next_checkpoint++;
+  }
+}
+
+bool PurePursuitPath::on_final_leg() {
+  return current_leg + 1 >= pursuit_legs.size();
+}
+
 PursuitEstimate
 PurePursuitPath::calculate_pursuit_estimate(TwoDPose current_position,
                                             bool find_closest_if_off_course,
                                             double deviation_min) {
-  if (!path_valid) {
+  if (!path_valid || pursuit_checkpoints.empty()) {
     return PursuitEstimate();
   }
 
-  // Figure out the travel locations between checkpoints
+  if (progress_start_time < 0) {
+    progress_start_time = now_seconds();
+  }
+
+  bool analytic = path_representation == pathrepresentation::path_analytic;
+
+  // Move on to the next leg once the robot reaches the cusp that ends the
+  // current one
+  double cusp_tolerance = std::max(lookahead_distance / 2, deviation_min * 2);
+  while (current_leg + 1 < pursuit_legs.size()) {
+    double cusp[3] = {0, 0, 0};
+    if (analytic) {
+      analytic_path.sample(pursuit_legs[current_leg].end_s, cusp);
+    } else {
+      const barebonesPose &point =
+          pursuit_points[static_cast<size_t>(pursuit_legs[current_leg].end_i)];
+      cusp[0] = point.x;
+      cusp[1] = point.y;
+    }
+    if (std::hypot(cusp[0] - current_position.x,
+                   cusp[1] - current_position.y) > cusp_tolerance) {
+      break;
+    }
+    current_leg++;
+  }
+
+  pursuitLeg leg(0, static_cast<uint32_t>(pursuit_points.size() - 1), 0, t_max,
+                 1);
+  if (!pursuit_legs.empty()) {
+    leg = pursuit_legs[current_leg];
+  }
+
+  // The heading of the robot that drives the path, which is the back of the
+  // robot when in reverse
+  double travel_yaw = current_position.yaw;
+  double end_travel_yaw = end.yaw;
+  if (leg.direction < 0) {
+    travel_yaw = control_normalize_angle(travel_yaw + M_PI);
+    end_travel_yaw = control_normalize_angle(end_travel_yaw + M_PI);
+  }
+
+  // Figure out the travel locations between the last checkpoint passed and
+  // the next one (the last checkpoint once all are passed)
   size_t start_i = 0;
   size_t end_i = 0;
-  for (size_t i = 0; i < pursuit_checkpoints.size(); i++) {
-    if (i == 0) { // If first index
-      if (!pursuit_checkpoints[i].visited) {
-        end_i = pursuit_checkpoints[i].i;
-        break;
-      }
-    } else { // If not, get the indexes in between what is allowed
-      if (!pursuit_checkpoints[i].visited || pursuit_checkpoints[i].is_last) {
-        start_i = pursuit_checkpoints[i - 1].i;
-        end_i = pursuit_checkpoints[i].i;
-        break;
-      }
-    }
+  double start_s = 0;
+  double end_s = 0;
+  size_t next = std::min(next_checkpoint, pursuit_checkpoints.size() - 1);
+  end_i = pursuit_checkpoints[next].i;
+  end_s = pursuit_checkpoints[next].s;
+  if (next > 0) {
+    start_i = pursuit_checkpoints[next - 1].i;
+    start_s = pursuit_checkpoints[next - 1].s;
   }
 
   barebonesPose look_ahead_position;
@@ -207,54 +666,102 @@ PurePursuitPath::calculate_pursuit_estimate(TwoDPose current_position,
   double rough_distance;
   double distance;
 
-  // Reverse iteration from last_element (which is size - 1) to index 1
-  // We omit the first index 0 intentionally as that is the start location
-  for (std::size_t i = last_element; i > 0; i--) {
-    // Ensure it's within a valid checkpoint bounds
-    if (i * step_size < start_i * step_size - lookahead_distance ||
-        i * step_size > end_i * step_size + lookahead_distance) {
-      continue;
+  if (analytic) {
+    // Solve the look-ahead intersection and closest point per primitive,
+    // without looking past either cusp of the current leg
+    double s_min = std::max(start_s - lookahead_distance, leg.start_s);
+    double s_max = std::min(end_s + lookahead_distance, leg.end_s);
+    if (s_min > s_max) {
+      s_min = leg.start_s;
+      s_max = leg.end_s;
     }
 
-    // Rough distance first to avoid un-needed computational cost
-    rough_distance =
-        std::max(std::abs(pursuit_points[i].x - current_position.x),
-                 std::abs(pursuit_points[i].y - current_position.y));
-    if (rough_distance > closest_distance) {
-      continue;
-    }
-
-    distance = sqrt(pow(pursuit_points[i].x - current_position.x, 2) +
-                    pow(pursuit_points[i].y - current_position.y, 2));
-    if (distance <= point_ahead_distance) {
-      if (!lookahead_found) {
-        point_ahead_distance = distance;
-        look_ahead_position = pursuit_points[i];
-        length_lookahead = (last_element - i) * step_size;
-        lookahead_found = true;
-      }
-      if (!find_closest_if_off_course) {
-        break;
-      }
+    PathQuery lookahead =
+        analytic_path.lookahead_point(current_position.x, current_position.y,
+                                      lookahead_distance, s_min, s_max);
+    if (lookahead.found) {
+      point_ahead_distance = lookahead.distance;
+      look_ahead_position = barebonesPose(lookahead.x, lookahead.y);
+      length_lookahead = leg.end_s - lookahead.s;
+      lookahead_found = true;
     }
 
+    double closest_s = 0;
     if (find_closest_if_off_course) {
-      if (distance <= closest_distance) {
-        closest_distance = distance;
-        closest_position = pursuit_points[i];
-        length_closest = (last_element - i) * step_size;
-        closest_i = i;
+      PathQuery closest = analytic_path.closest_point(
+          current_position.x, current_position.y, s_min, s_max);
+      if (closest.found) {
+        closest_distance = closest.distance;
+        closest_position = barebonesPose(closest.x, closest.y);
+        length_closest = leg.end_s - closest.s;
+        closest_s = closest.s;
         closest_found = true;
       }
     }
-  }
 
-  // Mark checkpoint as visited if reached
-  for (size_t j = 0; j < pursuit_checkpoints.size(); j++) {
-    if (int_distance(pursuit_checkpoints[j].i, closest_i) * step_size <
-        lookahead_distance) {
-      pursuit_checkpoints[j].visited = true;
+    pass_checkpoints(closest_s, 0);
+  } else {
+    // Checkpoint bounds, without looking past either cusp of the current leg
+    double window_min = std::max(start_i * step_size - lookahead_distance,
+                                 leg.start_i * step_size);
+    double window_max = std::min(end_i * step_size + lookahead_distance,
+                                 leg.end_i * step_size);
+    if (window_min > window_max) {
+      window_min = leg.start_i * step_size;
+      window_max = leg.end_i * step_size;
+    }
+
+    // Reverse iteration from the end of the window to index 1, so that the
+    // cost does not grow with the length of the path. We omit the first index
+    // 0 intentionally as that is the start location
+    std::size_t first_i = 1;
+    std::size_t last_i = last_element;
+    if (step_size > 0) {
+      first_i = std::max(first_i,
+                         static_cast<std::size_t>(window_min / step_size));
+      last_i = std::min(last_i,
+                        static_cast<std::size_t>(window_max / step_size) + 1);
     }
+    for (std::size_t i = last_i; i >= first_i && i > 0; i--) {
+      // Ensure it's within a valid checkpoint bounds
+      if (i * step_size < window_min || i * step_size > window_max) {
+        continue;
+      }
+
+      // Rough distance first to avoid un-needed computational cost
+      rough_distance =
+          std::max(std::abs(pursuit_points[i].x - current_position.x),
+                   std::abs(pursuit_points[i].y - current_position.y));
+      if (rough_distance > closest_distance) {
+        continue;
+      }
+
+      distance = sqrt(pow(pursuit_points[i].x - current_position.x, 2) +
+                      pow(pursuit_points[i].y - current_position.y, 2));
+      if (distance <= point_ahead_distance) {
+        if (!lookahead_found) {
+          point_ahead_distance = distance;
+          look_ahead_position = pursuit_points[i];
+          length_lookahead = (static_cast<double>(leg.end_i) - i) * step_size;
+          lookahead_found = true;
+        }
+        if (!find_closest_if_off_course) {
+          break;
+        }
+      }
+
+      if (find_closest_if_off_course) {
+        if (distance <= closest_distance) {
+          closest_distance = distance;
+          closest_position = pursuit_points[i];
+          length_closest = (static_cast<double>(leg.end_i) - i) * step_size;
+          closest_i = i;
+          closest_found = true;
+        }
+      }
+    }
+
+    pass_checkpoints(0, closest_i);
   }
 
   if (!lookahead_found) {
@@ -269,14 +776,14 @@ PurePursuitPath::calculate_pursuit_estimate(TwoDPose current_position,
 
   double dx = look_ahead_position.x - current_position.x;
   double dy = look_ahead_position.y - current_position.y;
-  double path_angle = atan2(dy, dx);
-  double steering_angle = normalize_angle(path_angle - current_position.yaw);
+  double path_angle = control_atan2(dy, dx);
+  double steering_angle = control_normalize_angle(path_angle - travel_yaw);
 
   lookahead_pos = look_ahead_position;
 
   bool is_past_point = false;
 
-  if (length_lookahead <= step_size) {
+  if (length_lookahead <= step_size && on_final_leg()) {
     // If robot is within a respective distance, then just turn
     /*double dist_from_end = std::sqrt(std::pow(q1[0] - current_position.x, 2)+
     std::pow(q1[1] - current_position.y, 2)); if(dist_from_end < deviation_min){
@@ -286,15 +793,17 @@ PurePursuitPath::calculate_pursuit_estimate(TwoDPose current_position,
     // If the angle of the robot at the end point, facing the same direction
     // roughly as the end point, and over-passes (designated by steering angle)
     // Go in reverse
-    if (std::abs(normalize_angle(end.yaw - current_position.yaw)) < M_PI_2 &&
+    if (std::abs(control_normalize_angle(end_travel_yaw - travel_yaw)) <
+            M_PI_2 &&
         std::abs(steering_angle) > M_PI_2) {
       is_past_point = true;
       point_ahead_distance *= -1;
-      steering_angle = normalize_angle(steering_angle + M_PI);
+      steering_angle = control_normalize_angle(steering_angle + M_PI);
     }
   }
 
-  double end_steering = normalize_angle(end.yaw - current_position.yaw);
+  double end_steering =
+      control_normalize_angle(end.yaw - current_position.yaw);
 
   bool suggest_point_turn = false; // Suggesting point turn if the robot is
                                    // facing the opposite direction
@@ -307,7 +816,7 @@ PurePursuitPath::calculate_pursuit_estimate(TwoDPose current_position,
   // track length to finish line)
   return PursuitEstimate(true, steering_angle,
                          point_ahead_distance + length_lookahead, is_past_point,
-                         end_steering, suggest_point_turn);
+                         end_steering, suggest_point_turn, leg.direction);
 }
 
 } // namespace whoop
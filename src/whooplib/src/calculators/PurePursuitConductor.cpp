@@ -8,7 +8,10 @@
 /*----------------------------------------------------------------------------*/
 
 #include "whooplib/include/calculators/PurePursuitConductor.hpp"
+#include "whooplib/include/calculators/PathFile.hpp"
 #include "whooplib/includer.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace whoop {
@@ -37,14 +40,46 @@ PurePursuitConductor::PurePursuitConductor(
                   default_pursuit_parameters->settle_distance,
                   default_pursuit_parameters->settle_time,
                   default_pursuit_parameters->timeout),
+      tracking_pid(0, default_pursuit_parameters->forward_kp,
+                   default_pursuit_parameters->forward_ki,
+                   default_pursuit_parameters->forward_kd,
+                   default_pursuit_parameters->forward_kr,
+                   default_pursuit_parameters->forward_i_activation,
+                   default_pursuit_parameters->forward_max_voltage),
+      left_feedforward(default_pursuit_parameters->left_ks,
+                       default_pursuit_parameters->left_kv,
+                       default_pursuit_parameters->left_ka),
+      right_feedforward(default_pursuit_parameters->right_ks,
+                        default_pursuit_parameters->right_kv,
+                        default_pursuit_parameters->right_ka),
+      pure_pursuit(this), ramsete(this), mpc(this),
       turn_slew(default_pursuit_parameters->max_turn_voltage_change, 10),
       forward_slew(default_pursuit_parameters->max_forward_voltage_change, 10),
       pursuit_path(TwoDPose(), TwoDPose(),
                    default_pursuit_parameters->turning_radius,
                    default_pursuit_parameters->lookahead_distance,
-                   default_pursuit_parameters->num_path_segments),
+                   default_pursuit_parameters->num_path_segments, -1,
+                   default_pursuit_parameters->path_representation,
+                   default_pursuit_parameters->path_planner,
+                   default_pursuit_parameters->smoothing_length),
       default_pursuit_parameters(default_pursuit_parameters) {}
 
+PurePursuitConductor::PurePursuitConductor(const PurePursuitConductor &other)
+    : PurePursuitConductor(other.default_pursuit_parameters) {
+  *this = other;
+}
+
+PathFollower *PurePursuitConductor::follower() {
+  switch (path_follower) {
+  case pathfollower::follower_ramsete:
+    return &ramsete;
+  case pathfollower::follower_mpc:
+    return &mpc;
+  default:
+    return &pure_pursuit;
+  }
+}
+
 void PurePursuitConductor::generate_path(TwoDPose start_position,
                                          TwoDPose destination_position) {
   generate_path(start_position, destination_position, -1, -1);
@@ -77,6 +112,29 @@ void PurePursuitConductor::generate_path(
 void PurePursuitConductor::generate_path(
     std::vector<std::vector<double>> waypoints, double timeout,
     double turning_radius, double landing_strip) {
+  // Pick the headings of {x, y} waypoints that make the shortest path
+  if (default_pursuit_parameters->heading_bins > 0 && waypoints.size() >= 2) {
+    double turn_rad = turning_radius >= 0
+                          ? turning_radius
+                          : default_pursuit_parameters->turning_radius;
+    double strip = landing_strip >= 0
+                       ? landing_strip
+                       : default_pursuit_parameters->lookahead_distance;
+    heading_optimization = optimize_headings(
+        waypoints, turn_rad, strip, default_pursuit_parameters->heading_bins,
+        default_pursuit_parameters->heading_time_budget);
+    if (heading_optimization.timed_out) {
+      std::cout << "Heading optimization timed out" << std::endl;
+    } else if (heading_optimization.optimized) {
+      std::cout << "Heading optimization shortened the path by "
+                << heading_optimization.length_reduction() * 100 << "%"
+                << std::endl;
+    }
+    generate_path(heading_optimization.waypoints, timeout, turning_radius,
+                  landing_strip);
+    return;
+  }
+
   // Ensure that waypoints are 2 or greater
   size_t waypoints_size = waypoints.size();
 
@@ -144,6 +202,32 @@ void PurePursuitConductor::generate_path(std::vector<TwoDPose> waypoints,
     turn_rad = default_pursuit_parameters->turning_radius;
   }
 
+  reset_controllers(timeout);
+
+  this->end_position =
+      waypoints[waypoints.size() - 1]; // Last element of the waypoints list (as
+                                       // starting index is 0 instead of 1)
+  pursuit_path = PurePursuitPath(
+      waypoints, turn_rad, default_pursuit_parameters->lookahead_distance,
+      default_pursuit_parameters->num_path_segments, landing_strip,
+      default_pursuit_parameters->path_representation,
+      default_pursuit_parameters->path_planner,
+      default_pursuit_parameters->smoothing_length);
+
+  // The profile starts at full speed since the acceleration from rest is
+  // limited in step, where the time between steps is known
+  if (default_pursuit_parameters->max_velocity > 0) {
+    pursuit_path.generate_velocity_profile(
+        default_pursuit_parameters->max_velocity,
+        default_pursuit_parameters->max_acceleration,
+        default_pursuit_parameters->max_deceleration,
+        default_pursuit_parameters->max_lateral_acceleration,
+        default_pursuit_parameters->max_velocity);
+  }
+  enabled = true;
+}
+
+void PurePursuitConductor::reset_controllers(double timeout) {
   double t_out;
   if (timeout >= 0) {
     t_out = timeout;
@@ -170,87 +254,158 @@ void PurePursuitConductor::generate_path(std::vector<TwoDPose> waypoints,
                      ->forward_max_voltage, // For clamping total_error. Doesn't
                                             // actually clamp output.
                  default_pursuit_parameters->settle_rotation,
-                 default_pursuit_parameters->settle_time, t_out),
-  this->end_position =
-      waypoints[waypoints.size() - 1]; // Last element of the waypoints list (as
-                                       // starting index is 0 instead of 1)
-  pursuit_path = PurePursuitPath(
-      waypoints, turn_rad, default_pursuit_parameters->lookahead_distance,
-      default_pursuit_parameters->num_path_segments, landing_strip);
+                 default_pursuit_parameters->settle_time, t_out);
+  tracking_pid = PID(0, default_pursuit_parameters->forward_kp,
+                     default_pursuit_parameters->forward_ki,
+                     default_pursuit_parameters->forward_kd,
+                     default_pursuit_parameters->forward_kr,
+                     default_pursuit_parameters->forward_i_activation,
+                     default_pursuit_parameters->forward_max_voltage);
+  left_feedforward = MotorFeedforward(default_pursuit_parameters->left_ks,
+                                      default_pursuit_parameters->left_kv,
+                                      default_pursuit_parameters->left_ka);
+  right_feedforward = MotorFeedforward(default_pursuit_parameters->right_ks,
+                                       default_pursuit_parameters->right_kv,
+                                       default_pursuit_parameters->right_ka);
+
+  pure_pursuit.reset();
+  ramsete.reset();
+  mpc.reset();
+  path_follower = default_pursuit_parameters->path_follower;
+
+  // The motors were stopped, unless hand_off says otherwise
+  turn_slew =
+      SlewRateLimiter(default_pursuit_parameters->max_turn_voltage_change, 10);
+  forward_slew = SlewRateLimiter(
+      default_pursuit_parameters->max_forward_voltage_change, 10);
+  chained = false;
+  handoff_pending = false;
+}
+
+bool PurePursuitConductor::load_path(const std::vector<uint8_t> &data,
+                                     double timeout) {
+  if (!deserialize_path(data.data(), data.size(), pursuit_path)) {
+    std::cout << "Invalid path file" << std::endl;
+    return false;
+  }
+
+  // The saved profile is scaled by the current max velocity
+  if (default_pursuit_parameters->max_velocity <= 0) {
+    pursuit_path.velocity_profile.clear();
+  }
+  start_loaded_path(timeout);
+  return true;
+}
+
+void PurePursuitConductor::start_loaded_path(double timeout) {
+  is_turn = false;
+  reset_controllers(timeout);
+  this->end_position = pursuit_path.end_pose();
+
+  if (pursuit_path.velocity_profile.empty() &&
+      default_pursuit_parameters->max_velocity > 0) {
+    pursuit_path.generate_velocity_profile(
+        default_pursuit_parameters->max_velocity,
+        default_pursuit_parameters->max_acceleration,
+        default_pursuit_parameters->max_deceleration,
+        default_pursuit_parameters->max_lateral_acceleration,
+        default_pursuit_parameters->max_velocity);
+  }
   enabled = true;
 }
 
 void PurePursuitConductor::generate_turn(TwoDPose turn_pose, double timeout) {
   this->turn_pose = turn_pose;
   is_turn = true;
+  reset_controllers(timeout);
   enabled = true;
+}
 
-  double t_out;
-  if (timeout >= 0) {
-    t_out = timeout;
-  } else {
-    t_out = default_pursuit_parameters->timeout;
-  }
+void PurePursuitConductor::chain(double exit_error, double min_speed) {
+  chained = true;
+  chain_exit_error = exit_error;
+  chain_min_speed = min_speed;
+  chain_moved = false;
+  chain_has_last_pose = false;
 }
 
-size_t i = 0;
+void PurePursuitConductor::hand_off(double left_power, double right_power) {
+  handoff_pending = true;
+  handoff_left_power = left_power;
+  handoff_right_power = right_power;
+}
 
-PursuitResult PurePursuitConductor::step(TwoDPose current_pose) {
-  if (!enabled) { // If not enabled, set is_valid as true and is_completed as
-                  // true
-    return PursuitResult(true, 0, 0, 0, 0, true);
+void PurePursuitConductor::apply_hand_off(const PursuitEstimate &estimate) {
+  if (!handoff_pending) {
+    return;
   }
+  handoff_pending = false;
 
-  PursuitEstimate estimate;
-  if (is_turn) { // If command is to turn
-    estimate =
-        PursuitEstimate(true, normalize_angle(turn_pose.yaw - current_pose.yaw),
-                        0, true, 0, true);
-    estimate.last_steering = estimate.steering_angle;
-  } else {
-    estimate = pursuit_path.calculate_pursuit_estimate(
-        current_pose, true, forward_pid.settle_error);
+  // The outputs are found through the same mixing that the first step is
+  // driven with, which may not be that of the motion that handed off
+  bool point_turn = forward_pid.is_settled() || estimate.suggest_point_turn;
+  bool reverse_drive = reversed != (estimate.direction < 0);
+  double forward_power, turn_power;
+  pursuit_powers_of_sides(handoff_left_power, handoff_right_power, point_turn,
+                          reverse_drive, &forward_power, &turn_power);
+  forward_pid.seed(estimate.distance, forward_power);
+  forward_slew.reset(forward_power);
+  turn_pid.seed(estimate.steering_angle, turn_power);
+  turn_slew.reset(turn_power);
+}
+
+bool PurePursuitConductor::chain_exited(const TwoDPose &current_pose,
+                                        const PursuitEstimate &estimate,
+                                        double dt) {
+  if (!chained) {
+    return false;
   }
 
-  if (!estimate.is_valid) { // If error or something, return is_valid as false
-    return PursuitResult(false, 0, 0, 0, 0, false);
+  double speed = 0;
+  if (chain_has_last_pose && dt > 0) {
+    if (is_turn) {
+      speed = std::abs(normalize_angle(current_pose.yaw -
+                                       chain_last_pose.yaw)) /
+              dt;
+    } else {
+      speed = std::hypot(current_pose.x - chain_last_pose.x,
+                         current_pose.y - chain_last_pose.y) /
+              dt;
+    }
   }
+  chain_last_pose = current_pose;
+  chain_has_last_pose = true;
 
-  double forward_power = forward_slew.step(forward_pid.step(estimate.distance));
-  if (forward_pid.settling()) {
-    forward_power = 0;
-    forward_pid.zeroize_accumulated();
-    estimate.steering_angle = estimate.last_steering;
-    estimate.suggest_point_turn = true;
-    if (!wipe_turn_once) {
-      wipe_turn_once = true;
-      turn_pid.zeroize_accumulated();
+  if (chain_min_speed > 0) {
+    if (speed >= chain_min_speed) {
+      chain_moved = true;
+    } else if (chain_moved) {
+      return true;
     }
-  } else if (wipe_turn_once) {
-    wipe_turn_once = false;
   }
 
-  double turn_power = turn_slew.step(turn_pid.step(estimate.steering_angle));
-  if (turn_pid.settling()) {
-    turn_power = 0;
-    turn_pid.zeroize_accumulated();
+  if (is_turn) {
+    return std::abs(estimate.steering_angle) <= chain_exit_error;
   }
+  return pursuit_path.on_final_leg() &&
+         std::abs(estimate.distance) <= chain_exit_error;
+}
 
-  PursuitResult result = PursuitResult(
-      true, estimate.steering_angle, estimate.distance,
-      clamp(forward_power, -default_pursuit_parameters->forward_max_voltage,
-            default_pursuit_parameters->forward_max_voltage),
-      clamp(turn_power, -default_pursuit_parameters->turning_max_voltage,
-            default_pursuit_parameters->turning_max_voltage),
-      false, estimate.suggest_point_turn);
-
-  if ((forward_pid.is_settled()) && turn_pid.is_settled()) {
-    result.is_completed = true;
-  } else if (turn_pid.settling() && !forward_pid.settling()) {
-    turn_pid.time_spent_settled = 0;
+bool PurePursuitConductor::feedforward_enabled() const {
+  return left_feedforward.enabled() && right_feedforward.enabled();
+}
+
+size_t i = 0;
+
+PursuitResult PurePursuitConductor::step(TwoDPose current_pose, bool reversed,
+                                         double dt) {
+  if (!enabled) { // If not enabled, set is_valid as true and is_completed as
+                  // true
+    return PursuitResult(true, 0, 0, 0, 0, true);
   }
 
-  return result;
+  this->reversed = reversed;
+  return follower()->step(current_pose, dt);
 }
 
 } // namespace whoop
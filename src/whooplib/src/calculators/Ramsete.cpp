@@ -0,0 +1,48 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Ramsete.cpp                                               */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  RAMSETE Trajectory Tracking Controller                    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/Ramsete.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include <cmath>
+
+namespace whoop {
+
+RamseteController::RamseteController(double b, double zeta)
+    : b(b), zeta(zeta) {}
+
+void RamseteController::calculate(const TwoDPose &pose,
+                                  const TrajectoryState &reference,
+                                  double *velocity,
+                                  double *angular_velocity) const {
+  // The error in the frame of the robot, whose forward axis is
+  // (cos yaw, sin yaw)
+  double sin_yaw, cos_yaw;
+  control_sincos(pose.yaw, &sin_yaw, &cos_yaw);
+  double dx = reference.x - pose.x;
+  double dy = reference.y - pose.y;
+  double error_forward = cos_yaw * dx + sin_yaw * dy;
+  double error_left = -sin_yaw * dx + cos_yaw * dy;
+  double error_yaw = control_normalize_angle(reference.yaw - pose.yaw);
+
+  // sin(x) / x, which is 1 at x = 0
+  double sinc = 1;
+  if (std::abs(error_yaw) > 1e-9) {
+    sinc = control_sin(error_yaw) / error_yaw;
+  }
+
+  double k = 2 * zeta *
+             std::sqrt(reference.angular_velocity * reference.angular_velocity +
+                       b * reference.velocity * reference.velocity);
+  *velocity =
+      reference.velocity * control_cos(error_yaw) + k * error_forward;
+  *angular_velocity = reference.angular_velocity + k * error_yaw +
+                      b * reference.velocity * sinc * error_left;
+}
+
+} // namespace whoop
@@ -0,0 +1,541 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       ReedsShepp.cpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Reeds-Shepp Curves (Forward and Reverse Motion)           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/ReedsShepp.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+static const double RS_ZERO = 1e-9;
+static const double RS_EPSILON = 1e-6;
+
+/* The segment types for each of the Reeds-Shepp words */
+static const ReedsSheppSegmentType RS_WORDS[18][5] = {
+    {RS_LEFT, RS_RIGHT, RS_LEFT, RS_NOP, RS_NOP},             // 0
+    {RS_RIGHT, RS_LEFT, RS_RIGHT, RS_NOP, RS_NOP},            // 1
+    {RS_LEFT, RS_RIGHT, RS_LEFT, RS_RIGHT, RS_NOP},           // 2
+    {RS_RIGHT, RS_LEFT, RS_RIGHT, RS_LEFT, RS_NOP},           // 3
+    {RS_LEFT, RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_NOP},        // 4
+    {RS_RIGHT, RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_NOP},       // 5
+    {RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_LEFT, RS_NOP},        // 6
+    {RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_RIGHT, RS_NOP},       // 7
+    {RS_LEFT, RS_RIGHT, RS_STRAIGHT, RS_RIGHT, RS_NOP},       // 8
+    {RS_RIGHT, RS_LEFT, RS_STRAIGHT, RS_LEFT, RS_NOP},        // 9
+    {RS_RIGHT, RS_STRAIGHT, RS_RIGHT, RS_LEFT, RS_NOP},       // 10
+    {RS_LEFT, RS_STRAIGHT, RS_LEFT, RS_RIGHT, RS_NOP},        // 11
+    {RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_NOP, RS_NOP},         // 12
+    {RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_NOP, RS_NOP},         // 13
+    {RS_LEFT, RS_STRAIGHT, RS_LEFT, RS_NOP, RS_NOP},          // 14
+    {RS_RIGHT, RS_STRAIGHT, RS_RIGHT, RS_NOP, RS_NOP},        // 15
+    {RS_LEFT, RS_RIGHT, RS_STRAIGHT, RS_LEFT, RS_RIGHT},      // 16
+    {RS_RIGHT, RS_LEFT, RS_STRAIGHT, RS_RIGHT, RS_LEFT}};     // 17
+
+/* Working state while searching for the shortest word */
+typedef struct {
+  int type;
+  double param[5];
+  double length;
+} ReedsSheppCandidate;
+
+/**
+ * Wraps an angle to [-pi, pi]
+ */
+static double rs_mod2pi(double x) {
+  double v = std::fmod(x, 2 * M_PI);
+  if (v < -M_PI) {
+    v += 2 * M_PI;
+  } else if (v > M_PI) {
+    v -= 2 * M_PI;
+  }
+  return v;
+}
+
+static void rs_polar(double x, double y, double &r, double &theta) {
+  r = std::sqrt(x * x + y * y);
+  theta = std::atan2(y, x);
+}
+
+static void rs_tau_omega(double u, double v, double xi, double eta,
+                         double phi, double &tau, double &omega) {
+  double delta = rs_mod2pi(u - v);
+  double a = std::sin(u) - std::sin(delta);
+  double b = std::cos(u) - std::cos(delta) - 1.0;
+  double t1 = std::atan2(eta * a - xi * b, xi * a + eta * b);
+  double t2 = 2.0 * (std::cos(delta) - std::cos(v) - std::cos(u)) + 3.0;
+  tau = (t2 < 0) ? rs_mod2pi(t1 + M_PI) : rs_mod2pi(t1);
+  omega = rs_mod2pi(tau - u + v - phi);
+}
+
+/* Keeps the candidate if it is shorter than the best so far */
+static void rs_consider(ReedsSheppCandidate *best, int type, double t,
+                        double u, double v, double w = 0, double x = 0) {
+  double length =
+      std::abs(t) + std::abs(u) + std::abs(v) + std::abs(w) + std::abs(x);
+  if (length < best->length) {
+    best->type = type;
+    best->param[0] = t;
+    best->param[1] = u;
+    best->param[2] = v;
+    best->param[3] = w;
+    best->param[4] = x;
+    best->length = length;
+  }
+}
+
+/* Formula 8.1 */
+static bool rs_lp_sp_lp(double x, double y, double phi, double &t, double &u,
+                        double &v) {
+  rs_polar(x - std::sin(phi), y - 1.0 + std::cos(phi), u, t);
+  if (t >= -RS_ZERO) {
+    v = rs_mod2pi(phi - t);
+    if (v >= -RS_ZERO) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Formula 8.2 */
+static bool rs_lp_sp_rp(double x, double y, double phi, double &t, double &u,
+                        double &v) {
+  double t1, u1;
+  rs_polar(x + std::sin(phi), y - 1.0 - std::cos(phi), u1, t1);
+  u1 = u1 * u1;
+  if (u1 >= 4.0) {
+    u = std::sqrt(u1 - 4.0);
+    double theta = std::atan2(2.0, u);
+    t = rs_mod2pi(t1 + theta);
+    v = rs_mod2pi(t - phi);
+    return t >= -RS_ZERO && v >= -RS_ZERO;
+  }
+  return false;
+}
+
+static void rs_csc(double x, double y, double phi, ReedsSheppCandidate *best) {
+  double t, u, v;
+  if (rs_lp_sp_lp(x, y, phi, t, u, v)) {
+    rs_consider(best, 14, t, u, v);
+  }
+  if (rs_lp_sp_lp(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 14, -t, -u, -v);
+  }
+  if (rs_lp_sp_lp(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 15, t, u, v);
+  }
+  if (rs_lp_sp_lp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 15, -t, -u, -v);
+  }
+  if (rs_lp_sp_rp(x, y, phi, t, u, v)) {
+    rs_consider(best, 12, t, u, v);
+  }
+  if (rs_lp_sp_rp(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 12, -t, -u, -v);
+  }
+  if (rs_lp_sp_rp(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 13, t, u, v);
+  }
+  if (rs_lp_sp_rp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 13, -t, -u, -v);
+  }
+}
+
+/* Formula 8.3 / 8.4, corrected from the typo in the paper */
+static bool rs_lp_rm_l(double x, double y, double phi, double &t, double &u,
+                       double &v) {
+  double xi = x - std::sin(phi);
+  double eta = y - 1.0 + std::cos(phi);
+  double u1, theta;
+  rs_polar(xi, eta, u1, theta);
+  if (u1 <= 4.0) {
+    u = -2.0 * std::asin(0.25 * u1);
+    t = rs_mod2pi(theta + 0.5 * u + M_PI);
+    v = rs_mod2pi(phi - t + u);
+    return t >= -RS_ZERO && u <= RS_ZERO;
+  }
+  return false;
+}
+
+static void rs_ccc(double x, double y, double phi, ReedsSheppCandidate *best) {
+  double t, u, v;
+  if (rs_lp_rm_l(x, y, phi, t, u, v)) {
+    rs_consider(best, 0, t, u, v);
+  }
+  if (rs_lp_rm_l(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 0, -t, -u, -v);
+  }
+  if (rs_lp_rm_l(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 1, t, u, v);
+  }
+  if (rs_lp_rm_l(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 1, -t, -u, -v);
+  }
+
+  // Backwards
+  double xb = x * std::cos(phi) + y * std::sin(phi);
+  double yb = x * std::sin(phi) - y * std::cos(phi);
+  if (rs_lp_rm_l(xb, yb, phi, t, u, v)) {
+    rs_consider(best, 0, v, u, t);
+  }
+  if (rs_lp_rm_l(-xb, yb, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 0, -v, -u, -t);
+  }
+  if (rs_lp_rm_l(xb, -yb, -phi, t, u, v)) { // reflect
+    rs_consider(best, 1, v, u, t);
+  }
+  if (rs_lp_rm_l(-xb, -yb, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 1, -v, -u, -t);
+  }
+}
+
+/* Formula 8.7 */
+static bool rs_lp_rup_lum_rm(double x, double y, double phi, double &t,
+                             double &u, double &v) {
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho = 0.25 * (2.0 + std::sqrt(xi * xi + eta * eta));
+  if (rho <= 1.0) {
+    u = std::acos(rho);
+    rs_tau_omega(u, -u, xi, eta, phi, t, v);
+    return t >= -RS_ZERO && v <= RS_ZERO;
+  }
+  return false;
+}
+
+/* Formula 8.8 */
+static bool rs_lp_rum_lum_rp(double x, double y, double phi, double &t,
+                             double &u, double &v) {
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho = (20.0 - xi * xi - eta * eta) / 16.0;
+  if (rho >= 0 && rho <= 1) {
+    u = -std::acos(rho);
+    if (u >= -0.5 * M_PI) {
+      rs_tau_omega(u, u, xi, eta, phi, t, v);
+      return t >= -RS_ZERO && v >= -RS_ZERO;
+    }
+  }
+  return false;
+}
+
+static void rs_cccc(double x, double y, double phi,
+                    ReedsSheppCandidate *best) {
+  double t, u, v;
+  if (rs_lp_rup_lum_rm(x, y, phi, t, u, v)) {
+    rs_consider(best, 2, t, u, -u, v);
+  }
+  if (rs_lp_rup_lum_rm(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 2, -t, -u, u, -v);
+  }
+  if (rs_lp_rup_lum_rm(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 3, t, u, -u, v);
+  }
+  if (rs_lp_rup_lum_rm(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 3, -t, -u, u, -v);
+  }
+
+  if (rs_lp_rum_lum_rp(x, y, phi, t, u, v)) {
+    rs_consider(best, 2, t, u, u, v);
+  }
+  if (rs_lp_rum_lum_rp(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 2, -t, -u, -u, -v);
+  }
+  if (rs_lp_rum_lum_rp(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 3, t, u, u, v);
+  }
+  if (rs_lp_rum_lum_rp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 3, -t, -u, -u, -v);
+  }
+}
+
+/* Formula 8.9 */
+static bool rs_lp_rm_sm_lm(double x, double y, double phi, double &t,
+                           double &u, double &v) {
+  double xi = x - std::sin(phi);
+  double eta = y - 1.0 + std::cos(phi);
+  double rho, theta;
+  rs_polar(xi, eta, rho, theta);
+  if (rho >= 2.0) {
+    double r = std::sqrt(rho * rho - 4.0);
+    u = 2.0 - r;
+    t = rs_mod2pi(theta + std::atan2(r, -2.0));
+    v = rs_mod2pi(phi - M_PI_2 - t);
+    return t >= -RS_ZERO && u <= RS_ZERO && v <= RS_ZERO;
+  }
+  return false;
+}
+
+/* Formula 8.10 */
+static bool rs_lp_rm_sm_rm(double x, double y, double phi, double &t,
+                           double &u, double &v) {
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho, theta;
+  rs_polar(-eta, xi, rho, theta);
+  if (rho >= 2.0) {
+    t = theta;
+    u = 2.0 - rho;
+    v = rs_mod2pi(t + M_PI_2 - phi);
+    return t >= -RS_ZERO && u <= RS_ZERO && v <= RS_ZERO;
+  }
+  return false;
+}
+
+static void rs_ccsc(double x, double y, double phi,
+                    ReedsSheppCandidate *best) {
+  double t, u, v;
+  if (rs_lp_rm_sm_lm(x, y, phi, t, u, v)) {
+    rs_consider(best, 4, t, -M_PI_2, u, v);
+  }
+  if (rs_lp_rm_sm_lm(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 4, -t, M_PI_2, -u, -v);
+  }
+  if (rs_lp_rm_sm_lm(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 5, t, -M_PI_2, u, v);
+  }
+  if (rs_lp_rm_sm_lm(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 5, -t, M_PI_2, -u, -v);
+  }
+
+  if (rs_lp_rm_sm_rm(x, y, phi, t, u, v)) {
+    rs_consider(best, 8, t, -M_PI_2, u, v);
+  }
+  if (rs_lp_rm_sm_rm(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 8, -t, M_PI_2, -u, -v);
+  }
+  if (rs_lp_rm_sm_rm(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 9, t, -M_PI_2, u, v);
+  }
+  if (rs_lp_rm_sm_rm(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 9, -t, M_PI_2, -u, -v);
+  }
+
+  // Backwards
+  double xb = x * std::cos(phi) + y * std::sin(phi);
+  double yb = x * std::sin(phi) - y * std::cos(phi);
+  if (rs_lp_rm_sm_lm(xb, yb, phi, t, u, v)) {
+    rs_consider(best, 6, v, u, -M_PI_2, t);
+  }
+  if (rs_lp_rm_sm_lm(-xb, yb, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 6, -v, -u, M_PI_2, -t);
+  }
+  if (rs_lp_rm_sm_lm(xb, -yb, -phi, t, u, v)) { // reflect
+    rs_consider(best, 7, v, u, -M_PI_2, t);
+  }
+  if (rs_lp_rm_sm_lm(-xb, -yb, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 7, -v, -u, M_PI_2, -t);
+  }
+
+  if (rs_lp_rm_sm_rm(xb, yb, phi, t, u, v)) {
+    rs_consider(best, 10, v, u, -M_PI_2, t);
+  }
+  if (rs_lp_rm_sm_rm(-xb, yb, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 10, -v, -u, M_PI_2, -t);
+  }
+  if (rs_lp_rm_sm_rm(xb, -yb, -phi, t, u, v)) { // reflect
+    rs_consider(best, 11, v, u, -M_PI_2, t);
+  }
+  if (rs_lp_rm_sm_rm(-xb, -yb, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 11, -v, -u, M_PI_2, -t);
+  }
+}
+
+/* Formula 8.11, corrected from the typo in the paper */
+static bool rs_lp_rm_slm_rp(double x, double y, double phi, double &t,
+                            double &u, double &v) {
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho, theta;
+  rs_polar(xi, eta, rho, theta);
+  if (rho >= 2.0) {
+    u = 4.0 - std::sqrt(rho * rho - 4.0);
+    if (u <= RS_ZERO) {
+      t = rs_mod2pi(std::atan2((4.0 - u) * xi - 2.0 * eta,
+                               -2.0 * xi + (u - 4.0) * eta));
+      v = rs_mod2pi(t - phi);
+      return t >= -RS_ZERO && v >= -RS_ZERO;
+    }
+  }
+  return false;
+}
+
+static void rs_ccscc(double x, double y, double phi,
+                     ReedsSheppCandidate *best) {
+  double t, u, v;
+  if (rs_lp_rm_slm_rp(x, y, phi, t, u, v)) {
+    rs_consider(best, 16, t, -M_PI_2, u, -M_PI_2, v);
+  }
+  if (rs_lp_rm_slm_rp(-x, y, -phi, t, u, v)) { // timeflip
+    rs_consider(best, 16, -t, M_PI_2, -u, M_PI_2, -v);
+  }
+  if (rs_lp_rm_slm_rp(x, -y, -phi, t, u, v)) { // reflect
+    rs_consider(best, 17, t, -M_PI_2, u, -M_PI_2, v);
+  }
+  if (rs_lp_rm_slm_rp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    rs_consider(best, 17, -t, M_PI_2, -u, M_PI_2, -v);
+  }
+}
+
+int reeds_shepp_shortest_path(ReedsSheppPath *path, double q0[3],
+                              double q1[3], double rho) {
+  if (rho <= 0.0) {
+    return EDUBBADRHO;
+  }
+
+  // Express the goal relative to the start, normalized by the turning radius
+  double dx = q1[0] - q0[0];
+  double dy = q1[1] - q0[1];
+  double c = std::cos(q0[2]);
+  double s = std::sin(q0[2]);
+  double x = (c * dx + s * dy) / rho;
+  double y = (-s * dx + c * dy) / rho;
+  double phi = q1[2] - q0[2];
+
+  ReedsSheppCandidate best;
+  best.type = -1;
+  best.length = INFINITY;
+  rs_csc(x, y, phi, &best);
+  rs_ccc(x, y, phi, &best);
+  rs_cccc(x, y, phi, &best);
+  rs_ccsc(x, y, phi, &best);
+  rs_ccscc(x, y, phi, &best);
+
+  if (best.type < 0) {
+    return EDUBNOPATH;
+  }
+
+  path->qi[0] = q0[0];
+  path->qi[1] = q0[1];
+  path->qi[2] = q0[2];
+  path->rho = rho;
+  path->type = best.type;
+  for (int i = 0; i < 5; i++) {
+    path->param[i] = best.param[i];
+  }
+  return EDUBOK;
+}
+
+double reeds_shepp_path_length(ReedsSheppPath *path) {
+  double length = 0;
+  for (int i = 0; i < 5; i++) {
+    length += std::abs(path->param[i]);
+  }
+  return length * path->rho;
+}
+
+double reeds_shepp_segment_length(ReedsSheppPath *path, int i) {
+  if ((i < 0) || (i > 4)) {
+    return INFINITY;
+  }
+  return std::abs(path->param[i]) * path->rho;
+}
+
+ReedsSheppSegmentType reeds_shepp_segment_type(ReedsSheppPath *path, int i) {
+  if ((i < 0) || (i > 4)) {
+    return RS_NOP;
+  }
+  return RS_WORDS[path->type][i];
+}
+
+int reeds_shepp_segment_direction(ReedsSheppPath *path, int i) {
+  if ((i < 0) || (i > 4) || RS_WORDS[path->type][i] == RS_NOP ||
+      std::abs(path->param[i]) < RS_ZERO) {
+    return 0;
+  }
+  return path->param[i] < 0 ? -1 : 1;
+}
+
+int reeds_shepp_direction_at(ReedsSheppPath *path, double t) {
+  double remaining = t / path->rho;
+  int direction = 1;
+  for (int i = 0; i < 5; i++) {
+    int segment_direction = reeds_shepp_segment_direction(path, i);
+    if (segment_direction == 0) {
+      continue;
+    }
+    direction = segment_direction;
+    remaining -= std::abs(path->param[i]);
+    if (remaining < 0) {
+      break;
+    }
+  }
+  return direction;
+}
+
+int reeds_shepp_path_sample(ReedsSheppPath *path, double t, double q[3]) {
+  if (t < -RS_EPSILON || t > reeds_shepp_path_length(path) + RS_EPSILON) {
+    return EDUBPARAM;
+  }
+
+  // Walk the segments in normalized space, starting from the origin
+  double remaining = t / path->rho;
+  double x = 0;
+  double y = 0;
+  double phi = path->qi[2];
+
+  for (int i = 0; i < 5 && remaining > 0; i++) {
+    ReedsSheppSegmentType type = RS_WORDS[path->type][i];
+    if (type == RS_NOP) {
+      break;
+    }
+
+    double v;
+    if (path->param[i] < 0) {
+      v = std::max(-remaining, path->param[i]);
+      remaining += v;
+    } else {
+      v = std::min(remaining, path->param[i]);
+      remaining -= v;
+    }
+
+    if (type == RS_LEFT) {
+      x += std::sin(phi + v) - std::sin(phi);
+      y += -std::cos(phi + v) + std::cos(phi);
+      phi += v;
+    } else if (type == RS_RIGHT) {
+      x += -std::sin(phi - v) + std::sin(phi);
+      y += std::cos(phi - v) - std::cos(phi);
+      phi -= v;
+    } else {
+      x += v * std::cos(phi);
+      y += v * std::sin(phi);
+    }
+  }
+
+  // Scale the configuration, and translate back to the original start
+  q[0] = x * path->rho + path->qi[0];
+  q[1] = y * path->rho + path->qi[1];
+  q[2] = phi - 2 * M_PI * std::floor(phi / (2 * M_PI));
+
+  return EDUBOK;
+}
+
+int reeds_shepp_path_sample_many(ReedsSheppPath *path, double stepSize,
+                                 DubinsPathSamplingCallback cb,
+                                 void *user_data) {
+  int retcode;
+  double q[3];
+  double x = 0.0;
+  double length = reeds_shepp_path_length(path);
+  while (x < length) {
+    reeds_shepp_path_sample(path, x, q);
+    retcode = cb(q, x, user_data);
+    if (retcode != 0) {
+      return retcode;
+    }
+    x += stepSize;
+  }
+  return 0;
+}
+
+int reeds_shepp_path_endpoint(ReedsSheppPath *path, double q[3]) {
+  return reeds_shepp_path_sample(path, reeds_shepp_path_length(path), q);
+}
+
+} // namespace whoop
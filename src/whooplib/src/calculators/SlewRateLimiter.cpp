@@ -20,14 +20,24 @@ SlewRateLimiter::SlewRateLimiter(double max_slew_rate,
 }
 
 double SlewRateLimiter::step(double desired_output) {
+  return limit(desired_output, max_slew_rate_scaled);
+}
+
+double SlewRateLimiter::step(double desired_output, double dt) {
+  return limit(desired_output, max_slew_rate * dt);
+}
+
+void SlewRateLimiter::reset(double output) { previous_output = output; }
+
+double SlewRateLimiter::limit(double desired_output, double max_change) {
   // Calculate the desired change in output
   double delta_output = desired_output - previous_output;
 
-  // Limit the change (delta_output) to the max_slew_rate_scaled
-  if (delta_output > max_slew_rate_scaled) {
-    delta_output = max_slew_rate_scaled;
-  } else if (delta_output < -max_slew_rate_scaled) {
-    delta_output = -max_slew_rate_scaled;
+  // Limit the change (delta_output) to the max_change
+  if (delta_output > max_change) {
+    delta_output = max_change;
+  } else if (delta_output < -max_change) {
+    delta_output = -max_change;
   }
 
   // Update the output based on the limited delta
@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Trajectory.cpp                                            */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Time-Parameterized Trajectory Along a Path                */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/Trajectory.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+void Trajectory::clear() { states.clear(); }
+
+bool Trajectory::empty() const { return states.empty(); }
+
+void Trajectory::generate(const std::vector<TwoDPose> &poses,
+                          const std::vector<double> &stations,
+                          const std::vector<double> &velocities,
+                          double max_acceleration) {
+  states.clear();
+  size_t n = std::min(poses.size(),
+                      std::min(stations.size(), velocities.size()));
+  if (n == 0) {
+    return;
+  }
+
+  double time = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (i > 0) {
+      double ds = std::abs(stations[i] - stations[i - 1]);
+      double average_velocity =
+          (std::abs(velocities[i]) + std::abs(velocities[i - 1])) / 2;
+      if (average_velocity > 1e-9) {
+        time += ds / average_velocity;
+      } else if (max_acceleration > 0) {
+        time += std::sqrt(2 * ds / max_acceleration);
+      }
+    }
+    states.push_back(TrajectoryState(time, poses[i].x, poses[i].y,
+                                     poses[i].yaw, velocities[i]));
+  }
+
+  // Central differences for the rates, and one-sided at the ends
+  for (size_t i = 0; i < n; i++) {
+    size_t before = i > 0 ? i - 1 : i;
+    size_t after = i + 1 < n ? i + 1 : i;
+    double dt = states[after].time - states[before].time;
+    if (dt <= 0) {
+      continue;
+    }
+    states[i].angular_velocity =
+        normalize_angle(states[after].yaw - states[before].yaw) / dt;
+    states[i].acceleration =
+        (states[after].velocity - states[before].velocity) / dt;
+  }
+}
+
+double Trajectory::duration() const {
+  if (states.empty()) {
+    return 0;
+  }
+  return states.back().time;
+}
+
+TrajectoryState Trajectory::sample(double time) const {
+  if (states.empty()) {
+    return TrajectoryState();
+  }
+  if (time <= states.front().time) {
+    return states.front();
+  }
+  if (time >= states.back().time) {
+    TrajectoryState end = states.back();
+    end.time = time;
+    end.velocity = 0;
+    end.angular_velocity = 0;
+    end.acceleration = 0;
+    return end;
+  }
+
+  // Binary search for the first state past the time
+  size_t i = std::upper_bound(states.begin(), states.end(), time,
+                              [](double t, const TrajectoryState &state) {
+                                return t < state.time;
+                              }) -
+             states.begin();
+  const TrajectoryState &a = states[i - 1];
+  const TrajectoryState &b = states[i];
+  double fraction = (time - a.time) / (b.time - a.time);
+  return TrajectoryState(
+      time, a.x + fraction * (b.x - a.x), a.y + fraction * (b.y - a.y),
+      normalize_angle(a.yaw + fraction * normalize_angle(b.yaw - a.yaw)),
+      a.velocity + fraction * (b.velocity - a.velocity),
+      a.angular_velocity +
+          fraction * (b.angular_velocity - a.angular_velocity),
+      a.acceleration + fraction * (b.acceleration - a.acceleration));
+}
+
+} // namespace whoop
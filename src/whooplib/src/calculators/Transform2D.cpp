@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Transform2D.cpp                                           */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Two-Dimensional Transforms With a Cached Rotation         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/Transform2D.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
+#include <cmath>
+
+namespace whoop {
+
+template <typename Scalar>
+Transform2DT<Scalar>::Transform2DT(Scalar x, Scalar y, Scalar yaw)
+    : x(x), y(y), yaw(yaw) {
+  control_sincos(yaw, &sin_yaw, &cos_yaw);
+}
+
+template <typename Scalar>
+Transform2DT<Scalar>::Transform2DT(const TwoDPoseT<Scalar> &pose)
+    : Transform2DT(pose.x, pose.y, pose.yaw) {}
+
+// The rotation matches TwoDPose: the relative x axis points to
+// (sin_yaw, -cos_yaw) and the relative y axis to (cos_yaw, sin_yaw)
+
+template <typename Scalar>
+TwoDPoseT<Scalar>
+Transform2DT<Scalar>::to_world_space(const TwoDPoseT<Scalar> &pose) const {
+  return TwoDPoseT<Scalar>(x + pose.x * sin_yaw + pose.y * cos_yaw,
+                           y - pose.x * cos_yaw + pose.y * sin_yaw,
+                           control_normalize_angle(yaw + pose.yaw));
+}
+
+template <typename Scalar>
+TwoDPoseT<Scalar>
+Transform2DT<Scalar>::to_object_space(const TwoDPoseT<Scalar> &pose) const {
+  Scalar dx = pose.x - x;
+  Scalar dy = pose.y - y;
+  return TwoDPoseT<Scalar>(dx * sin_yaw - dy * cos_yaw,
+                           dx * cos_yaw + dy * sin_yaw,
+                           control_normalize_angle(pose.yaw - yaw));
+}
+
+template <typename Scalar>
+Transform2DT<Scalar>
+Transform2DT<Scalar>::to_object_space(const Transform2DT &other) const {
+  Scalar dx = other.x - x;
+  Scalar dy = other.y - y;
+  Transform2DT result;
+  result.x = dx * sin_yaw - dy * cos_yaw;
+  result.y = dx * cos_yaw + dy * sin_yaw;
+  result.yaw = other.yaw - yaw;
+  result.cos_yaw = cos_yaw * other.cos_yaw + sin_yaw * other.sin_yaw;
+  result.sin_yaw = cos_yaw * other.sin_yaw - sin_yaw * other.cos_yaw;
+  return result;
+}
+
+template <typename Scalar>
+Transform2DT<Scalar>
+Transform2DT<Scalar>::operator*(const Transform2DT &other) const {
+  Transform2DT result;
+  result.x = x + other.x * sin_yaw + other.y * cos_yaw;
+  result.y = y - other.x * cos_yaw + other.y * sin_yaw;
+  result.yaw = yaw + other.yaw;
+  result.cos_yaw = cos_yaw * other.cos_yaw - sin_yaw * other.sin_yaw;
+  result.sin_yaw = sin_yaw * other.cos_yaw + cos_yaw * other.sin_yaw;
+  return result;
+}
+
+template <typename Scalar>
+Transform2DT<Scalar> &
+Transform2DT<Scalar>::operator*=(const Transform2DT &other) {
+  *this = *this * other;
+  return *this;
+}
+
+template <typename Scalar>
+Transform2DT<Scalar> Transform2DT<Scalar>::inverse() const {
+  Transform2DT result;
+  result.x = -x * sin_yaw + y * cos_yaw;
+  result.y = -x * cos_yaw - y * sin_yaw;
+  result.yaw = -yaw;
+  result.cos_yaw = cos_yaw;
+  result.sin_yaw = -sin_yaw;
+  return result;
+}
+
+template <typename Scalar>
+void Transform2DT<Scalar>::to_world_space(const Scalar *points, size_t count,
+                                          Scalar *out) const {
+  for (size_t i = 0; i < 2 * count; i += 2) {
+    Scalar point_x = points[i];
+    Scalar point_y = points[i + 1];
+    out[i] = x + point_x * sin_yaw + point_y * cos_yaw;
+    out[i + 1] = y - point_x * cos_yaw + point_y * sin_yaw;
+  }
+}
+
+template <typename Scalar>
+void Transform2DT<Scalar>::to_object_space(const Scalar *points, size_t count,
+                                           Scalar *out) const {
+  for (size_t i = 0; i < 2 * count; i += 2) {
+    Scalar dx = points[i] - x;
+    Scalar dy = points[i + 1] - y;
+    out[i] = dx * sin_yaw - dy * cos_yaw;
+    out[i + 1] = dx * cos_yaw + dy * sin_yaw;
+  }
+}
+
+template <typename Scalar> void Transform2DT<Scalar>::normalize() {
+  yaw = control_normalize_angle(yaw);
+  Scalar length = std::sqrt(cos_yaw * cos_yaw + sin_yaw * sin_yaw);
+  cos_yaw /= length;
+  sin_yaw /= length;
+}
+
+template <typename Scalar>
+TwoDPoseT<Scalar> Transform2DT<Scalar>::to_pose() const {
+  return TwoDPoseT<Scalar>(x, y, control_normalize_angle(yaw));
+}
+
+template class Transform2DT<double>;
+template class Transform2DT<float>;
+
+} // namespace whoop
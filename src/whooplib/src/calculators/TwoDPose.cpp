@@ -8,6 +8,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "whooplib/include/calculators/TwoDPose.hpp"
+#include "whooplib/include/calculators/FastMath.hpp"
 #include "whooplib/include/toolbox.hpp"
 #include <cmath>
 #include <iomanip>
@@ -16,77 +17,94 @@
 
 namespace whoop {
 
-TwoDPose::TwoDPose(double x, double y, double yaw) {
+template <typename Scalar>
+TwoDPoseT<Scalar>::TwoDPoseT(Scalar x, Scalar y, Scalar yaw) {
   this->x = x;
   this->y = y;
   this->yaw = yaw;
 }
 
-TwoDPose TwoDPose::global_xy_delta_only(const TwoDPose &other) const {
+template <typename Scalar>
+TwoDPoseT<Scalar>
+TwoDPoseT<Scalar>::global_xy_delta_only(const TwoDPoseT &other) const {
   // Calculate the new position, preserving yaw
-  TwoDPose result = toWorldSpace(other);
+  TwoDPoseT result = toWorldSpace(other);
   result.yaw = this->yaw;
 
   return result;
 }
 
-TwoDPose TwoDPose::operator*(const TwoDPose &other) const {
+template <typename Scalar>
+TwoDPoseT<Scalar> TwoDPoseT<Scalar>::operator*(const TwoDPoseT &other) const {
   return toWorldSpace(other);
 }
 
-TwoDPose TwoDPose::lookAt(double target_x, double target_y) {
-  double dx = target_x - this->x;
-  double dy = target_y - this->y;
+template <typename Scalar>
+TwoDPoseT<Scalar> TwoDPoseT<Scalar>::lookAt(Scalar target_x, Scalar target_y) {
+  Scalar dx = target_x - this->x;
+  Scalar dy = target_y - this->y;
 
-  return TwoDPose(x, y, atan2(dy, dx));
+  return TwoDPoseT(x, y, control_atan2(dy, dx));
 }
 
-TwoDPose &TwoDPose::operator*=(const TwoDPose &other) {
+template <typename Scalar>
+TwoDPoseT<Scalar> &TwoDPoseT<Scalar>::operator*=(const TwoDPoseT &other) {
   *this = *this * other;
   return *this;
 }
 
-TwoDPose TwoDPose::toObjectSpace(const TwoDPose &other) const {
+template <typename Scalar>
+TwoDPoseT<Scalar>
+TwoDPoseT<Scalar>::toObjectSpace(const TwoDPoseT &other) const {
   return this->toObjectSpace(other.x, other.y, other.yaw);
 }
 
-TwoDPose TwoDPose::toObjectSpace(double x, double y, double yaw) const {
+template <typename Scalar>
+TwoDPoseT<Scalar> TwoDPoseT<Scalar>::toObjectSpace(Scalar x, Scalar y,
+                                                   Scalar yaw) const {
   // Calculate the relative position
-  double dx = x - this->x;
-  double dy = y - this->y;
+  Scalar dx = x - this->x;
+  Scalar dy = y - this->y;
 
   // Create the rotation matrix for -yaw
-  double cos_yaw = cos(this->yaw);
-  double sin_yaw = sin(this->yaw);
+  Scalar cos_yaw, sin_yaw;
+  control_sincos(this->yaw, &sin_yaw, &cos_yaw);
 
   // Apply the rotation matrix
-  double relative_x = dx * sin_yaw - dy * cos_yaw;
-  double relative_y = dx * cos_yaw + dy * sin_yaw;
+  Scalar relative_x = dx * sin_yaw - dy * cos_yaw;
+  Scalar relative_y = dx * cos_yaw + dy * sin_yaw;
 
   // Calculate the relative yaw
-  double relative_yaw =
-      normalize_angle(normalize_angle(yaw) - normalize_angle(this->yaw));
+  Scalar relative_yaw =
+      control_normalize_angle(control_normalize_angle(yaw) -
+                              control_normalize_angle(this->yaw));
 
-  return TwoDPose(relative_x, relative_y, relative_yaw);
+  return TwoDPoseT(relative_x, relative_y, relative_yaw);
 }
 
-TwoDPose TwoDPose::operator-() const { return TwoDPose(-x, -y, -yaw); }
-
-TwoDPose TwoDPose::toWorldSpace(const TwoDPose &other) const {
+template <typename Scalar>
+TwoDPoseT<Scalar> TwoDPoseT<Scalar>::operator-() const {
+  return TwoDPoseT(-x, -y, -yaw);
+}
 
-  double const cos_yaw = cos(this->yaw);
-  double const sin_yaw = sin(this->yaw);
+template <typename Scalar>
+TwoDPoseT<Scalar>
+TwoDPoseT<Scalar>::toWorldSpace(const TwoDPoseT &other) const {
+  Scalar cos_yaw, sin_yaw;
+  control_sincos(this->yaw, &sin_yaw, &cos_yaw);
 
-  double global_x = this->x + other.x * sin_yaw + other.y * cos_yaw;
-  double global_y = this->y - other.x * cos_yaw + other.y * sin_yaw;
+  Scalar global_x = this->x + other.x * sin_yaw + other.y * cos_yaw;
+  Scalar global_y = this->y - other.x * cos_yaw + other.y * sin_yaw;
 
-  double global_yaw =
-      normalize_angle(normalize_angle(this->yaw) + normalize_angle(other.yaw));
+  Scalar global_yaw =
+      control_normalize_angle(control_normalize_angle(this->yaw) +
+                              control_normalize_angle(other.yaw));
 
-  return TwoDPose(global_x, global_y, global_yaw);
+  return TwoDPoseT(global_x, global_y, global_yaw);
 }
 
-std::string TwoDPose::to_string(int decimal_places) {
+template <typename Scalar>
+std::string TwoDPoseT<Scalar>::to_string(int decimal_places) {
   std::ostringstream oss;
   if (decimal_places >= 0) {
     oss << std::fixed << std::setprecision(decimal_places);
@@ -95,7 +113,8 @@ std::string TwoDPose::to_string(int decimal_places) {
   return oss.str();
 }
 
-std::string TwoDPose::to_realsense_string(int decimal_places) {
+template <typename Scalar>
+std::string TwoDPoseT<Scalar>::to_realsense_string(int decimal_places) {
   std::ostringstream oss;
   if (decimal_places >= 0) {
     oss << std::fixed << std::setprecision(decimal_places);
@@ -104,4 +123,7 @@ std::string TwoDPose::to_realsense_string(int decimal_places) {
   return oss.str();
 }
 
+template class TwoDPoseT<double>;
+template class TwoDPoseT<float>;
+
 } // namespace whoop
@@ -0,0 +1,150 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       VelocityProfile.cpp                                       */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Curvature-Constrained Velocity Profile Along a Path       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/VelocityProfile.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+void VelocityProfile::clear() {
+  stations.clear();
+  velocities.clear();
+}
+
+bool VelocityProfile::empty() const { return stations.empty(); }
+
+void VelocityProfile::generate(const std::vector<double> &stations,
+                               const std::vector<double> &curvatures,
+                               double max_velocity, double max_acceleration,
+                               double max_deceleration,
+                               double max_lateral_acceleration,
+                               double start_velocity, double end_velocity,
+                               const std::vector<double> &stops,
+                               double track_width) {
+  this->stations = stations;
+  velocities.assign(stations.size(), max_velocity);
+
+  size_t n = stations.size();
+  if (n == 0) {
+    return;
+  }
+
+  // Cap the velocity on curves so that v^2 * curvature stays within the
+  // maximum lateral acceleration
+  if (max_lateral_acceleration > 0) {
+    for (size_t i = 0; i < n && i < curvatures.size(); i++) {
+      double curvature = std::abs(curvatures[i]);
+      if (curvature > 0) {
+        velocities[i] = std::min(
+            velocities[i], std::sqrt(max_lateral_acceleration / curvature));
+      }
+    }
+  }
+
+  // Cap the velocity on curves so that the outer wheels stay within the
+  // maximum velocity
+  if (track_width > 0) {
+    for (size_t i = 0; i < n && i < curvatures.size(); i++) {
+      velocities[i] =
+          std::min(velocities[i], max_velocity / (1 + std::abs(curvatures[i]) *
+                                                          track_width / 2));
+    }
+  }
+
+  velocities[0] = std::min(velocities[0], std::max(0.0, start_velocity));
+  velocities[n - 1] = std::min(velocities[n - 1], std::max(0.0, end_velocity));
+
+  // Come to a stop at the station closest to each stop
+  for (double stop : stops) {
+    size_t i = std::lower_bound(stations.begin(), stations.end(), stop) -
+               stations.begin();
+    if (i == n || (i > 0 && stop - stations[i - 1] < stations[i] - stop)) {
+      i--;
+    }
+    velocities[i] = 0;
+  }
+
+  // Forward pass, v^2 = u^2 + 2as limits how quickly the robot speeds up
+  for (size_t i = 1; i < n; i++) {
+    double ds = stations[i] - stations[i - 1];
+    velocities[i] =
+        std::min(velocities[i], std::sqrt(velocities[i - 1] * velocities[i - 1] +
+                                          2 * max_acceleration * ds));
+  }
+
+  // Backward pass, so that the robot can always slow down in time for the
+  // next curve and for the end of the path
+  for (size_t i = n - 1; i > 0; i--) {
+    double ds = stations[i] - stations[i - 1];
+    velocities[i - 1] =
+        std::min(velocities[i - 1], std::sqrt(velocities[i] * velocities[i] +
+                                              2 * max_deceleration * ds));
+  }
+}
+
+void VelocityProfile::limit_motor_acceleration(double acceleration,
+                                               double free_velocity) {
+  if (free_velocity <= 0) {
+    return;
+  }
+
+  // Another forward pass, with the acceleration at the previous station.
+  // Only lowering velocities keeps the backward pass satisfied
+  for (size_t i = 1; i < stations.size(); i++) {
+    double ds = stations[i] - stations[i - 1];
+    double available =
+        acceleration * std::max(1 - velocities[i - 1] / free_velocity, 0.0);
+    velocities[i] =
+        std::min(velocities[i], std::sqrt(velocities[i - 1] * velocities[i - 1] +
+                                          2 * available * ds));
+  }
+}
+
+double VelocityProfile::length() const {
+  if (stations.empty()) {
+    return 0;
+  }
+  return stations.back();
+}
+
+double VelocityProfile::velocity_at(double s) const {
+  if (stations.empty()) {
+    return 0;
+  }
+  if (s <= stations.front()) {
+    return velocities.front();
+  }
+  if (s >= stations.back()) {
+    return velocities.back();
+  }
+
+  // Binary search for the first station past s
+  size_t i = std::upper_bound(stations.begin(), stations.end(), s) -
+             stations.begin();
+  double ds = stations[i] - stations[i - 1];
+  if (ds <= 0) {
+    return velocities[i];
+  }
+  double fraction = (s - stations[i - 1]) / ds;
+  return velocities[i - 1] + fraction * (velocities[i] - velocities[i - 1]);
+}
+
+double VelocityProfile::duration() const {
+  double time = 0;
+  for (size_t i = 1; i < stations.size(); i++) {
+    double average_velocity = (velocities[i] + velocities[i - 1]) / 2;
+    if (average_velocity > 0) {
+      time += (stations[i] - stations[i - 1]) / average_velocity;
+    }
+  }
+  return time;
+}
+
+} // namespace whoop
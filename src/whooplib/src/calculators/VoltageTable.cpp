@@ -0,0 +1,137 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       VoltageTable.cpp                                          */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Characterized Voltage Lookup Table for Linear Motors      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include "whooplib/include/calculators/VoltageTable.hpp"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace whoop {
+
+// The tables are copied as-is, so their layout is part of the file format
+static_assert(sizeof(VoltageTableFileHeader) == 16,
+              "Voltage table file header changed");
+static_assert(sizeof(VoltageTable) == 2 * VoltageTable::SIZE * sizeof(float),
+              "VoltageTable changed");
+static_assert(std::is_trivially_copyable<VoltageTable>::value,
+              "VoltageTable must be trivially copyable");
+
+VoltageTable::VoltageTable() {
+  for (int i = 0; i < SIZE; i++) {
+    forward[i] = backward[i] = 12.0f * i / (SIZE - 1);
+  }
+}
+
+/**
+ * Fills the entries of one direction from its samples
+ * @param samples Voltage and velocity, both positive in the direction
+ * @param entries Where to store the SIZE entries
+ * @returns false if the motor did not move
+ */
+static bool build_direction(std::vector<std::pair<double, double>> samples,
+                            float *entries) {
+  samples.push_back({0, 0});
+  std::sort(samples.begin(), samples.end());
+
+  // Friction and noise can make the velocity dip, but the table must rise
+  for (size_t i = 1; i < samples.size(); i++) {
+    samples[i].second = std::max(samples[i].second, samples[i - 1].second);
+  }
+  double top_speed = samples.back().second;
+  if (top_speed <= 0) {
+    return false;
+  }
+
+  entries[0] = 0; // Still at 0 volts, instead of pushing against friction
+  size_t j = 1;
+  for (int i = 1; i < VoltageTable::SIZE; i++) {
+    double target = top_speed * i / (VoltageTable::SIZE - 1);
+    while (j < samples.size() - 1 && samples[j].second < target) {
+      j++;
+    }
+    const std::pair<double, double> &low = samples[j - 1];
+    const std::pair<double, double> &high = samples[j];
+    double t = 1;
+    if (high.second > low.second) {
+      t = (target - low.second) / (high.second - low.second);
+    }
+    entries[i] = low.first + (high.first - low.first) * std::min(t, 1.0);
+  }
+  return true;
+}
+
+bool VoltageTable::build(const std::vector<double> &voltages,
+                         const std::vector<double> &velocities) {
+  std::vector<std::pair<double, double>> forward_samples, backward_samples;
+  size_t count = std::min(voltages.size(), velocities.size());
+  for (size_t i = 0; i < count; i++) {
+    if (voltages[i] > 0) {
+      forward_samples.push_back({voltages[i], std::max(velocities[i], 0.0)});
+    } else if (voltages[i] < 0) {
+      backward_samples.push_back(
+          {-voltages[i], std::max(-velocities[i], 0.0)});
+    }
+  }
+
+  float new_forward[SIZE], new_backward[SIZE];
+  if (!build_direction(forward_samples, new_forward) ||
+      !build_direction(backward_samples, new_backward)) {
+    return false;
+  }
+  std::memcpy(forward, new_forward, sizeof(forward));
+  std::memcpy(backward, new_backward, sizeof(backward));
+  return true;
+}
+
+std::vector<uint8_t>
+serialize_voltage_tables(const std::vector<VoltageTable> &tables) {
+  VoltageTableFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = VOLTAGE_TABLE_MAGIC;
+  header.version = VOLTAGE_TABLE_VERSION;
+  header.header_size = sizeof(VoltageTableFileHeader);
+  header.table_size = VoltageTable::SIZE;
+  header.num_tables = tables.size();
+
+  std::vector<uint8_t> bytes(sizeof(header) +
+                             tables.size() * sizeof(VoltageTable));
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  if (!tables.empty()) {
+    std::memcpy(bytes.data() + sizeof(header), tables.data(),
+                tables.size() * sizeof(VoltageTable));
+  }
+  return bytes;
+}
+
+bool deserialize_voltage_tables(const uint8_t *data, size_t size,
+                                std::vector<VoltageTable> &tables) {
+  if (data == nullptr || size < sizeof(VoltageTableFileHeader)) {
+    return false;
+  }
+
+  VoltageTableFileHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != VOLTAGE_TABLE_MAGIC ||
+      header.version != VOLTAGE_TABLE_VERSION ||
+      header.header_size != sizeof(VoltageTableFileHeader) ||
+      header.table_size != VoltageTable::SIZE ||
+      size != sizeof(header) + header.num_tables * sizeof(VoltageTable)) {
+    return false;
+  }
+
+  tables.resize(header.num_tables);
+  if (header.num_tables > 0) {
+    std::memcpy(tables.data(), data + sizeof(header),
+                header.num_tables * sizeof(VoltageTable));
+  }
+  return true;
+}
+
+} // namespace whoop
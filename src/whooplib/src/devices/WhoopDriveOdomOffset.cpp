@@ -8,6 +8,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "whooplib/include/devices/WhoopDriveOdomOffset.hpp"
+#include "whooplib/include/calculators/Transform2D.hpp"
 #include "whooplib/include/calculators/TwoDPose.hpp"
 #include "whooplib/include/nodes/NodeManager.hpp"
 #include "whooplib/includer.hpp"
@@ -22,6 +23,7 @@ WhoopDriveOdomOffset::WhoopDriveOdomOffset(WhoopDriveOdomUnit *odom_unit,
     : offset(x_offset, -y_offset,
              0) { // The x and y offsets are flipped... Idk why it just is.
   this->odom_unit = odom_unit;
+  negative_offset = Transform2D(-offset);
 }
 
 void WhoopDriveOdomOffset::calibrate() {
@@ -43,16 +45,12 @@ void WhoopDriveOdomOffset::tare(double x, double y, double yaw) {
 
   odom_unit->tare(TaredOffset.x, TaredOffset.y, TaredOffset.yaw);
 
-  if (offset.x == offset.y == offset.yaw == 0) { // If offset is not applied
-    pose =
-        odom_unit
-            ->pose; // Update pose without offset, to reduce computational time
-  } else {
-    pose = odom_unit->pose * -offset; // Update pose with offset
-  }
+  update_pose();
 
   last_pose = pose; // Just set last_pose to pose to prevent it from flying out
                     // the wazoo
+  last_pose_transform = pose_transform;
+  last_pose_transform_cached = pose_transform_cached;
 
   thread_lock.unlock();
 }
@@ -87,9 +85,9 @@ bool WhoopDriveOdomOffset::is_moving(double rads_s_threshold) {
 
 velocityVector WhoopDriveOdomOffset::get_velocity_vector() {
   thread_lock.lock();
-  velocityVector vel((pose.x - last_pose.x) / 0.01,
-                     (pose.y - last_pose.y) / 0.01,
-                     (pose.yaw - last_pose.yaw) / 0.01, is_clean);
+  velocityVector vel((pose.x - last_pose.x) / pose_dt,
+                     (pose.y - last_pose.y) / pose_dt,
+                     (pose.yaw - last_pose.yaw) / pose_dt, is_clean);
   thread_lock.unlock();
 
   return vel;
@@ -97,12 +95,21 @@ velocityVector WhoopDriveOdomOffset::get_velocity_vector() {
 
 velocityVector WhoopDriveOdomOffset::get_velocity_vector(TwoDPose offset) {
   thread_lock.lock();
-  TwoDPose p =
-      pose *
-      offset; // Apply offset to position of realsense device, or whatever
-  TwoDPose l_p = last_pose * offset;
-  velocityVector vel((p.x - l_p.x) / 0.01, (p.y - l_p.y) / 0.01,
-                     (p.yaw - l_p.yaw) / 0.01, is_clean);
+  if (!pose_transform_cached) {
+    pose_transform = Transform2D(pose);
+    pose_transform_cached = true;
+  }
+  if (!last_pose_transform_cached) {
+    last_pose_transform = Transform2D(last_pose);
+    last_pose_transform_cached = true;
+  }
+
+  // Apply offset to position of realsense device, or whatever
+  Transform2D offset_transform(offset);
+  TwoDPose p = (pose_transform * offset_transform).to_pose();
+  TwoDPose l_p = (last_pose_transform * offset_transform).to_pose();
+  velocityVector vel((p.x - l_p.x) / pose_dt, (p.y - l_p.y) / pose_dt,
+                     (p.yaw - l_p.yaw) / pose_dt, is_clean);
   thread_lock.unlock();
 
   return vel;
@@ -111,16 +118,28 @@ velocityVector WhoopDriveOdomOffset::get_velocity_vector(TwoDPose offset) {
 void WhoopDriveOdomOffset::__step() {
   thread_lock.lock();
   last_pose = pose;
+  last_pose_transform = pose_transform;
+  last_pose_transform_cached = pose_transform_cached;
+  pose_dt = step_dt;
   is_clean = true;
 
-  if (offset.x == offset.y == offset.yaw == 0) { // If offset is not applied
+  update_pose();
+  thread_lock.unlock();
+}
+
+void WhoopDriveOdomOffset::update_pose() {
+  // If offset is not applied
+  if (offset.x == 0 && offset.y == 0 && offset.yaw == 0) {
     pose =
         odom_unit
             ->pose; // Update pose without offset, to reduce computational time
+    pose_transform_cached = false; // Only worked out if it is needed
   } else {
-    pose = odom_unit->pose * -offset; // Update pose with offset
+    // Update pose with offset, keeping the rotation for get_velocity_vector
+    pose_transform = Transform2D(odom_unit->pose) * negative_offset;
+    pose_transform_cached = true;
+    pose = pose_transform.to_pose();
   }
-  thread_lock.unlock();
 }
 
 } // namespace whoop
@@ -8,6 +8,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "whooplib/include/devices/WhoopDriveOdomUnit.hpp"
+#include "whooplib/include/toolbox.hpp"
 #include "whooplib/includer.hpp"
 #include <cmath>
 #include <memory>
@@ -142,17 +143,20 @@ TwoDPose WhoopDriveOdomUnit::get_pose() {
   return result;
 }
 
-bool WhoopDriveOdomUnit::is_moving(double rads_s_threshold) {
-  double rad_s = 0;
+SensorSnapshot WhoopDriveOdomUnit::get_snapshot() {
+  thread_lock.lock();
+  SensorSnapshot result = snapshot;
+  thread_lock.unlock();
+  return result;
+}
 
-  if (left_motor_group != nullptr)
-    rad_s += std::abs(left_motor_group->get_velocity_rad_s());
-  if (right_motor_group != nullptr)
-    rad_s += std::abs(right_motor_group->get_velocity_rad_s());
-  if (forward_tracker != nullptr)
-    rad_s += std::abs(forward_tracker->get_velocity_rad_s());
-  if (sideways_tracker != nullptr)
-    rad_s += std::abs(sideways_tracker->get_velocity_rad_s());
+bool WhoopDriveOdomUnit::is_moving(double rads_s_threshold) {
+  thread_lock.lock();
+  double rad_s = std::abs(snapshot.left_velocity) +
+                 std::abs(snapshot.right_velocity) +
+                 std::abs(snapshot.forward_velocity) +
+                 std::abs(snapshot.sideways_velocity);
+  thread_lock.unlock();
 
   if (rad_s > rads_s_threshold) {
     return true;
@@ -160,20 +164,40 @@ bool WhoopDriveOdomUnit::is_moving(double rads_s_threshold) {
   return false;
 }
 
+void WhoopDriveOdomUnit::read_sensors() {
+  thread_lock.lock();
+  snapshot.time = now_seconds();
+  if (left_motor_group != nullptr)
+    left_motor_group->read(&snapshot.left_distance, &snapshot.left_velocity);
+  if (right_motor_group != nullptr)
+    right_motor_group->read(&snapshot.right_distance,
+                            &snapshot.right_velocity);
+  if (forward_tracker != nullptr) {
+    snapshot.forward_distance = forward_tracker->get_distance_meters();
+    snapshot.forward_velocity = forward_tracker->get_velocity_rad_s();
+  }
+  if (sideways_tracker != nullptr) {
+    snapshot.sideways_distance = sideways_tracker->get_distance_meters();
+    snapshot.sideways_velocity = sideways_tracker->get_velocity_rad_s();
+  }
+  snapshot.yaw = inertial_sensor->get_yaw_radians();
+  snapshot.roll = inertial_sensor->get_roll_radians();
+  snapshot.pitch = inertial_sensor->get_pitch_radians();
+  thread_lock.unlock();
+}
+
 void WhoopDriveOdomUnit::__step() {
+  read_sensors();
   thread_lock.lock();
   if (drive_odom_config == DriveOdomConfig::DRIVE_ONLY) {
-    update_pose(right_motor_group->get_distance_meters(), 0,
-                inertial_sensor->get_yaw_radians());
+    update_pose(snapshot.right_distance, 0, snapshot.yaw);
   } else if (drive_odom_config ==
              DriveOdomConfig::DRIVE_WITH_SIDEWAYS_TRACKER) {
-    update_pose(right_motor_group->get_distance_meters(),
-                sideways_tracker->get_distance_meters(),
-                inertial_sensor->get_yaw_radians());
+    update_pose(snapshot.right_distance, snapshot.sideways_distance,
+                snapshot.yaw);
   } else if (drive_odom_config == DriveOdomConfig::DRIVE_WITH_BOTH_TRACKERS) {
-    update_pose(forward_tracker->get_distance_meters(),
-                sideways_tracker->get_distance_meters(),
-                inertial_sensor->get_yaw_radians());
+    update_pose(snapshot.forward_distance, snapshot.sideways_distance,
+                snapshot.yaw);
   }
 
   pose.x = X_position;
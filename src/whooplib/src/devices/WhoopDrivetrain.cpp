@@ -8,9 +8,13 @@
 /*----------------------------------------------------------------------------*/
 
 #include "whooplib/include/devices/WhoopDrivetrain.hpp"
+#include "whooplib/include/calculators/PathFile.hpp"
+#include "whooplib/include/calculators/VoltageTable.hpp"
 #include "whooplib/include/devices/WhoopOdomFusion.hpp"
+#include "whooplib/include/devices/WhoopSD.hpp"
 #include "whooplib/include/toolbox.hpp"
 #include "whooplib/includer.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <memory> // For std::unique_ptr
@@ -19,6 +23,10 @@
 
 namespace whoop {
 
+// Seconds that a chained motion keeps the motors at speed for the next motion
+// to start, before stopping them
+static const double CHAIN_HOLD_TIME = 0.5;
+
 void WhoopDrivetrain::init_motor_groups(WhoopMotorGroup *leftGroup,
                                         WhoopMotorGroup *rightGroup) {
   left_motor_group = std::make_unique<WhoopMotorGroup>(*leftGroup);
@@ -133,6 +141,7 @@ void WhoopDrivetrain::turn_to(double yaw, double timeout_seconds) {
                                 // before generating path
 
   pursuit_conductor.generate_turn(target_pose, timeout_seconds);
+  apply_chain(true);
 
   auton_traveling = true;
 
@@ -366,6 +375,8 @@ void WhoopDrivetrain::drive_through_path(
 
   pursuit_conductor.generate_path(validated_waypoints, timeout_seconds,
                                   turning_radius, landing_strip);
+  apply_requested_path_follower();
+  apply_chain(false);
 
   auton_traveling = true;
 
@@ -379,6 +390,214 @@ void WhoopDrivetrain::drive_through_path(
   desired_position = target_pose;
 }
 
+bool WhoopDrivetrain::drive_through_path_file(std::string filename,
+                                              double timeout_seconds) {
+  this->wait_until_completed(); // Wait before loading path
+
+  std::vector<uint8_t> bytes;
+  if (!get_bytes_from_sd(filename, bytes) ||
+      !pursuit_conductor.load_path(bytes, timeout_seconds)) {
+    std::cout << "Could not load path " << filename << std::endl;
+    return false;
+  }
+  start_loaded_path();
+  return true;
+}
+
+void WhoopDrivetrain::start_loaded_path() {
+  request_reverse = false;
+  auton_reverse = false;
+  apply_requested_path_follower();
+  apply_chain(false);
+  auton_traveling = true;
+
+  last_desired_position = desired_position;
+  desired_position = pursuit_conductor.end_position;
+}
+
+bool WhoopDrivetrain::save_path_file(std::string filename) {
+  return write_bytes_to_sd(filename,
+                           serialize_path(pursuit_conductor.pursuit_path));
+}
+
+void WhoopDrivetrain::use_path_follower(pathfollower follower) {
+  requested_path_follower = follower;
+  request_path_follower = true;
+}
+
+PursuitResult WhoopDrivetrain::get_pursuit_result() { return pursuit_result; }
+
+void WhoopDrivetrain::set_battery_compensation(bool enabled) {
+  mixer.battery_compensation = enabled;
+}
+
+MixerStats WhoopDrivetrain::get_mixer_stats() { return mixer.get_stats(); }
+
+void WhoopDrivetrain::reset_mixer_stats() { mixer.reset_stats(); }
+
+void WhoopDrivetrain::spin_sides(double left_voltage, double right_voltage) {
+  last_left_voltage = left_voltage;
+  last_right_voltage = right_voltage;
+  MixedOutput output = mixer.mix(left_voltage, right_voltage);
+  left_motor_group->spin(output.left_voltage);
+  right_motor_group->spin(output.right_voltage);
+}
+
+void WhoopDrivetrain::stop_sides() {
+  last_left_voltage = 0;
+  last_right_voltage = 0;
+  chain_handoff = false;
+  left_motor_group->spin(0);
+  right_motor_group->spin(0);
+}
+
+/**
+ * Waits for the sides to spin for a number of seconds, averaging the velocity
+ * of each side over the last third
+ */
+static void measure_sides(WhoopMotorGroup *left, WhoopMotorGroup *right,
+                          double seconds, double *left_velocity,
+                          double *right_velocity) {
+  int settle_steps = seconds * 1000 * 2 / 3 / 10;
+  int measure_steps = std::max(1, static_cast<int>(seconds * 1000 / 3 / 10));
+#if USE_VEXCODE
+  wait(settle_steps * 10, msec);
+#else
+  pros::delay(settle_steps * 10);
+#endif
+  *left_velocity = 0;
+  *right_velocity = 0;
+  for (int i = 0; i < measure_steps; i++) {
+    *left_velocity += left->get_velocity_deg_s() / measure_steps;
+    *right_velocity += right->get_velocity_deg_s() / measure_steps;
+#if USE_VEXCODE
+    wait(10, msec);
+#else
+    pros::delay(10);
+#endif
+  }
+}
+
+bool WhoopDrivetrain::characterize_motors(std::string filename, int steps,
+                                          double step_time) {
+  this->wait_until_completed(); // Wait before taking over the sides
+  characterizing = true;
+
+  // The sweep is of the voltages as they are
+  VoltageTable unchanged;
+  left_motor_group->set_voltage_table(&unchanged);
+  right_motor_group->set_voltage_table(&unchanged);
+
+  // Turning in place keeps the robot where it is
+  std::vector<double> voltages, left_velocities, right_velocities;
+  for (int direction : {1, -1}) {
+    for (int i = 1; i <= steps; i++) {
+      double volts = direction * 12.0 * i / steps;
+      left_motor_group->spin(volts);
+      right_motor_group->spin(-volts);
+
+      double left_velocity, right_velocity;
+      measure_sides(left_motor_group.get(), right_motor_group.get(),
+                    step_time, &left_velocity, &right_velocity);
+      voltages.push_back(volts);
+      left_velocities.push_back(left_velocity);
+      right_velocities.push_back(-right_velocity);
+    }
+
+    // Come to rest before sweeping the other way
+    left_motor_group->spin(0);
+    right_motor_group->spin(0);
+#if USE_VEXCODE
+    wait(1000, msec);
+#else
+    pros::delay(1000);
+#endif
+  }
+
+  VoltageTable left_table, right_table;
+  bool characterized = left_table.build(voltages, left_velocities) &&
+                       right_table.build(voltages, right_velocities);
+  if (characterized) {
+    left_voltage_table = left_table;
+    right_voltage_table = right_table;
+    has_voltage_tables = true;
+  } else {
+    std::cout << "The motors did not move while characterizing" << std::endl;
+  }
+  apply_voltage_tables();
+  characterizing = false;
+
+  if (characterized && !filename.empty() &&
+      !write_bytes_to_sd(filename, serialize_voltage_tables(
+                                       {left_voltage_table,
+                                        right_voltage_table}))) {
+    std::cout << "Could not save " << filename << std::endl;
+    return false;
+  }
+  return characterized;
+}
+
+bool WhoopDrivetrain::load_motor_characterization(std::string filename) {
+  std::vector<uint8_t> bytes;
+  std::vector<VoltageTable> tables;
+  if (!get_bytes_from_sd(filename, bytes) ||
+      !deserialize_voltage_tables(bytes.data(), bytes.size(), tables) ||
+      tables.size() != 2) {
+    std::cout << "Could not load motor characterization " << filename
+              << std::endl;
+    return false;
+  }
+  left_voltage_table = tables[0];
+  right_voltage_table = tables[1];
+  has_voltage_tables = true;
+  apply_voltage_tables();
+  return true;
+}
+
+void WhoopDrivetrain::apply_voltage_tables() {
+  left_motor_group->set_voltage_table(
+      has_voltage_tables ? &left_voltage_table : nullptr);
+  right_motor_group->set_voltage_table(
+      has_voltage_tables ? &right_voltage_table : nullptr);
+}
+
+void WhoopDrivetrain::chain(double exit_error, double min_speed) {
+  requested_chain_exit_error = exit_error;
+  requested_chain_min_speed = min_speed;
+  request_chain = true;
+}
+
+void WhoopDrivetrain::apply_chain(bool is_turn) {
+  if (request_chain) {
+    request_chain = false;
+    double exit_error = requested_chain_exit_error;
+    double min_speed = requested_chain_min_speed;
+
+    // Converting to standardized meters or radians
+    if (is_turn && using_degrees()) {
+      exit_error = to_rad(exit_error); // (degrees -> radians)
+      min_speed = to_rad(min_speed);
+    } else if (!is_turn && using_inches()) {
+      exit_error = to_meters(exit_error); // (inches -> meters)
+      min_speed = to_meters(min_speed);
+    }
+    pursuit_conductor.chain(exit_error, min_speed);
+  }
+
+  // Continues from the motors of a chained motion, if it left them driving
+  if (chain_handoff) {
+    chain_handoff = false;
+    pursuit_conductor.hand_off(last_left_voltage, last_right_voltage);
+  }
+}
+
+void WhoopDrivetrain::apply_requested_path_follower() {
+  if (request_path_follower) {
+    request_path_follower = false;
+    pursuit_conductor.path_follower = requested_path_follower;
+  }
+}
+
 // This is the protocol for calibrating the drivetrain while in a disabled
 // state.
 void WhoopDrivetrain::run_disabled_calibration_protocol() {
@@ -513,38 +732,38 @@ void WhoopDrivetrain::fuse(double seconds) {
 }
 
 void WhoopDrivetrain::step_usercontrol() {
+  // The joysticks are percentages of 12 volts
+  double left = 0;
+  double right = 0;
   switch (whoop_controller->joystick_mode) {
   case joystickmode::joystickmode_tank:
-    left_motor_group->spin_percentage(whoop_controller->get_left_joystick_y());
-    right_motor_group->spin_percentage(
-        whoop_controller->get_right_joystick_y());
+    left = whoop_controller->get_left_joystick_y();
+    right = whoop_controller->get_right_joystick_y();
     break;
   case joystickmode::joystickmode_split_arcade:
-    left_motor_group->spin_percentage(whoop_controller->get_left_joystick_y() +
-                                      whoop_controller->get_right_joystick_x());
-    right_motor_group->spin_percentage(
-        whoop_controller->get_left_joystick_y() -
-        whoop_controller->get_right_joystick_x());
+    left = whoop_controller->get_left_joystick_y() +
+           whoop_controller->get_right_joystick_x();
+    right = whoop_controller->get_left_joystick_y() -
+            whoop_controller->get_right_joystick_x();
     break;
   case joystickmode::joystickmode_left_arcade:
-    left_motor_group->spin_percentage(whoop_controller->get_left_joystick_y() +
-                                      whoop_controller->get_left_joystick_x());
-    right_motor_group->spin_percentage(whoop_controller->get_left_joystick_y() -
-                                       whoop_controller->get_left_joystick_x());
+    left = whoop_controller->get_left_joystick_y() +
+           whoop_controller->get_left_joystick_x();
+    right = whoop_controller->get_left_joystick_y() -
+            whoop_controller->get_left_joystick_x();
     break;
   case joystickmode::joystickmode_right_arcade:
-    left_motor_group->spin_percentage(whoop_controller->get_right_joystick_y() +
-                                      whoop_controller->get_right_joystick_x());
-    right_motor_group->spin_percentage(
-        whoop_controller->get_right_joystick_y() -
-        whoop_controller->get_right_joystick_x());
+    left = whoop_controller->get_right_joystick_y() +
+           whoop_controller->get_right_joystick_x();
+    right = whoop_controller->get_right_joystick_y() -
+            whoop_controller->get_right_joystick_x();
     break;
   }
+  spin_sides(left * 0.12, right * 0.12);
 }
 
 void WhoopDrivetrain::step_disabled() {
-  left_motor_group->spin(0);
-  right_motor_group->spin(0);
+  stop_sides();
   run_disabled_calibration_protocol();
 }
 
@@ -556,61 +775,77 @@ void WhoopDrivetrain::step_autonomous() {
       robot_pose.yaw = normalize_angle(robot_pose.yaw + M_PI);
     }
 
-    pursuit_result = pursuit_conductor.step(robot_pose);
+    pursuit_result =
+        pursuit_conductor.step(robot_pose, auton_reverse, step_dt);
     if (temp_disable) {
-      left_motor_group->spin(0);
-      right_motor_group->spin(0);
+      stop_sides();
       return;
     }
 
     if (pursuit_result.is_completed) {
       auton_traveling = false;
-      left_motor_group->spin(0);
-      right_motor_group->spin(0);
+      if (pursuit_result.chained) {
+        chain_handoff = true;
+        chain_handoff_time = 0;
+        return;
+      }
+      stop_sides();
       return;
     }
 
     if (!pursuit_result.is_valid) {
-      left_motor_group->spin(0);
-      right_motor_group->spin(0);
+      stop_sides();
       auton_traveling = false;
       return;
     }
 
-    if (pursuit_conductor.forward_pid.is_settled() ||
-        pursuit_result.suggest_point_turn) {
-      if (auton_reverse) {
-        left_motor_group->spin(-pursuit_result.forward_power -
-                               pursuit_result.steering_power / 1.5);
-        right_motor_group->spin(-pursuit_result.forward_power +
-                                pursuit_result.steering_power / 1.5);
-      } else {
-        left_motor_group->spin(pursuit_result.forward_power -
-                               pursuit_result.steering_power / 1.5);
-        right_motor_group->spin(pursuit_result.forward_power +
-                                pursuit_result.steering_power / 1.5);
-      }
-    } else {
+    // A trajectory tracker drives each side directly. When the whole move is
+    // in reverse, its sides are those of the back of the robot
+    if (pursuit_result.has_side_powers) {
       if (auton_reverse) {
-        left_motor_group->spin(-pursuit_result.forward_power +
-                               std::max(-pursuit_result.steering_power, 0.0));
-        right_motor_group->spin(-pursuit_result.forward_power +
-                                std::max(pursuit_result.steering_power, 0.0));
+        spin_sides(-pursuit_result.right_power, -pursuit_result.left_power);
       } else {
-        left_motor_group->spin(pursuit_result.forward_power +
-                               std::min(-pursuit_result.steering_power, 0.0));
-        right_motor_group->spin(pursuit_result.forward_power +
-                                std::min(pursuit_result.steering_power, 0.0));
+        spin_sides(pursuit_result.left_power, pursuit_result.right_power);
       }
+      return;
     }
+
+    // Reverse if either the whole move is in reverse, or the path is at a leg
+    // that reverses (but not both)
+    bool reverse_drive = auton_reverse != (pursuit_result.direction < 0);
+
+    bool point_turn = pursuit_conductor.forward_pid.is_settled() ||
+                      pursuit_result.suggest_point_turn;
+    double left_power, right_power;
+    pursuit_side_powers(pursuit_result.forward_power,
+                        pursuit_result.steering_power, point_turn,
+                        reverse_drive, &left_power, &right_power);
+    spin_sides(left_power, right_power);
+  } else if (chain_handoff && chain_handoff_time < CHAIN_HOLD_TIME) {
+    // Keeps driving until the next motion takes over
+    chain_handoff_time += step_dt;
+    spin_sides(last_left_voltage, last_right_voltage);
   } else {
-    left_motor_group->spin(0);
-    right_motor_group->spin(0);
+    stop_sides();
   }
 }
 
 void WhoopDrivetrain::__step() {
-  odom_fusion->__step(); // Step odometry fusion module
+#if USE_VEXCODE
+  mixer.set_battery_voltage(Brain.Battery.voltage(voltageUnits::volt), step_dt);
+#else
+  mixer.set_battery_voltage(pros::battery::get_voltage() / 1000.0, step_dt);
+#endif
+  // Step odometry fusion module, unless it runs as its own node (at its own
+  // rate), in which case its latest pose is read as it is
+  if (!odom_fusion->node_running) {
+    odom_fusion->set_step_dt(step_dt);
+    odom_fusion->__step();
+  }
+
+  if (characterizing) { // characterize_motors drives the sides itself
+    return;
+  }
 
   switch (drive_state) {
   case drivetrainState::mode_usercontrol:
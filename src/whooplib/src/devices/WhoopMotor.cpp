@@ -44,14 +44,24 @@ WhoopMotor::WhoopMotor(std::int32_t port, cartridge motorCartridge,
 void WhoopMotor::spin(double volts) {
 // Linearizes the voltage. Visual representation of the linearization:
 // https://www.desmos.com/calculator/anyejul5wg It attempts to make the voltage
-// and motor power more linearly proportional
+// and motor power more linearly proportional. A characterized table does the
+// same from measurements, with a lookup instead of pow and sqrt
+  if (voltage_table != nullptr) {
+    volts = voltage_table->lookup(volts);
+  } else {
+    volts = linearize_voltage(volts);
+  }
 #if USE_VEXCODE
-  vex::motor::spin(fwd, linearize_voltage(volts), voltageUnits::volt);
+  vex::motor::spin(fwd, volts, voltageUnits::volt);
 #else
-  pros::Motor::move(linearize_voltage(volts) * VOLTAGE_TO_ANALOG_CONVERSION);
+  pros::Motor::move(volts * VOLTAGE_TO_ANALOG_CONVERSION);
 #endif
 }
 
+void WhoopMotor::set_voltage_table(const VoltageTable *table) {
+  voltage_table = table;
+}
+
 void WhoopMotor::spin_unit(double unit) { // Unit being -1 to 1, being 0 stopped
   spin(unit * 12.0);
 }
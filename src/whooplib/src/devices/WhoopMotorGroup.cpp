@@ -11,13 +11,41 @@
 #include "whooplib/include/devices/WhoopMotor.hpp"
 #include "whooplib/include/toolbox.hpp"
 #include "whooplib/includer.hpp"
-#include <algorithm> // Needed for std::max_element
 #include <cmath>
 #include <stdexcept>
 
 namespace whoop {
 
+/**
+ * Averages the readings of a group. If there are more than 2, the one
+ * furthest from the average is left out
+ * @param values The readings, of at least one motor
+ * @param count The number of readings
+ * @returns The average
+ */
+static double mean_without_outlier(const double *values, int count) {
+  double total = 0;
+  for (int i = 0; i < count; i++) {
+    total += values[i];
+  }
+  double avg = total / count;
+  if (count <= 2) {
+    return avg;
+  }
+
+  int outlier = 0;
+  for (int i = 1; i < count; i++) {
+    if (std::abs(values[i] - avg) > std::abs(values[outlier] - avg)) {
+      outlier = i;
+    }
+  }
+  return (total - values[outlier]) / (count - 1);
+}
+
 void WhoopMotorGroup::add_motor(WhoopMotor *motor) {
+  if (static_cast<int>(whoop_motors.size()) >= MAX_MOTORS) {
+    throw std::invalid_argument("A motor group holds at most 8 motors.");
+  }
   whoop_motors.push_back(motor);
 }
 
@@ -63,6 +91,12 @@ void WhoopMotorGroup::spin_unit(double unit) {
   apply_to_all(&WhoopMotor::spin_unit, unit);
 }
 
+void WhoopMotorGroup::set_voltage_table(const VoltageTable *table) {
+  for (auto &motor : whoop_motors) {
+    motor->set_voltage_table(table);
+  }
+}
+
 void WhoopMotorGroup::set_gear_ratio_mult(double ratio) {
   if (ratio <= 0) {
     throw std::invalid_argument("Gear ratio must be positive and non-zero.");
@@ -88,26 +122,12 @@ void WhoopMotorGroup::stop_coast() { apply_to_all(&WhoopMotor::stop_coast); }
 double WhoopMotorGroup::get_rotation() {
   if (whoop_motors.empty())
     return 0;
-  double total = 0;
-  std::vector<double> rotations;
+  double rotations[MAX_MOTORS];
+  int count = 0;
   for (auto &motor : whoop_motors) {
-    double rotation = motor->get_rotation();
-    rotations.push_back(rotation);
-    total += rotation;
+    rotations[count++] = motor->get_rotation();
   }
-  double avg = total / whoop_motors.size();
-
-  // If there are more than 2 motors, remove a single outlier
-  if (whoop_motors.size() > 2) {
-    auto max_it = std::max_element(
-        rotations.begin(), rotations.end(), [&avg](double a, double b) {
-          return std::abs(a - avg) < std::abs(b - avg);
-        });
-    total -= *max_it;
-    avg = total / (whoop_motors.size() - 1);
-  }
-
-  return avg * gear_ratio;
+  return mean_without_outlier(rotations, count) * gear_ratio;
 }
 
 double WhoopMotorGroup::get_rotation_degrees() { return get_rotation(); }
@@ -128,27 +148,12 @@ double WhoopMotorGroup::get_distance_meters() {
 double WhoopMotorGroup::get_velocity() {
   if (whoop_motors.empty())
     return 0; // Prevent divide by zero error
-  double total = 0;
-  std::vector<double> velocities;
+  double velocities[MAX_MOTORS];
+  int count = 0;
   for (auto &motor : whoop_motors) {
-    double velocity = motor->get_velocity();
-    velocities.push_back(velocity);
-    total += velocity;
-  }
-
-  double avg = total / whoop_motors.size();
-
-  // If there are more than 2 motors, remove a single outlier
-  if (whoop_motors.size() > 2) {
-    auto max_it = std::max_element(
-        velocities.begin(), velocities.end(), [&avg](double a, double b) {
-          return std::abs(a - avg) < std::abs(b - avg);
-        });
-    total -= *max_it;
-    avg = total / (whoop_motors.size() - 1);
+    velocities[count++] = motor->get_velocity();
   }
-
-  return avg * gear_ratio;
+  return mean_without_outlier(velocities, count) * gear_ratio;
 }
 double WhoopMotorGroup::get_velocity_deg_s() { return get_velocity(); }
 double WhoopMotorGroup::get_velocity_rad_s() { return to_rad(get_velocity()); }
@@ -160,6 +165,25 @@ double WhoopMotorGroup::get_velocity_meters_s() {
   return get_velocity_deg_s() * (wheel_circumference / 360);
 }
 
+void WhoopMotorGroup::read(double *distance_meters, double *velocity_rad_s) {
+  if (whoop_motors.empty()) {
+    *distance_meters = *velocity_rad_s = 0;
+    return;
+  }
+  double rotations[MAX_MOTORS];
+  double velocities[MAX_MOTORS];
+  int count = 0;
+  for (auto &motor : whoop_motors) {
+    rotations[count] = motor->get_rotation();
+    velocities[count] = motor->get_velocity();
+    count++;
+  }
+  double rotation = mean_without_outlier(rotations, count) * gear_ratio;
+  double velocity = mean_without_outlier(velocities, count) * gear_ratio;
+  *distance_meters = rotation / 360.0 * wheel_circumference;
+  *velocity_rad_s = to_rad(velocity);
+}
+
 void WhoopMotorGroup::tare() { apply_to_all(&WhoopMotor::tare, 0); }
 
 void WhoopMotorGroup::tare(double degrees) {
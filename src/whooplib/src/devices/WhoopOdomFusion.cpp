@@ -21,6 +21,7 @@ WhoopOdomFusion::WhoopOdomFusion(WhoopVision *whoop_vision,
                                  double max_fusion_shift_meters,
                                  double max_fusion_shift_radians) {
   this->odom_offset = odom_offset;
+  this->min_confidence_threshold = min_confidence_threshold;
   this->max_fusion_shift_meters = max_fusion_shift_meters / 55.6;
   this->max_fusion_shift_radians = max_fusion_shift_radians / 55.6;
   this->fusion_mode = fusion_mode;
@@ -31,6 +32,7 @@ WhoopOdomFusion::WhoopOdomFusion(WhoopVision *whoop_vision,
 
 WhoopOdomFusion::WhoopOdomFusion(WhoopDriveOdomOffset *odom_offset) {
   this->odom_offset = odom_offset;
+  this->min_confidence_threshold = 1;
   this->max_fusion_shift_meters = 0;
   this->max_fusion_shift_radians = 0;
   this->fusion_mode = fusionmode::wheel_odom_only;
@@ -42,7 +44,33 @@ void WhoopOdomFusion::on_vision_pose_received(Pose p) {
     return;
   }
 
-  if (p.confidence >= min_confidence_threshold) {
+  // The frame is of when it was captured, so find the steps of wheel
+  // odometry since then
+  double capture_time = whoop_vision->get_capture_time();
+  self_lock.lock();
+  int step = history.find(capture_time);
+  bool stale = step < 0 && history.size() > 0; // Before every step kept
+  if (!stale && step >= 0 && fusion_mode != fusionmode::fusion_ekf) {
+    TwoDPose now = history.replay(TwoDPose(p.x, p.y, p.yaw), step);
+    p.x = now.x;
+    p.y = now.y;
+    p.yaw = now.yaw;
+  }
+  self_lock.unlock();
+
+  if (stale) {
+    frame_rejected = true;
+  } else if (p.confidence >= min_confidence_threshold &&
+             fusion_mode == fusionmode::fusion_ekf) {
+    // Weighed against the wheel odometry, which keeps running untouched
+    self_lock.lock();
+    frame_rejected = !fuse_ekf(p, capture_time);
+    TwoDPose estimate = ekf.get_pose();
+    pose.x = estimate.x;
+    pose.y = estimate.y;
+    pose.yaw = estimate.yaw;
+    self_lock.unlock();
+  } else if (p.confidence >= min_confidence_threshold) {
     frame_rejected = false;
     // Normalize angle difference to handle angle wrapping correctly
     double yaw_difference = normalize_angle(p.yaw - pose.yaw);
@@ -87,6 +115,7 @@ void WhoopOdomFusion::on_vision_pose_received(Pose p) {
     pose.yaw = normalize_angle(pose.yaw);
 
     odom_offset->tare(pose.x, pose.y, pose.yaw);
+    last_odom_pose = TwoDPose(pose.x, pose.y, pose.yaw);
     self_lock.unlock();
   } else {
     frame_rejected = true;
@@ -97,6 +126,29 @@ void WhoopOdomFusion::on_vision_pose_received(Pose p) {
   self_lock.unlock();
 }
 
+bool WhoopOdomFusion::fuse_ekf(const Pose &p, double capture_time) {
+  int step = history.find(capture_time);
+  if (step < 0 || step == history.size() - 1) {
+    return ekf.update(p.x, p.y, p.yaw, p.confidence);
+  }
+
+  // Go back to when the frame was captured, and replay the steps since
+  PoseEKF::Estimate now = ekf.get_estimate();
+  ekf.set_estimate(history[step].estimate);
+  if (!ekf.update(p.x, p.y, p.yaw, p.confidence)) {
+    ekf.set_estimate(now);
+    return false;
+  }
+  history[step].estimate = ekf.get_estimate();
+  for (int i = step + 1; i < history.size(); i++) {
+    const OdomStep &replayed = history[i];
+    ekf.predict(replayed.dx, replayed.dy, replayed.dyaw, replayed.odom_yaw,
+                replayed.dt);
+    history[i].estimate = ekf.get_estimate();
+  }
+  return true;
+}
+
 void WhoopOdomFusion::tare(double x, double y, double z, double yaw) {
   self_lock.lock();
 
@@ -106,6 +158,7 @@ void WhoopOdomFusion::tare(double x, double y, double z, double yaw) {
 
   // Tare
   odom_offset->tare(x, y, yaw);
+  reset_history(TwoDPose(x, y, yaw));
   pose.x = x;
   pose.y = y;
   pose.z = z;
@@ -129,9 +182,16 @@ void WhoopOdomFusion::calibrate() {
   }
 
   odom_offset->tare();
+  reset_history(TwoDPose(0, 0, 0));
   self_lock.unlock();
 }
 
+void WhoopOdomFusion::reset_history(const TwoDPose &pose) {
+  ekf.reset(pose);
+  history.clear();
+  last_odom_pose = pose; // Where the wheel odometry was just tared to
+}
+
 Pose WhoopOdomFusion::get_pose() {
   self_lock.lock();
   Pose p = pose;
@@ -157,15 +217,37 @@ void WhoopOdomFusion::reject_fuses() { accepting_fuses = false; }
 void WhoopOdomFusion::__step() {
   self_lock.lock();
 
-  if (fusion_mode != fusionmode::vision_only) {
+  if (fusion_mode == fusionmode::vision_only) {
+    // The wheel odometry is not integrated, but its sensors are still read,
+    // for is_moving and the tilt
+    odom_offset->odom_unit->read_sensors();
+  } else {
+    odom_offset->set_step_dt(step_dt);
     odom_offset->__step_down(); // Step down wheel odometry ladder
     TwoDPose result = odom_offset->get_pose();
+
+    OdomStep step;
+    step.time = odom_offset->odom_unit->get_snapshot().time;
+    step.dt = step_dt;
+    step.dx = result.x - last_odom_pose.x;
+    step.dy = result.y - last_odom_pose.y;
+    step.dyaw = normalize_angle(result.yaw - last_odom_pose.yaw);
+    step.odom_yaw = last_odom_pose.yaw;
+    last_odom_pose = result;
+    if (fusion_mode == fusionmode::fusion_ekf) {
+      ekf.predict(step.dx, step.dy, step.dyaw, step.odom_yaw, step.dt);
+      step.estimate = ekf.get_estimate();
+      result = ekf.get_pose();
+    }
+    history.push(step);
+
     pose.x = result.x;
     pose.y = result.y;
     pose.yaw = result.yaw;
   }
-  pose.roll = odom_offset->odom_unit->inertial_sensor->get_roll_radians();
-  pose.pitch = odom_offset->odom_unit->inertial_sensor->get_pitch_radians();
+  SensorSnapshot sensors = odom_offset->odom_unit->get_snapshot();
+  pose.roll = sensors.roll;
+  pose.pitch = sensors.pitch;
   self_lock.unlock();
 }
 
@@ -27,6 +27,14 @@ std::string WhoopSD::get_string(){
     return get_string_from_sd(file_name);
 }
 
+bool WhoopSD::write_bytes(const std::vector<uint8_t> &bytes){
+    return write_bytes_to_sd(file_name, bytes);
+}
+
+bool WhoopSD::get_bytes(std::vector<uint8_t> &bytes){
+    return get_bytes_from_sd(file_name, bytes);
+}
+
 int tries = 0;
 
 bool write_string_to_sd(std::string filename, std::string text) {
@@ -85,4 +93,41 @@ std::string get_string_from_sd(std::string filename) {
   return "FAILURE";
 }
 
-} // namespace whoop
\ No newline at end of file
+bool write_bytes_to_sd(std::string filename,
+                       const std::vector<uint8_t> &bytes) {
+#if USE_PROS
+  filename = "/usd/" + filename;
+#endif
+  if (!sd_inserted()) {
+    return false;
+  }
+  std::ofstream outfs(filename, std::ios::binary | std::ios::trunc);
+  if (!outfs.is_open() || !outfs.good()) {
+    return false;
+  }
+  outfs.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+  return outfs.good();
+}
+
+bool get_bytes_from_sd(std::string filename, std::vector<uint8_t> &bytes) {
+#if USE_PROS
+  filename = "/usd/" + filename;
+#endif
+  if (!sd_inserted()) {
+    return false;
+  }
+  std::ifstream infs(filename, std::ios::binary | std::ios::ate);
+  if (!infs.is_open() || !infs.good()) {
+    return false;
+  }
+  std::streamsize size = infs.tellg();
+  if (size < 0) {
+    return false;
+  }
+  infs.seekg(0, std::ios::beg);
+  bytes.resize(static_cast<size_t>(size));
+  return static_cast<bool>(
+      infs.read(reinterpret_cast<char *>(bytes.data()), size));
+}
+
+} // namespace whoop
@@ -38,27 +38,28 @@ WhoopVision::WhoopVision(RobotVisionOffset *robotOffset,
 }
 
 void WhoopVision::_transform_pose(bool apply_delta) {
-  // Also consider robot transformation
-  TwoDPose transformed = tared_position.toObjectSpace(
-      this->raw_pose.x, this->raw_pose.y, this->raw_pose.yaw);
+  // Also consider robot transformation. The rotation of the tare is cached,
+  // so this is the only sin and cos of the frame
+  Transform2D transformed = tared_position.to_object_space(
+      Transform2D(this->raw_pose.x, this->raw_pose.y, this->raw_pose.yaw));
 
   // Ensure robot offset is correctly applied
   TwoDPose offset(-robot_offset->x, -robot_offset->y, 0);
 
   // Acquire relative delta change of robot relative to vision system if tare
   if (apply_delta) {
-    this->offset_change = transformed.toWorldSpace(-offset);
+    this->offset_change = transformed.to_world_space(-offset);
   }
 
   // Apply robot offset to transformation
-  transformed *= offset;
+  TwoDPose robot = transformed.to_world_space(offset);
 
   thread_lock.lock();
-  this->pose.x = transformed.x + tare_x + this->offset_change.x;
-  this->pose.y = transformed.y + tare_y + this->offset_change.y;
+  this->pose.x = robot.x + tare_x + this->offset_change.x;
+  this->pose.y = robot.y + tare_y + this->offset_change.y;
   this->pose.z = this->raw_pose.z - tared_z;
   this->pose.pitch = this->raw_pose.pitch - tared_pitch;
-  this->pose.yaw = transformed.yaw;
+  this->pose.yaw = robot.yaw;
   this->pose.roll = this->raw_pose.roll - tared_roll;
   this->pose.confidence = confidence;
   thread_lock.unlock();
@@ -80,8 +81,8 @@ void WhoopVision::tare(double x, double y, double z, double pitch, double yaw,
   tared_pitch = this->raw_pose.pitch - tare_pitch;
   tared_roll = this->raw_pose.roll - tare_roll;
 
-  this->tared_position = TwoDPose(this->raw_pose.x, this->raw_pose.y,
-                                  this->raw_pose.yaw - tare_yaw);
+  this->tared_position = Transform2D(this->raw_pose.x, this->raw_pose.y,
+                                     this->raw_pose.yaw - tare_yaw);
 
   thread_lock.unlock();
   this->_transform_pose(true);
@@ -108,8 +109,8 @@ void WhoopVision::tare(double x, double y, double yaw,
     tared_roll = this->raw_pose.roll - tare_roll;
   }
 
-  TwoDPose tared_p(this->raw_pose.x, this->raw_pose.y,
-                   this->raw_pose.yaw - tare_yaw);
+  Transform2D tared_p(this->raw_pose.x, this->raw_pose.y,
+                      this->raw_pose.yaw - tare_yaw);
   this->tared_position = tared_p;
 
   thread_lock.unlock();
@@ -136,6 +137,10 @@ void WhoopVision::_update_pose(std::string pose_data) {
         unscaled_confidence)) {
     return; // Reject malformed data
   }
+  double age_ms = 0; // Optional, from when the frame was captured
+  if (!(iss >> age_ms) || age_ms < 0) {
+    age_ms = 0;
+  }
 
 #if USE_VEXCODE
   last_vision_message_time = Brain.Timer.time(msec);
@@ -144,6 +149,7 @@ void WhoopVision::_update_pose(std::string pose_data) {
 #endif
 
   thread_lock.lock();
+  capture_time = now_seconds() - age_ms / 1000.0 - latency;
   confidence = unscaled_confidence / 3.0; // Scale from 0 to 1
   raw_pose.x = -negative_x;
   raw_pose.y = y;
@@ -154,11 +160,13 @@ void WhoopVision::_update_pose(std::string pose_data) {
   raw_pose.confidence = confidence;
   thread_lock.unlock();
 
+  // Transformed first, so that the callbacks get this frame
+  this->_transform_pose();
+
+  Pose transformed = get_pose();
   for (size_t i = 0; i < callback_functions.size(); ++i) {
-    callback_functions[i](pose);
+    callback_functions[i](transformed);
   }
-
-  this->_transform_pose();
 }
 
 bool WhoopVision::vision_running() {
@@ -169,6 +177,19 @@ bool WhoopVision::vision_running() {
 #endif
 }
 
+void WhoopVision::set_latency(double seconds) {
+  thread_lock.lock();
+  latency = seconds;
+  thread_lock.unlock();
+}
+
+double WhoopVision::get_capture_time() {
+  thread_lock.lock();
+  double time = capture_time;
+  thread_lock.unlock();
+  return time;
+}
+
 Pose WhoopVision::get_pose() {
   thread_lock.lock();
   Pose p = pose;
@@ -0,0 +1,187 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       HostVex.cpp                                               */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Stand-In for the VEXcode API When Building on a Computer  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifdef WHOOP_HOST_BUILD // Only part of host builds (see host/makefile)
+
+#include "whooplib/include/host/HostVex.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace vex {
+namespace host {
+
+/**
+ * A task of the scheduler. Each is a thread, but only the one that is running
+ * is ever awake
+ */
+struct Task {
+  double wake_time = 0;   // When it waits until, in seconds
+  unsigned long turn = 0; // Which of the tasks waiting until the same time
+                          // runs first (the one that started waiting first)
+  std::condition_variable wake;
+};
+
+/**
+ * Runs one task at a time, always the one that waits until the earliest time.
+ * The state is never destroyed, as tasks may still be waiting on it while the
+ * program exits
+ */
+struct Scheduler {
+  std::mutex lock;
+  std::list<Task *> tasks;
+  Task *running = nullptr;
+  unsigned long turns = 0;
+
+  HostDevices unplugged;
+  HostDevices *devices = &unplugged;
+  bool simulated = false;
+  double simulated_time = 0;
+  std::chrono::steady_clock::time_point start_time =
+      std::chrono::steady_clock::now();
+
+  double now() {
+    if (simulated) {
+      return simulated_time;
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_time)
+        .count();
+  }
+
+  /**
+   * @returns The task of the calling thread, which is running if it is the
+   * first to ask (i.e. main)
+   */
+  Task *current();
+
+  /**
+   * Runs the task that is next, moving the clock forward to when it wakes
+   */
+  void run_next(std::unique_lock<std::mutex> &guard) {
+    Task *next = nullptr;
+    for (Task *task : tasks) {
+      if (next == nullptr || task->wake_time < next->wake_time ||
+          (task->wake_time == next->wake_time && task->turn < next->turn)) {
+        next = task;
+      }
+    }
+    running = next;
+    if (next == nullptr) {
+      return;
+    }
+    if (simulated) {
+      if (next->wake_time > simulated_time) {
+        devices->advance_to(next->wake_time);
+        simulated_time = next->wake_time;
+      }
+    } else if (next->wake_time > now()) {
+      // Nothing else runs until then anyway
+      guard.unlock();
+      std::this_thread::sleep_for(
+          std::chrono::duration<double>(next->wake_time - now()));
+      guard.lock();
+    }
+    next->wake.notify_one();
+  }
+
+  /**
+   * Waits until it is the turn of task
+   */
+  void wait_for_turn(std::unique_lock<std::mutex> &guard, Task *task) {
+    task->wake.wait(guard, [&] { return running == task; });
+  }
+};
+
+// The task of each thread
+static thread_local Task *thread_task = nullptr;
+
+static Scheduler &scheduler() {
+  static Scheduler *instance = new Scheduler();
+  return *instance;
+}
+
+Task *Scheduler::current() {
+  if (thread_task == nullptr) {
+    thread_task = new Task();
+    thread_task->wake_time = now();
+    tasks.push_back(thread_task);
+    if (running == nullptr) {
+      running = thread_task;
+    }
+  }
+  return thread_task;
+}
+
+void attach(HostDevices *devices) {
+  Scheduler &s = scheduler();
+  std::lock_guard<std::mutex> guard(s.lock);
+  if (devices != nullptr) {
+    s.simulated_time = s.simulated ? s.simulated_time : 0;
+    s.simulated = true;
+    s.devices = devices;
+  } else {
+    s.simulated = false;
+    s.devices = &s.unplugged;
+  }
+  for (Task *task : s.tasks) {
+    task->wake_time = s.now();
+  }
+}
+
+HostDevices &devices() { return *scheduler().devices; }
+
+double time() {
+  Scheduler &s = scheduler();
+  std::lock_guard<std::mutex> guard(s.lock);
+  return s.now();
+}
+
+void sleep(double seconds) {
+  Scheduler &s = scheduler();
+  std::unique_lock<std::mutex> guard(s.lock);
+  Task *task = s.current();
+  task->wake_time = s.now() + (seconds > 0 ? seconds : 0);
+  task->turn = s.turns++;
+  s.run_next(guard);
+  s.wait_for_turn(guard, task);
+}
+
+void start_task(int (*callback)(void *), void *arg) {
+  Scheduler &s = scheduler();
+  std::lock_guard<std::mutex> guard(s.lock);
+  s.current(); // The caller keeps running
+
+  Task *task = new Task();
+  task->wake_time = s.now();
+  task->turn = s.turns++;
+  s.tasks.push_back(task);
+
+  std::thread([task, callback, arg] {
+    Scheduler &s = scheduler();
+    thread_task = task;
+    {
+      std::unique_lock<std::mutex> guard(s.lock);
+      s.wait_for_turn(guard, task);
+    }
+    callback(arg);
+
+    std::unique_lock<std::mutex> guard(s.lock);
+    s.tasks.remove(task);
+    s.run_next(guard);
+    delete task;
+  }).detach();
+}
+
+} // namespace host
+} // namespace vex
+
+#endif // WHOOP_HOST_BUILD
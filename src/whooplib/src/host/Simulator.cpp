@@ -0,0 +1,274 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       Simulator.cpp                                             */
+/*    Author:       Connor White                                              */
+/*    Created:      Sun Oct 18 2026                                           */
+/*    Description:  Simulated Differential Drivetrain for Host Builds         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#ifdef WHOOP_HOST_BUILD // Only part of host builds (see host/makefile)
+
+#include "whooplib/include/host/Simulator.hpp"
+#include "whooplib/include/toolbox.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace whoop {
+
+static const double GRAVITY = 9.81; // m/s^2
+
+// Speeds under which friction fades out, so that it holds the robot still
+// instead of flipping direction every step
+static const double STILL_SHAFT_SPEED = 0.1; // rad/s
+static const double STILL_SPEED = 0.01;      // m/s
+static const double STILL_TURN_RATE = 0.05;  // rad/s
+
+SimMotor::SimMotor(cartridge motor_cartridge) {
+  double rpm = 600;
+  stall_torque = 0.35;
+  if (motor_cartridge == cartridge::red) {
+    rpm = 100;
+    stall_torque = 2.1;
+  } else if (motor_cartridge == cartridge::green) {
+    rpm = 200;
+    stall_torque = 1.05;
+  }
+  free_speed = rpm * 2 * M_PI / 60;
+}
+
+double SimMotor::torque(double volts, double speed) const {
+  return stall_torque * (volts / 12.0 - speed / free_speed) -
+         friction_torque * std::tanh(speed / STILL_SHAFT_SPEED);
+}
+
+Simulator::Simulator(const SimChassis &chassis, unsigned int seed)
+    : chassis(chassis), random(seed) {}
+
+Simulator::~Simulator() {
+  if (attached) {
+    vex::host::attach(nullptr);
+  }
+}
+
+bool Simulator::valid_port(int port) { return port >= 0 && port < PORTS; }
+
+void Simulator::add_drive_motor(int port, driveside side, reversed reversed,
+                                const SimMotor &motor) {
+  if (!valid_port(port)) {
+    return;
+  }
+  DriveMotor &drive_motor = motors[port];
+  drive_motor = DriveMotor();
+  drive_motor.connected = true;
+  drive_motor.side = side;
+  drive_motor.direction = reversed ? -1 : 1;
+  drive_motor.model = motor;
+}
+
+void Simulator::add_tracking_wheel(int port, const SimTrackingWheel &wheel) {
+  if (!valid_port(port)) {
+    return;
+  }
+  wheels[port] = TrackingWheel();
+  wheels[port].connected = true;
+  wheels[port].wheel = wheel;
+}
+
+void Simulator::add_inertial(int port, const SimInertial &inertial) {
+  if (!valid_port(port)) {
+    return;
+  }
+  inertials[port] = Inertial();
+  inertials[port].connected = true;
+  inertials[port].model = inertial;
+  inertials[port].zero_yaw = turned;
+  inertials[port].calibrated_time = time;
+}
+
+void Simulator::attach() {
+  attached = true;
+  vex::host::attach(this);
+}
+
+void Simulator::set_pose(const TwoDPose &pose) {
+  turned += normalize_angle(pose.yaw - this->pose.yaw);
+  this->pose = pose;
+  velocity = 0;
+  lateral_velocity = 0;
+  angular_velocity = 0;
+}
+
+TwoDPose Simulator::get_pose() const { return pose; }
+
+double Simulator::get_velocity() const { return velocity; }
+
+double Simulator::get_angular_velocity() const { return angular_velocity; }
+
+double Simulator::get_time() const { return time; }
+
+void Simulator::advance_to(double time) {
+  while ((steps + 1) * step_time <= time + 1e-9) {
+    step(step_time);
+    steps++;
+    this->time = steps * step_time;
+  }
+}
+
+void Simulator::step(double dt) {
+  double radius = chassis.wheel_diameter / 2;
+  double half_track = chassis.track_width / 2;
+  // A motor runs at the fraction of the battery commanded, 12 volts being all
+  // of it
+  double supply = battery / 12.0;
+
+  // The force of each side on the ground, from the torque of its motors
+  double side_speeds[2] = {velocity - angular_velocity * half_track,
+                           velocity + angular_velocity * half_track};
+  double side_forces[2] = {0, 0};
+  for (DriveMotor &motor : motors) {
+    if (!motor.connected) {
+      continue;
+    }
+    double shaft_speed =
+        motor.direction * side_speeds[motor.side] / radius / chassis.gear_ratio;
+    double torque;
+    if (!motor.stopped) {
+      torque = motor.model.torque(clamp(motor.volts, -12.0, 12.0) * supply,
+                                  shaft_speed);
+    } else if (motor.stop_mode == vex::brakeType::hold) {
+      double volts = motor.model.hold_voltage_per_rad *
+                     (motor.hold_position - motor.position);
+      torque = motor.model.torque(clamp(volts, -12.0, 12.0) * supply,
+                                  shaft_speed);
+    } else if (motor.stop_mode == vex::brakeType::brake) {
+      // Shorted, so the back-EMF brakes
+      torque = motor.model.torque(0, shaft_speed);
+    } else { // Coasting, so only friction
+      torque = -motor.model.friction_torque *
+               std::tanh(shaft_speed / STILL_SHAFT_SPEED);
+    }
+    side_forces[motor.side] +=
+        motor.direction * torque / chassis.gear_ratio / radius;
+  }
+
+  // The wheels resist turning, as they scrub sideways, and sliding sideways,
+  // up to their grip. The lateral velocity is in the frame of the robot, so
+  // turning swings the forward velocity into it
+  double force = side_forces[0] + side_forces[1] -
+                 chassis.rolling_resistance * std::tanh(velocity / STILL_SPEED);
+  double torque =
+      (side_forces[1] - side_forces[0]) * half_track -
+      chassis.scrub_torque * std::tanh(angular_velocity / STILL_TURN_RATE);
+
+  double next_velocity =
+      velocity + (force / chassis.mass + angular_velocity * lateral_velocity) *
+                     dt;
+  lateral_velocity -= angular_velocity * velocity * dt;
+  double grip = chassis.lateral_grip * GRAVITY * dt;
+  lateral_velocity -= clamp(lateral_velocity, -grip, grip);
+  velocity = next_velocity;
+  angular_velocity += torque / chassis.moment_of_inertia * dt;
+
+  double yaw = pose.yaw + angular_velocity * dt / 2;
+  pose.x += (velocity * std::cos(yaw) - lateral_velocity * std::sin(yaw)) * dt;
+  pose.y += (velocity * std::sin(yaw) + lateral_velocity * std::cos(yaw)) * dt;
+  pose.yaw = normalize_angle(pose.yaw + angular_velocity * dt);
+  turned += angular_velocity * dt;
+
+  // The devices follow the chassis
+  side_speeds[0] = velocity - angular_velocity * half_track;
+  side_speeds[1] = velocity + angular_velocity * half_track;
+  for (DriveMotor &motor : motors) {
+    if (motor.connected) {
+      motor.speed = motor.direction * side_speeds[motor.side] / radius /
+                    chassis.gear_ratio;
+      motor.position += motor.speed * dt;
+    }
+  }
+  for (TrackingWheel &wheel : wheels) {
+    if (!wheel.connected) {
+      continue;
+    }
+    // The velocity of the point the wheel touches, forward and to the left
+    double forward = velocity + angular_velocity * wheel.wheel.right_offset;
+    double left =
+        lateral_velocity + angular_velocity * wheel.wheel.forward_offset;
+    double speed = wheel.wheel.sideways ? left : forward;
+    wheel.speed = speed / (M_PI * wheel.wheel.diameter) * 360;
+    wheel.position += wheel.speed * dt;
+  }
+}
+
+void Simulator::motor_spin(int port, double volts) {
+  if (valid_port(port)) {
+    motors[port].volts = volts;
+    motors[port].stopped = false;
+  }
+}
+
+void Simulator::motor_stop(int port, vex::brakeType mode) {
+  if (valid_port(port)) {
+    motors[port].stopped = true;
+    motors[port].stop_mode = mode;
+    motors[port].hold_position = motors[port].position;
+  }
+}
+
+double Simulator::motor_position(int port) {
+  return valid_port(port) ? to_deg(motors[port].position) : 0;
+}
+
+double Simulator::motor_velocity(int port) {
+  return valid_port(port) ? to_deg(motors[port].speed) : 0;
+}
+
+double Simulator::rotation_position(int port) {
+  if (!valid_port(port) || !wheels[port].connected) {
+    return 0;
+  }
+  const SimTrackingWheel &wheel = wheels[port].wheel;
+  double degrees = wheels[port].position;
+  if (wheel.resolution > 0) {
+    degrees = std::round(degrees / wheel.resolution) * wheel.resolution;
+  }
+  return degrees + wheel.noise * gaussian(random);
+}
+
+double Simulator::rotation_velocity(int port) {
+  return valid_port(port) ? wheels[port].speed : 0;
+}
+
+double Simulator::inertial_heading(int port) {
+  if (!valid_port(port) || !inertials[port].connected ||
+      inertial_calibrating(port)) {
+    return 0;
+  }
+  const Inertial &inertial = inertials[port];
+  // The heading is clockwise
+  double degrees = -to_deg(turned - inertial.zero_yaw) * inertial.model.scale +
+                   inertial.model.drift * (time - inertial.calibrated_time) +
+                   inertial.model.noise * gaussian(random);
+  degrees = std::fmod(degrees, 360.0);
+  return degrees < 0 ? degrees + 360 : degrees;
+}
+
+void Simulator::inertial_calibrate(int port) {
+  if (!valid_port(port) || !inertials[port].connected) {
+    return;
+  }
+  Inertial &inertial = inertials[port];
+  inertial.calibrating_until = time + inertial.model.calibration_time;
+  inertial.calibrated_time = inertial.calibrating_until;
+  inertial.zero_yaw = turned;
+}
+
+bool Simulator::inertial_calibrating(int port) {
+  return valid_port(port) && time < inertials[port].calibrating_until;
+}
+
+double Simulator::battery_voltage() { return battery; }
+
+} // namespace whoop
+
+#endif // WHOOP_HOST_BUILD
@@ -60,6 +60,7 @@ int ComputeNode::task_runner(void *param) {
   auto *node = static_cast<ComputeNode *>(param);
 
   int start_time = 0;
+  double previous_step_ms = -1;
   if (node->omit_steptime_compensation) {
     node->initial_computational_time = 0;
   } else {
@@ -67,6 +68,20 @@ int ComputeNode::task_runner(void *param) {
   }
 
   while (node->node_running) {
+    // The time since the previous step, which is longer than step_time_ms
+    // when a step overruns. A long stall is capped, so that it does not kick
+    // the controllers
+    double now_ms = now_seconds() * 1000.0;
+    double nominal_ms = node->step_time_ms > 0 ? node->step_time_ms : 1;
+    double measured_ms = now_ms - previous_step_ms;
+    if (previous_step_ms < 0 || measured_ms <= 0) { // The first step
+      measured_ms = nominal_ms;
+    } else if (measured_ms > 5 * nominal_ms) {
+      measured_ms = 5 * nominal_ms;
+    }
+    node->step_dt = measured_ms / 1000.0;
+    previous_step_ms = now_ms;
+
     if (node->node_debug) // If in debug mode, simply step knowing the
                           // consequence of an error breaking the thread
     {
@@ -175,6 +190,12 @@ void ComputeNode::set_step_time(
   this->omit_steptime_compensation = omit_steptime_compensation;
 }
 
+void ComputeNode::set_step_dt(double dt) {
+  if (dt > 0) {
+    step_dt = dt;
+  }
+}
+
 void ComputeNode::__step() {
   if (lock_ptr) {
     lock_ptr->lock(); // Acquire the mutex
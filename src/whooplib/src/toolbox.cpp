@@ -8,6 +8,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "whooplib/include/toolbox.hpp"
+#include "whooplib/includer.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstdarg> // Needed for va_list and related operations
@@ -205,6 +206,14 @@ bool intToBool(int value) { return value != 0; }
 
 int boolToInt(bool value) { return value ? 1 : 0; }
 
+double now_seconds() {
+#if USE_VEXCODE
+  return Brain.Timer.systemHighResolution() / 1000000.0;
+#else
+  return pros::c::micros() / 1000000.0;
+#endif
+}
+
 double to_rad(double deg) { return deg * (M_PI / 180.0); }
 
 double to_deg(double radians) { return radians * (180.0 / M_PI); }